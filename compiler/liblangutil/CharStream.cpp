@@ -121,7 +121,7 @@ string_view CharStream::text(SourceLocation const& _location) const
 {
 	if (!_location.hasText())
 		return {};
-	solAssert(_location.sourceName && *_location.sourceName == m_name, "");
+	solAssert(_location.sourceName() && *_location.sourceName() == m_name, "");
 	solAssert(static_cast<size_t>(_location.end) <= m_source.size(), "");
 	return string_view{m_source}.substr(
 		static_cast<size_t>(_location.start),
@@ -21,12 +21,90 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace std;
 
+namespace
+{
+
+/// Names are stored in chunks that are never moved, so readers don't take the lock:
+/// a name is written before its id is published through `size`.
+struct SourceNameTable
+{
+	static size_t constexpr ChunkSize = 1024;
+	static size_t constexpr MaxChunks = 1024;
+
+	mutex lock; // taken by writers only
+	array<atomic<string*>, MaxChunks> chunks{};
+	atomic<size_t> size{0};
+	map<string, int, less<>> ids;
+	size_t scopes = 0;
+
+	void clear()
+	{
+		for (atomic<string*>& chunk: chunks)
+			delete[] chunk.exchange(nullptr, memory_order_relaxed);
+		size.store(0, memory_order_release);
+		ids.clear();
+	}
+};
+
+SourceNameTable& sourceNameTable()
+{
+	static SourceNameTable table;
+	return table;
+}
+
+}
+
+SourceNameScope::SourceNameScope()
+{
+	SourceNameTable& table = sourceNameTable();
+	lock_guard<mutex> guard(table.lock);
+	++table.scopes;
+}
+
+SourceNameScope::~SourceNameScope()
+{
+	SourceNameTable& table = sourceNameTable();
+	lock_guard<mutex> guard(table.lock);
+	if (--table.scopes == 0)
+		table.clear();
+}
+
+int SourceLocation::sourceIdOf(string const& _sourceName)
+{
+	SourceNameTable& table = sourceNameTable();
+	lock_guard<mutex> guard(table.lock);
+	auto it = table.ids.find(_sourceName);
+	if (it != table.ids.end())
+		return it->second;
+	size_t id = table.size.load(memory_order_relaxed);
+	solAssert(id < SourceNameTable::ChunkSize * SourceNameTable::MaxChunks, "Too many source names.");
+	atomic<string*>& chunk = table.chunks[id / SourceNameTable::ChunkSize];
+	if (!chunk.load(memory_order_relaxed))
+		chunk.store(new string[SourceNameTable::ChunkSize], memory_order_release);
+	chunk.load(memory_order_relaxed)[id % SourceNameTable::ChunkSize] = _sourceName;
+	table.ids.emplace(_sourceName, static_cast<int>(id));
+	table.size.store(id + 1, memory_order_release);
+	return static_cast<int>(id);
+}
+
+string const* SourceLocation::sourceNameOf(int _sourceId)
+{
+	SourceNameTable& table = sourceNameTable();
+	size_t id = static_cast<size_t>(_sourceId);
+	solAssert(0 <= _sourceId && id < table.size.load(memory_order_acquire), "");
+	return &table.chunks[id / SourceNameTable::ChunkSize].load(memory_order_acquire)[id % SourceNameTable::ChunkSize];
+}
+
 SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<shared_ptr<string const>> const& _sourceNames)
 {
 	// Expected input: "start:length:sourceindex"
@@ -47,9 +125,9 @@ SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vec
 	int start = stoi(pos[Start]);
 	int end = start + stoi(pos[Length]);
 
-	SourceLocation result{start, end, {}};
+	SourceLocation result{start, end};
 	if (sourceIndex != -1)
-		result.sourceName = _sourceNames.at(static_cast<size_t>(sourceIndex));
+		result.setSourceName(_sourceNames.at(static_cast<size_t>(sourceIndex)));
 	return result;
 }
 
@@ -58,8 +136,8 @@ std::ostream& solidity::langutil::operator<<(std::ostream& _out, SourceLocation
 	if (!_location.isValid())
 		return _out << "NO_LOCATION_SPECIFIED";
 
-	if (_location.sourceName)
-		_out << *_location.sourceName;
+	if (_location.sourceName())
+		_out << *_location.sourceName();
 
 	_out << "[" << _location.start << "," << _location.end << "]";
 
@@ -35,9 +35,18 @@ namespace solidity::langutil
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
+ * The source is referenced by its index in a process-wide table of source names,
+ * so copying and comparing locations doesn't touch the names.
+ * Reading a name doesn't lock the table, only registering a new one does.
  */
 struct SourceLocation
 {
+	SourceLocation() = default;
+	SourceLocation(int _start, int _end, int _sourceId = -1):
+		start(_start), end(_end), sourceId(_sourceId) {}
+	SourceLocation(int _start, int _end, std::shared_ptr<std::string const> const& _sourceName):
+		start(_start), end(_end), sourceId(_sourceName ? sourceIdOf(*_sourceName) : -1) {}
+
 	bool operator==(SourceLocation const& _other) const
 	{
 		return start == _other.start && end == _other.end && equalSources(_other);
@@ -46,10 +55,12 @@ struct SourceLocation
 
 	bool operator<(SourceLocation const& _other) const
 	{
-		if (!sourceName || !_other.sourceName)
-			return std::make_tuple(int(!!sourceName), start, end) < std::make_tuple(int(!!_other.sourceName), _other.start, _other.end);
-		else
-			return std::make_tuple(*sourceName, start, end) < std::make_tuple(*_other.sourceName, _other.start, _other.end);
+		if (sourceId == _other.sourceId)
+			return std::make_tuple(start, end) < std::make_tuple(_other.start, _other.end);
+		if (sourceId < 0 || _other.sourceId < 0)
+			return std::make_tuple(int(sourceId >= 0), start, end) < std::make_tuple(int(_other.sourceId >= 0), _other.start, _other.end);
+		// keep ordering by name, ids only reflect the order the sources were seen in
+		return std::make_tuple(*sourceName(), start, end) < std::make_tuple(*_other.sourceName(), _other.start, _other.end);
 	}
 
 	bool contains(SourceLocation const& _other) const
@@ -73,18 +84,22 @@ struct SourceLocation
 		return _other.start < end && start < _other.end;
 	}
 
-	bool equalSources(SourceLocation const& _other) const
+	bool equalSources(SourceLocation const& _other) const { return sourceId == _other.sourceId; }
+
+	bool isValid() const { return sourceId >= 0 || start != -1 || end != -1; }
+
+	bool hasText() const { return sourceId >= 0 && 0 <= start && start <= end; }
+
+	/// @returns the name of the source or nullptr if the source is not set.
+	std::string const* sourceName() const { return sourceId >= 0 ? sourceNameOf(sourceId) : nullptr; }
+	void setSourceName(std::shared_ptr<std::string const> const& _sourceName)
 	{
-		if (!!sourceName != !!_other.sourceName)
-			return false;
-		if (sourceName && *sourceName != *_other.sourceName)
-			return false;
-		return true;
+		sourceId = _sourceName ? sourceIdOf(*_sourceName) : -1;
 	}
 
-	bool isValid() const { return sourceName || start != -1 || end != -1; }
-
-	bool hasText() const { return sourceName && 0 <= start && start <= end; }
+	/// @returns the id of the source name in the table, registers the name if it is not there yet.
+	static int sourceIdOf(std::string const& _sourceName);
+	static std::string const* sourceNameOf(int _sourceId);
 
 	/// @returns the smallest SourceLocation that contains both @param _a and @param _b.
 	/// Assumes that @param _a and @param _b refer to the same source (exception: if the source of either one
@@ -93,8 +108,8 @@ struct SourceLocation
 	/// @param _b, then start resp. end of the result will be -1 as well).
 	static SourceLocation smallestCovering(SourceLocation _a, SourceLocation const& _b)
 	{
-		if (!_a.sourceName)
-			_a.sourceName = _b.sourceName;
+		if (_a.sourceId < 0)
+			_a.sourceId = _b.sourceId;
 
 		if (_a.start < 0)
 			_a.start = _b.start;
@@ -108,7 +123,21 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<std::string const> sourceName;
+	int sourceId = -1;
+};
+
+/**
+ * Keeps the names registered by SourceLocation alive. The table of source names is emptied
+ * when the last scope is destroyed, so source ids must not be used after that.
+ * Names registered outside of any scope are released with the others when the last scope ends.
+ */
+class SourceNameScope
+{
+public:
+	SourceNameScope();
+	~SourceNameScope();
+	SourceNameScope(SourceNameScope const&) = delete;
+	SourceNameScope& operator=(SourceNameScope const&) = delete;
 };
 
 SourceLocation parseSourceLocation(
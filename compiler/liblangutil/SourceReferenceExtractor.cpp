@@ -64,13 +64,13 @@ SourceReference SourceReferenceExtractor::extract(
 	std::string message
 )
 {
-	if (!_location || !_location->sourceName) // Nothing we can extract here
+	if (!_location || !_location->sourceName()) // Nothing we can extract here
 		return SourceReference::MessageOnly(std::move(message));
 
 	if (!_location->hasText()) // No source text, so we can only extract the source name
-		return SourceReference::MessageOnly(std::move(message), *_location->sourceName);
+		return SourceReference::MessageOnly(std::move(message), *_location->sourceName());
 
-	CharStream const& charStream = _charStreamProvider.charStream(*_location->sourceName);
+	CharStream const& charStream = _charStreamProvider.charStream(*_location->sourceName());
 
 	LineColumn const interest = charStream.translatePositionToLineColumn(_location->start);
 	LineColumn start = interest;
@@ -114,7 +114,7 @@ SourceReference SourceReferenceExtractor::extract(
 
 	return SourceReference{
 		std::move(message),
-		*_location->sourceName,
+		*_location->sourceName(),
 		interest,
 		isMultiline,
 		line,
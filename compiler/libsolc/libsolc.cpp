@@ -28,6 +28,7 @@
 
 #include <cstdlib>
 #include <list>
+#include <mutex>
 #include <string>
 
 #include "license.h"
@@ -46,6 +47,15 @@ namespace
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+// Compilations may run in parallel threads, the list is shared by them.
+static mutex solidityAllocationsMutex;
+
+/// Adds @p _data to the list of allocations and returns the pointer passed to the caller.
+char* addAllocation(string _data)
+{
+	lock_guard<mutex> guard(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(std::move(_data)).data();
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -54,6 +64,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard<mutex> guard(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -130,14 +141,14 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return addAllocation(compile(_input, _readCallback, _readContext));
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return addAllocation(string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -153,8 +164,9 @@ extern void solidity_free(char* _data) noexcept
 
 extern void solidity_reset() noexcept
 {
-	// This is called right before each compilation, but not at the end, so additional memory
-	// can be freed here.
+	// Frees the allocations of all threads, so it must not run while another compilation
+	// is in progress or its results are still in use.
+	lock_guard<mutex> guard(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
 
@@ -206,7 +218,7 @@ extern char* file_reader_source_unit_name(void *p, const char* path) noexcept
 #ifdef FILE_READER_DEBUG
 	cout << "file_reader_source_unit_name " << path << " " << name << endl;
 #endif
-	return solidityAllocations.emplace_back(name).data();
+	return addAllocation(std::move(name));
 }
 extern char* file_reader_read(void *p, const char* name, int* success) noexcept
 {
@@ -214,19 +226,27 @@ extern char* file_reader_read(void *p, const char* name, int* success) noexcept
 	cout << "file_reader_read " << name << endl;
 #endif
 	FileReader *fileReader = (FileReader *)p;
-	auto map = fileReader->sourceUnits();
-	if (map.count(name)) {
+	FileReader::StringMap const& map = fileReader->sourceUnits();
+	if (auto it = map.find(name); it != map.end()) {
 #ifdef FILE_READER_DEBUG
 		cout << "cached" << endl;
 #endif
 		*success = true;
-		return solidityAllocations.emplace_back(map[name]).data();
+		return addAllocation(it->second);
 	}
 	ReadCallback::Result res = fileReader->readFile("source", name);
 	*success = res.success;
 #ifdef FILE_READER_DEBUG
 	cout << "success " << res.success << endl;
 #endif
-	return solidityAllocations.emplace_back(res.responseOrErrorMessage).data();
+	return addAllocation(std::move(res.responseOrErrorMessage));
+}
+extern void file_reader_clear_cache(void *p) noexcept
+{
+#ifdef FILE_READER_DEBUG
+	cout << "file_reader_clear_cache" << endl;
+#endif
+	FileReader *fileReader = (FileReader *)p;
+	fileReader->clearFileSystemCache();
 }
 }
@@ -88,12 +88,16 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
 ///
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+///
+/// Several calls may run in parallel in different threads. A file reader passed as @p _readContext
+/// must not be shared by calls running at the same time.
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
-/// is invalid after calling this!
+/// is invalid after calling this! It frees the memory of all threads, so don't call it while
+/// solidity_compile() runs in another thread or other threads use results of the compiler.
 void solidity_reset() SOLC_NOEXCEPT;
 
 void* file_reader_new() SOLC_NOEXCEPT;
@@ -103,6 +107,9 @@ void file_reader_allow_directory(void *fr, const char* path) SOLC_NOEXCEPT;
 void file_reader_add_or_update_file(void *fr, const char* path, const char* content) SOLC_NOEXCEPT;
 char* file_reader_source_unit_name(void*fr, const char* path) SOLC_NOEXCEPT;
 char* file_reader_read(void *fr, const char* name, int* success) SOLC_NOEXCEPT;
+/// Forgets which files and directories exist. file_reader_add_or_update_file() does it as well.
+/// Call it before solidity_compile() if the reader is reused without adding a file.
+void file_reader_clear_cache(void *fr) SOLC_NOEXCEPT;
 
 #ifdef __cplusplus
 }
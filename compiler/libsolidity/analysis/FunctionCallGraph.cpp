@@ -93,6 +93,13 @@ CallGraph FunctionCallGraphBuilder::buildDeployedGraph(
 	if (_contract.receiveFunction())
 		builder.functionReferenced(*_contract.receiveFunction());
 
+	// TVM code generator emits every implemented function of the hierarchy (onBounce, onTickTock,
+	// onCodeUpgrade, private functions callable by id, etc.), so all of them are entry points.
+	for (ContractDefinition const* base: _contract.annotation().linearizedBaseContracts)
+		for (FunctionDefinition const* function: base->definedFunctions())
+			if (!function->isConstructor() && function->isImplemented())
+				builder.functionReferenced(*function);
+
 	// All functions present in internal dispatch at creation time could potentially be pointers
 	// assigned to state variables and as such may be reachable after deployment as well.
 	builder.m_currentNode = CallGraph::SpecialNode::InternalDispatch;
@@ -181,7 +188,12 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 
 	auto functionType = dynamic_cast<FunctionType const*>(_memberAccess.annotation().type);
 	auto functionDef = dynamic_cast<FunctionDefinition const*>(_memberAccess.annotation().referencedDeclaration);
-	if (!functionType || !functionDef || functionType->kind() != FunctionType::Kind::Internal)
+	if (!functionType || !functionDef)
+		return true;
+	// In TVM library functions are always called internally, whatever their visibility is
+	ContractDefinition const* functionContract = functionDef->annotation().contract;
+	bool const isLibraryCall = functionContract && functionContract->isLibrary();
+	if (functionType->kind() != FunctionType::Kind::Internal && !isLibraryCall)
 		return true;
 
 	// Super functions
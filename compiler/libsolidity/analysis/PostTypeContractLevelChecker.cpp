@@ -34,7 +34,7 @@ using namespace solidity::frontend;
 bool PostTypeContractLevelChecker::check(SourceUnit const& _sourceUnit)
 {
 	bool noErrors = true;
-	for (auto* contract: ASTNode::filteredNodes<ContractDefinition>(_sourceUnit.nodes()))
+	for (auto* contract: _sourceUnit.contracts())
 		if (!check(*contract))
 			noErrors = false;
 	return noErrors;
@@ -29,6 +29,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolutil/Keccak256.h>
 
+#include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
 #include <boost/algorithm/string.hpp>
@@ -105,7 +106,7 @@ FunctionDefinition const* ASTNode::resolveFunctionCall(FunctionCall const& _func
 ASTAnnotation& ASTNode::annotation() const
 {
 	if (!m_annotation)
-		m_annotation = make_unique<ASTAnnotation>();
+		m_annotation.reset(newAnnotation<ASTAnnotation>());
 	return *m_annotation;
 }
 
@@ -114,10 +115,25 @@ SourceUnitAnnotation& SourceUnit::annotation() const
 	return initAnnotation<SourceUnitAnnotation>();
 }
 
+vector<ContractDefinition const*> const& SourceUnit::contracts() const
+{
+	return m_contracts.init([&]{ return filteredNodes<ContractDefinition>(m_nodes); });
+}
+
+vector<ImportDirective const*> const& SourceUnit::imports() const
+{
+	return m_imports.init([&]{ return filteredNodes<ImportDirective>(m_nodes); });
+}
+
+vector<UsingForDirective const*> const& SourceUnit::usingForDirectives() const
+{
+	return m_usingForDirectives.init([&]{ return filteredNodes<UsingForDirective>(m_nodes); });
+}
+
 set<SourceUnit const*> SourceUnit::referencedSourceUnits(bool _recurse, set<SourceUnit const*> _skipList) const
 {
 	set<SourceUnit const*> sourceUnits;
-	for (ImportDirective const* importDirective: filteredNodes<ImportDirective>(nodes()))
+	for (ImportDirective const* importDirective: imports())
 	{
 		auto const& sourceUnit = importDirective->annotation().sourceUnit;
 		if (!_skipList.count(sourceUnit))
@@ -343,12 +359,74 @@ multimap<std::string, FunctionDefinition const*> const& ContractDefinition::defi
 {
 	return m_definedFunctionsByName.init([&]{
 		std::multimap<std::string, FunctionDefinition const*> result;
-		for (FunctionDefinition const* fun: filteredNodes<FunctionDefinition>(m_subNodes))
+		for (FunctionDefinition const* fun: definedFunctions())
 			result.insert({fun->name(), fun});
 		return result;
 	});
 }
 
+vector<UsingForDirective const*> const& ContractDefinition::usingForDirectives() const
+{
+	return m_usingForDirectives.init([&]{ return filteredNodes<UsingForDirective>(m_subNodes); });
+}
+
+vector<StructDefinition const*> const& ContractDefinition::definedStructs() const
+{
+	return m_definedStructs.init([&]{ return filteredNodes<StructDefinition>(m_subNodes); });
+}
+
+vector<EnumDefinition const*> const& ContractDefinition::definedEnums() const
+{
+	return m_definedEnums.init([&]{ return filteredNodes<EnumDefinition>(m_subNodes); });
+}
+
+vector<VariableDeclaration const*> const& ContractDefinition::stateVariables() const
+{
+	return m_stateVariables.init([&]{ return filteredNodes<VariableDeclaration>(m_subNodes); });
+}
+
+vector<ModifierDefinition const*> const& ContractDefinition::functionModifiers() const
+{
+	return m_functionModifiers.init([&]{ return filteredNodes<ModifierDefinition>(m_subNodes); });
+}
+
+vector<FunctionDefinition const*> const& ContractDefinition::definedFunctions() const
+{
+	return m_definedFunctions.init([&]{ return filteredNodes<FunctionDefinition>(m_subNodes); });
+}
+
+vector<EventDefinition const*> const& ContractDefinition::events() const
+{
+	return m_events.init([&]{ return filteredNodes<EventDefinition>(m_subNodes); });
+}
+
+vector<Declaration const*> const& ContractDefinition::declarations() const
+{
+	return m_declarations.init([&]{ return filteredNodes<Declaration>(m_subNodes); });
+}
+
+vector<FunctionDefinition const*> const& ContractDefinition::linearizedDefinedFunctions() const
+{
+	return m_linearizedDefinedFunctions.init([&]{
+		solAssert(!annotation().linearizedBaseContracts.empty(), "");
+		vector<FunctionDefinition const*> result;
+		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
+			result += contract->definedFunctions();
+		return result;
+	});
+}
+
+vector<VariableDeclaration const*> const& ContractDefinition::linearizedStateVariables() const
+{
+	return m_linearizedStateVariables.init([&]{
+		solAssert(!annotation().linearizedBaseContracts.empty(), "");
+		vector<VariableDeclaration const*> result;
+		for (ContractDefinition const* contract: annotation().linearizedBaseContracts | ranges::views::reverse)
+			result += contract->stateVariables();
+		return result;
+	});
+}
+
 
 TypeNameAnnotation& TypeName::annotation() const
 {
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/ast/ASTArena.h>
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/ASTAnnotations.h>
@@ -112,6 +113,12 @@ public:
 
 	///@todo make this const-safe by providing a different way to access the annotation
 	virtual ASTAnnotation& annotation() const;
+	/// Creates the annotation in @a _arena, which has to outlive the node.
+	void createAnnotationIn(ASTArena& _arena) const
+	{
+		m_annotation.get_deleter().arena = &_arena;
+		annotation();
+	}
 
 	///@{
 	///@name equality operators
@@ -127,13 +134,22 @@ protected:
 	T& initAnnotation() const
 	{
 		if (!m_annotation)
-			m_annotation = std::make_unique<T>();
+			m_annotation.reset(newAnnotation<T>());
 		return dynamic_cast<T&>(*m_annotation);
 	}
 
+	template <class T>
+	T* newAnnotation() const
+	{
+		if (ASTArena* arena = m_annotation.get_deleter().arena)
+			return new (arena->allocate(sizeof(T), alignof(T))) T();
+		return new T();
+	}
+
 private:
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
-	mutable std::unique_ptr<ASTAnnotation> m_annotation;
+	/// Nodes allocated from an arena create it there right away.
+	mutable std::unique_ptr<ASTAnnotation, ASTArenaDeleter<ASTAnnotation>> m_annotation;
 	SourceLocation m_location;
 };
 
@@ -175,7 +191,11 @@ public:
 	SourceUnitAnnotation& annotation() const override;
 
 	std::optional<std::string> const& licenseString() const { return m_licenseString; }
-	std::vector<ASTPointer<ASTNode>> nodes() const { return m_nodes; }
+	std::vector<ASTPointer<ASTNode>> const& nodes() const { return m_nodes; }
+	/// The lists below are built on the first call and kept.
+	std::vector<ContractDefinition const*> const& contracts() const;
+	std::vector<ImportDirective const*> const& imports() const;
+	std::vector<UsingForDirective const*> const& usingForDirectives() const;
 
 	/// @returns a set of referenced SourceUnits. Recursively if @a _recurse is true.
 	std::set<SourceUnit const*> referencedSourceUnits(bool _recurse = false, std::set<SourceUnit const*> _skipList = std::set<SourceUnit const*>()) const;
@@ -183,6 +203,9 @@ public:
 private:
 	std::optional<std::string> m_licenseString;
 	std::vector<ASTPointer<ASTNode>> m_nodes;
+	util::LazyInit<std::vector<ContractDefinition const*>> m_contracts;
+	util::LazyInit<std::vector<ImportDirective const*>> m_imports;
+	util::LazyInit<std::vector<UsingForDirective const*>> m_usingForDirectives;
 };
 
 /**
@@ -510,12 +533,20 @@ public:
 
 	std::vector<ASTPointer<InheritanceSpecifier>> const& baseContracts() const { return m_baseContracts; }
 	std::vector<ASTPointer<ASTNode>> const& subNodes() const { return m_subNodes; }
-	std::vector<UsingForDirective const*> usingForDirectives() const { return filteredNodes<UsingForDirective>(m_subNodes); }
-	std::vector<StructDefinition const*> definedStructs() const { return filteredNodes<StructDefinition>(m_subNodes); }
-	std::vector<EnumDefinition const*> definedEnums() const { return filteredNodes<EnumDefinition>(m_subNodes); }
-	std::vector<VariableDeclaration const*> stateVariables() const { return filteredNodes<VariableDeclaration>(m_subNodes); }
-	std::vector<ModifierDefinition const*> functionModifiers() const { return filteredNodes<ModifierDefinition>(m_subNodes); }
-	std::vector<FunctionDefinition const*> definedFunctions() const { return filteredNodes<FunctionDefinition>(m_subNodes); }
+	/// The lists below are built on the first call and kept, the sub nodes never change.
+	std::vector<UsingForDirective const*> const& usingForDirectives() const;
+	std::vector<StructDefinition const*> const& definedStructs() const;
+	std::vector<EnumDefinition const*> const& definedEnums() const;
+	std::vector<VariableDeclaration const*> const& stateVariables() const;
+	std::vector<ModifierDefinition const*> const& functionModifiers() const;
+	std::vector<FunctionDefinition const*> const& definedFunctions() const;
+	/// @returns functions defined in this contract and all its bases,
+	/// in the order of linearizedBaseContracts (most derived first).
+	/// Available only after inheritance resolution.
+	std::vector<FunctionDefinition const*> const& linearizedDefinedFunctions() const;
+	/// @returns state variables of this contract and all its bases, most base first.
+	/// Available only after inheritance resolution.
+	std::vector<VariableDeclaration const*> const& linearizedStateVariables() const;
 	/// @returns a view<FunctionDefinition const*> of all functions
 	/// defined in this contract of the given name (excluding inherited functions).
 	auto definedFunctions(std::string const& _name) const
@@ -523,7 +554,7 @@ public:
 		auto&& [b, e] = definedFunctionsByName().equal_range(_name);
 		return ranges::subrange<decltype(b)>(b, e) | ranges::views::values;
 	}
-	std::vector<EventDefinition const*> events() const { return filteredNodes<EventDefinition>(m_subNodes); }
+	std::vector<EventDefinition const*> const& events() const;
 	std::vector<EventDefinition const*> const& definedInterfaceEvents() const;
 	std::vector<EventDefinition const*> const usedInterfaceEvents() const;
 	/// @returns all errors defined in this contract or any base contract
@@ -544,7 +575,7 @@ public:
 	uint32_t interfaceId() const;
 
 	/// @returns a list of all declarations in this contract
-	std::vector<Declaration const*> declarations() const { return filteredNodes<Declaration>(m_subNodes); }
+	std::vector<Declaration const*> const& declarations() const;
 
 	/// Returns the constructor or nullptr if no constructor was specified.
 	FunctionDefinition const* constructor() const;
@@ -586,6 +617,16 @@ private:
 	util::LazyInit<std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList[2];
 	util::LazyInit<std::vector<EventDefinition const*>> m_interfaceEvents;
 	util::LazyInit<std::multimap<std::string, FunctionDefinition const*>> m_definedFunctionsByName;
+	util::LazyInit<std::vector<UsingForDirective const*>> m_usingForDirectives;
+	util::LazyInit<std::vector<StructDefinition const*>> m_definedStructs;
+	util::LazyInit<std::vector<EnumDefinition const*>> m_definedEnums;
+	util::LazyInit<std::vector<VariableDeclaration const*>> m_stateVariables;
+	util::LazyInit<std::vector<ModifierDefinition const*>> m_functionModifiers;
+	util::LazyInit<std::vector<FunctionDefinition const*>> m_definedFunctions;
+	util::LazyInit<std::vector<EventDefinition const*>> m_events;
+	util::LazyInit<std::vector<Declaration const*>> m_declarations;
+	util::LazyInit<std::vector<FunctionDefinition const*>> m_linearizedDefinedFunctions;
+	util::LazyInit<std::vector<VariableDeclaration const*>> m_linearizedStateVariables;
 };
 
 /**
@@ -29,6 +29,7 @@
 
 #include <libsolutil/SetOnce.h>
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
@@ -168,6 +169,9 @@ struct CallableDeclarationAnnotation: DeclarationAnnotation
 {
 	/// The set of functions/modifiers/events this callable overrides.
 	std::set<CallableDeclaration const*> baseFunctions;
+	/// Hash of the ABI signature, before the outbound message bit is applied. Indexed by
+	/// whether the first parameter is skipped (library calls). Filled lazily by the code generator.
+	std::optional<uint32_t> signatureHash[2];
 };
 
 struct FunctionDefinitionAnnotation: CallableDeclarationAnnotation, StructurallyDocumentedAnnotation
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Arena that AST nodes of a source unit are allocated from.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace solidity::frontend
+{
+
+/// Nodes are allocated one after another in big blocks, deallocation of a single node is a no-op
+/// and the blocks are released at once together with the arena.
+using ASTArena = std::pmr::monotonic_buffer_resource;
+
+/**
+ * Allocator for `std::allocate_shared` that takes memory from an ASTArena.
+ * It doesn't own the arena: the owner of the arena (CompilerStack keeps it in its Source)
+ * must keep it alive until all the nodes allocated from it are destroyed.
+ */
+template <class T>
+class ASTArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ASTArenaAllocator(ASTArena* _arena): m_arena(_arena) {}
+	template <class U>
+	ASTArenaAllocator(ASTArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(std::size_t _n) { return static_cast<T*>(m_arena->allocate(_n * sizeof(T), alignof(T))); }
+	void deallocate(T* _p, std::size_t _n) { m_arena->deallocate(_p, _n * sizeof(T), alignof(T)); }
+
+	ASTArena* arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ASTArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ASTArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	ASTArena* m_arena = nullptr;
+};
+
+/**
+ * Deleter for objects that are allocated either from an ASTArena (if `arena` is set) or with `new`.
+ * Objects from the arena are only destroyed, their memory is released together with the arena.
+ */
+template <class T>
+struct ASTArenaDeleter
+{
+	ASTArena* arena = nullptr;
+
+	void operator()(T* _p) const
+	{
+		if (arena)
+			_p->~T();
+		else
+			delete _p;
+	}
+};
+
+}
@@ -107,8 +107,8 @@ void ASTJsonExporter::setJsonNode(
 
 optional<size_t> ASTJsonExporter::sourceIndexFromLocation(SourceLocation const& _location) const
 {
-	if (_location.sourceName && m_sourceIndices.count(*_location.sourceName))
-		return m_sourceIndices.at(*_location.sourceName);
+	if (_location.sourceName() && m_sourceIndices.count(*_location.sourceName()))
+		return m_sourceIndices.at(*_location.sourceName());
 	else
 		return nullopt;
 }
@@ -26,599 +26,578 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-NullType const TypeProvider::m_nullType{};
-EmptyMapType const TypeProvider::m_emptyMapType{};
-TvmCellType const TypeProvider::m_tvmcell{};
-TvmSliceType const TypeProvider::m_tvmslice{};
-TvmBuilderType const TypeProvider::m_tvmbuilder{};
-
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
-
-/// The string and bytes unique_ptrs are initialized when they are first used because
-/// they rely on `byte` being available which we cannot guarantee in the static init context.
-unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-unique_ptr<Variant> TypeProvider::m_variant;
-unique_ptr<ArrayType> TypeProvider::m_stringMemory;
-
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_address{};
-InitializerListType const TypeProvider::m_initializerList{};
-CallListType const TypeProvider::m_callList{};
-
-std::unique_ptr<IntegerType> const TypeProvider::m_int257 = make_unique<IntegerType>(257, IntegerType::Modifier::Signed);
-
-//for i in range(1, 257):
-//	print("{{make_unique<IntegerType>({}, IntegerType::Modifier::Signed)}},".format(i))
-array<unique_ptr<IntegerType>, 256> const TypeProvider::m_intM{{
-	{make_unique<IntegerType>(1, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(2, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(3, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(4, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(5, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(6, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(7, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(9, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(10, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(11, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(12, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(13, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(14, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(15, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(16, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(17, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(18, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(19, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(20, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(21, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(22, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(23, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(24, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(25, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(26, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(27, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(28, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(29, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(30, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(31, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(32, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(33, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(34, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(35, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(36, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(37, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(38, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(39, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(40, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(41, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(42, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(43, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(44, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(45, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(46, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(47, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(48, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(49, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(50, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(51, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(52, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(53, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(54, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(55, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(56, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(57, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(58, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(59, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(60, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(61, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(62, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(63, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(64, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(65, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(66, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(67, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(68, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(69, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(70, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(71, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(72, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(73, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(74, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(75, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(76, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(77, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(78, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(79, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(80, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(81, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(82, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(83, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(84, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(85, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(86, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(87, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(88, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(89, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(90, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(91, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(92, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(93, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(94, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(95, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(96, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(97, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(98, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(99, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(100, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(101, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(102, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(103, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(104, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(105, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(106, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(107, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(108, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(109, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(110, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(111, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(112, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(113, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(114, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(115, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(116, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(117, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(118, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(119, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(120, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(121, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(122, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(123, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(124, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(125, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(126, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(127, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(128, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(129, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(130, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(131, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(132, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(133, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(134, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(135, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(136, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(137, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(138, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(139, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(140, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(141, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(142, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(143, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(144, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(145, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(146, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(147, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(148, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(149, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(150, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(151, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(152, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(153, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(154, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(155, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(156, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(157, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(158, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(159, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(160, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(161, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(162, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(163, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(164, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(165, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(166, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(167, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(168, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(169, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(170, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(171, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(172, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(173, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(174, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(175, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(176, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(177, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(178, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(179, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(180, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(181, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(182, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(183, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(184, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(185, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(186, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(187, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(188, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(189, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(190, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(191, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(192, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(193, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(194, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(195, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(196, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(197, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(198, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(199, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(200, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(201, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(202, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(203, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(204, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(205, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(206, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(207, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(208, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(209, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(210, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(211, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(212, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(213, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(214, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(215, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(216, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(217, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(218, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(219, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(220, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(221, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(222, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(223, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(224, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(225, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(226, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(227, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(228, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(229, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(230, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(231, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(232, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(233, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(234, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(235, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(236, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(237, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(238, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(239, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(240, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(241, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(242, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(243, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(244, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(245, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(246, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(247, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(248, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(249, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(250, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(251, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(252, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(253, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(254, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(255, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(256, IntegerType::Modifier::Signed)},
-}};
-
-//for i in range(1, 257):
-//	print("{{make_unique<IntegerType>({}, IntegerType::Modifier::Unsigned)}},".format(i))
-array<unique_ptr<IntegerType>, 256> const TypeProvider::m_uintM{{
-	{make_unique<IntegerType>(1, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(2, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(3, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(4, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(5, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(6, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(7, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(9, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(10, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(11, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(12, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(13, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(14, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(15, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(16, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(17, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(18, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(19, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(20, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(21, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(22, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(23, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(24, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(25, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(26, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(27, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(28, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(29, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(30, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(31, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(32, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(33, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(34, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(35, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(36, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(37, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(38, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(39, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(40, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(41, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(42, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(43, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(44, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(45, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(46, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(47, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(48, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(49, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(50, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(51, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(52, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(53, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(54, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(55, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(56, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(57, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(58, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(59, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(60, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(61, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(62, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(63, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(64, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(65, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(66, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(67, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(68, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(69, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(70, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(71, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(72, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(73, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(74, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(75, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(76, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(77, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(78, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(79, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(80, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(81, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(82, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(83, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(84, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(85, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(86, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(87, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(88, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(89, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(90, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(91, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(92, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(93, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(94, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(95, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(96, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(97, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(98, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(99, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(100, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(101, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(102, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(103, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(104, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(105, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(106, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(107, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(108, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(109, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(110, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(111, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(112, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(113, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(114, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(115, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(116, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(117, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(118, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(119, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(120, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(121, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(122, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(123, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(124, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(125, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(126, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(127, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(128, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(129, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(130, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(131, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(132, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(133, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(134, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(135, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(136, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(137, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(138, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(139, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(140, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(141, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(142, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(143, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(144, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(145, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(146, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(147, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(148, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(149, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(150, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(151, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(152, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(153, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(154, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(155, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(156, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(157, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(158, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(159, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(160, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(161, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(162, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(163, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(164, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(165, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(166, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(167, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(168, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(169, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(170, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(171, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(172, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(173, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(174, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(175, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(176, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(177, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(178, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(179, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(180, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(181, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(182, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(183, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(184, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(185, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(186, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(187, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(188, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(189, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(190, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(191, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(192, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(193, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(194, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(195, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(196, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(197, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(198, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(199, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(200, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(201, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(202, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(203, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(204, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(205, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(206, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(207, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(208, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(209, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(210, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(211, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(212, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(213, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(214, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(215, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(216, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(217, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(218, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(219, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(220, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(221, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(222, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(223, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(224, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(225, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(226, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(227, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(228, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(229, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(230, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(231, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(232, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(233, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(234, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(235, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(236, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(237, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(238, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(239, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(240, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(241, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(242, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(243, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(244, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(245, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(246, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(247, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(248, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(249, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(250, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(251, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(252, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(253, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(254, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(255, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(256, IntegerType::Modifier::Unsigned)},
-}};
-
-array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
-	{make_unique<FixedBytesType>(1)},
-	{make_unique<FixedBytesType>(2)},
-	{make_unique<FixedBytesType>(3)},
-	{make_unique<FixedBytesType>(4)},
-	{make_unique<FixedBytesType>(5)},
-	{make_unique<FixedBytesType>(6)},
-	{make_unique<FixedBytesType>(7)},
-	{make_unique<FixedBytesType>(8)},
-	{make_unique<FixedBytesType>(9)},
-	{make_unique<FixedBytesType>(10)},
-	{make_unique<FixedBytesType>(11)},
-	{make_unique<FixedBytesType>(12)},
-	{make_unique<FixedBytesType>(13)},
-	{make_unique<FixedBytesType>(14)},
-	{make_unique<FixedBytesType>(15)},
-	{make_unique<FixedBytesType>(16)},
-	{make_unique<FixedBytesType>(17)},
-	{make_unique<FixedBytesType>(18)},
-	{make_unique<FixedBytesType>(19)},
-	{make_unique<FixedBytesType>(20)},
-	{make_unique<FixedBytesType>(21)},
-	{make_unique<FixedBytesType>(22)},
-	{make_unique<FixedBytesType>(23)},
-	{make_unique<FixedBytesType>(24)},
-	{make_unique<FixedBytesType>(25)},
-	{make_unique<FixedBytesType>(26)},
-	{make_unique<FixedBytesType>(27)},
-	{make_unique<FixedBytesType>(28)},
-	{make_unique<FixedBytesType>(29)},
-	{make_unique<FixedBytesType>(30)},
-	{make_unique<FixedBytesType>(31)},
-	{make_unique<FixedBytesType>(32)}
-}};
-
-array<unique_ptr<MagicType>, 8> const TypeProvider::m_magics{{
-	{make_unique<MagicType>(MagicType::Kind::Block)},
-	{make_unique<MagicType>(MagicType::Kind::Message)},
-	{make_unique<MagicType>(MagicType::Kind::Transaction)},
-	{make_unique<MagicType>(MagicType::Kind::ABI)},
-	{make_unique<MagicType>(MagicType::Kind::TVM)},
-	{make_unique<MagicType>(MagicType::Kind::Math)},
-	{make_unique<MagicType>(MagicType::Kind::Rnd)},
-	{make_unique<MagicType>(MagicType::Kind::Gosh)}
-	// MetaType is stored separately
-}};
+TypeProvider::TypeProvider():
+	m_int257{make_unique<IntegerType>(257, IntegerType::Modifier::Signed)},
+	//for i in range(1, 257):
+	//	print("{{make_unique<IntegerType>({}, IntegerType::Modifier::Signed)}},".format(i))
+	m_intM{{
+		{make_unique<IntegerType>(1, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(2, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(3, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(4, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(5, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(6, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(7, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(8, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(9, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(10, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(11, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(12, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(13, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(14, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(15, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(16, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(17, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(18, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(19, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(20, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(21, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(22, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(23, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(24, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(25, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(26, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(27, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(28, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(29, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(30, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(31, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(32, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(33, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(34, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(35, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(36, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(37, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(38, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(39, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(40, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(41, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(42, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(43, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(44, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(45, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(46, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(47, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(48, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(49, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(50, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(51, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(52, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(53, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(54, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(55, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(56, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(57, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(58, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(59, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(60, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(61, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(62, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(63, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(64, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(65, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(66, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(67, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(68, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(69, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(70, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(71, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(72, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(73, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(74, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(75, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(76, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(77, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(78, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(79, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(80, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(81, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(82, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(83, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(84, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(85, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(86, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(87, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(88, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(89, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(90, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(91, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(92, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(93, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(94, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(95, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(96, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(97, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(98, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(99, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(100, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(101, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(102, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(103, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(104, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(105, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(106, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(107, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(108, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(109, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(110, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(111, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(112, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(113, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(114, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(115, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(116, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(117, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(118, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(119, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(120, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(121, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(122, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(123, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(124, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(125, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(126, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(127, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(128, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(129, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(130, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(131, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(132, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(133, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(134, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(135, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(136, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(137, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(138, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(139, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(140, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(141, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(142, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(143, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(144, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(145, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(146, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(147, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(148, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(149, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(150, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(151, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(152, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(153, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(154, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(155, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(156, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(157, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(158, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(159, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(160, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(161, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(162, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(163, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(164, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(165, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(166, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(167, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(168, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(169, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(170, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(171, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(172, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(173, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(174, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(175, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(176, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(177, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(178, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(179, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(180, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(181, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(182, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(183, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(184, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(185, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(186, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(187, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(188, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(189, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(190, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(191, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(192, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(193, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(194, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(195, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(196, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(197, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(198, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(199, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(200, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(201, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(202, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(203, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(204, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(205, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(206, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(207, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(208, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(209, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(210, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(211, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(212, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(213, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(214, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(215, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(216, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(217, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(218, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(219, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(220, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(221, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(222, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(223, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(224, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(225, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(226, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(227, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(228, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(229, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(230, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(231, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(232, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(233, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(234, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(235, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(236, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(237, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(238, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(239, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(240, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(241, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(242, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(243, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(244, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(245, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(246, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(247, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(248, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(249, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(250, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(251, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(252, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(253, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(254, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(255, IntegerType::Modifier::Signed)},
+		{make_unique<IntegerType>(256, IntegerType::Modifier::Signed)},
+	}},
+
+	//for i in range(1, 257):
+	//	print("{{make_unique<IntegerType>({}, IntegerType::Modifier::Unsigned)}},".format(i))
+	m_uintM{{
+		{make_unique<IntegerType>(1, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(2, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(3, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(4, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(5, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(6, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(7, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(8, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(9, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(10, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(11, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(12, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(13, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(14, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(15, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(16, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(17, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(18, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(19, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(20, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(21, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(22, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(23, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(24, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(25, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(26, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(27, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(28, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(29, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(30, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(31, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(32, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(33, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(34, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(35, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(36, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(37, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(38, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(39, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(40, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(41, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(42, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(43, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(44, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(45, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(46, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(47, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(48, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(49, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(50, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(51, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(52, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(53, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(54, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(55, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(56, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(57, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(58, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(59, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(60, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(61, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(62, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(63, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(64, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(65, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(66, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(67, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(68, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(69, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(70, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(71, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(72, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(73, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(74, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(75, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(76, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(77, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(78, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(79, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(80, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(81, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(82, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(83, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(84, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(85, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(86, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(87, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(88, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(89, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(90, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(91, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(92, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(93, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(94, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(95, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(96, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(97, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(98, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(99, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(100, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(101, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(102, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(103, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(104, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(105, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(106, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(107, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(108, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(109, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(110, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(111, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(112, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(113, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(114, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(115, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(116, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(117, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(118, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(119, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(120, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(121, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(122, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(123, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(124, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(125, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(126, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(127, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(128, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(129, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(130, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(131, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(132, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(133, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(134, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(135, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(136, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(137, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(138, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(139, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(140, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(141, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(142, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(143, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(144, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(145, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(146, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(147, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(148, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(149, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(150, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(151, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(152, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(153, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(154, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(155, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(156, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(157, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(158, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(159, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(160, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(161, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(162, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(163, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(164, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(165, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(166, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(167, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(168, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(169, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(170, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(171, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(172, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(173, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(174, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(175, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(176, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(177, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(178, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(179, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(180, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(181, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(182, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(183, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(184, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(185, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(186, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(187, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(188, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(189, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(190, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(191, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(192, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(193, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(194, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(195, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(196, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(197, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(198, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(199, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(200, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(201, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(202, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(203, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(204, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(205, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(206, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(207, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(208, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(209, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(210, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(211, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(212, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(213, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(214, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(215, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(216, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(217, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(218, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(219, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(220, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(221, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(222, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(223, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(224, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(225, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(226, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(227, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(228, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(229, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(230, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(231, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(232, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(233, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(234, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(235, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(236, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(237, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(238, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(239, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(240, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(241, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(242, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(243, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(244, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(245, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(246, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(247, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(248, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(249, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(250, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(251, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(252, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(253, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(254, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(255, IntegerType::Modifier::Unsigned)},
+		{make_unique<IntegerType>(256, IntegerType::Modifier::Unsigned)},
+	}},
+
+	m_bytesM{{
+		{make_unique<FixedBytesType>(1)},
+		{make_unique<FixedBytesType>(2)},
+		{make_unique<FixedBytesType>(3)},
+		{make_unique<FixedBytesType>(4)},
+		{make_unique<FixedBytesType>(5)},
+		{make_unique<FixedBytesType>(6)},
+		{make_unique<FixedBytesType>(7)},
+		{make_unique<FixedBytesType>(8)},
+		{make_unique<FixedBytesType>(9)},
+		{make_unique<FixedBytesType>(10)},
+		{make_unique<FixedBytesType>(11)},
+		{make_unique<FixedBytesType>(12)},
+		{make_unique<FixedBytesType>(13)},
+		{make_unique<FixedBytesType>(14)},
+		{make_unique<FixedBytesType>(15)},
+		{make_unique<FixedBytesType>(16)},
+		{make_unique<FixedBytesType>(17)},
+		{make_unique<FixedBytesType>(18)},
+		{make_unique<FixedBytesType>(19)},
+		{make_unique<FixedBytesType>(20)},
+		{make_unique<FixedBytesType>(21)},
+		{make_unique<FixedBytesType>(22)},
+		{make_unique<FixedBytesType>(23)},
+		{make_unique<FixedBytesType>(24)},
+		{make_unique<FixedBytesType>(25)},
+		{make_unique<FixedBytesType>(26)},
+		{make_unique<FixedBytesType>(27)},
+		{make_unique<FixedBytesType>(28)},
+		{make_unique<FixedBytesType>(29)},
+		{make_unique<FixedBytesType>(30)},
+		{make_unique<FixedBytesType>(31)},
+		{make_unique<FixedBytesType>(32)}
+	}},
+
+	m_magics{{
+		{make_unique<MagicType>(MagicType::Kind::Block)},
+		{make_unique<MagicType>(MagicType::Kind::Message)},
+		{make_unique<MagicType>(MagicType::Kind::Transaction)},
+		{make_unique<MagicType>(MagicType::Kind::ABI)},
+		{make_unique<MagicType>(MagicType::Kind::TVM)},
+		{make_unique<MagicType>(MagicType::Kind::Math)},
+		{make_unique<MagicType>(MagicType::Kind::Rnd)},
+		{make_unique<MagicType>(MagicType::Kind::Gosh)}
+		// MetaType is stored separately
+	}}
+{
+}
 
 inline void clearCache(Type const& type)
 {
@@ -642,16 +621,17 @@ inline void clearCaches(Container& container)
 
 void TypeProvider::reset()
 {
-	clearCache(m_boolean);
-	clearCache(m_inaccessibleDynamic);
-	clearCache(m_bytesStorage);
-	clearCache(m_bytesMemory);
-	clearCache(m_bytesCalldata);
-	clearCache(m_stringStorage);
-	clearCache(m_variant);
-	clearCache(m_stringMemory);
-	clearCache(m_emptyTuple);
-	clearCache(m_address);
+	lock_guard<recursive_mutex> guard(mutex());
+	clearCache(instance().m_boolean);
+	clearCache(instance().m_inaccessibleDynamic);
+	clearCache(instance().m_bytesStorage);
+	clearCache(instance().m_bytesMemory);
+	clearCache(instance().m_bytesCalldata);
+	clearCache(instance().m_stringStorage);
+	clearCache(instance().m_variant);
+	clearCache(instance().m_stringMemory);
+	clearCache(instance().m_emptyTuple);
+	clearCache(instance().m_address);
 	clearCaches(instance().m_intM);
 	clearCaches(instance().m_uintM);
 	clearCaches(instance().m_bytesM);
@@ -667,6 +647,7 @@ void TypeProvider::reset()
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
+	lock_guard<recursive_mutex> guard(mutex());
 	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
@@ -772,44 +753,56 @@ Type const* TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = make_unique<ArrayType>(false);
-	return m_bytesStorage.get();
+	lock_guard<recursive_mutex> guard(mutex());
+	unique_ptr<ArrayType>& type = instance().m_bytesStorage;
+	if (!type)
+		type = make_unique<ArrayType>(false);
+	return type.get();
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = make_unique<ArrayType>(false);
-	return m_bytesMemory.get();
+	lock_guard<recursive_mutex> guard(mutex());
+	unique_ptr<ArrayType>& type = instance().m_bytesMemory;
+	if (!type)
+		type = make_unique<ArrayType>(false);
+	return type.get();
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = make_unique<ArrayType>(false);
-	return m_bytesCalldata.get();
+	lock_guard<recursive_mutex> guard(mutex());
+	unique_ptr<ArrayType>& type = instance().m_bytesCalldata;
+	if (!type)
+		type = make_unique<ArrayType>(false);
+	return type.get();
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = make_unique<ArrayType>(true);
-	return m_stringStorage.get();
+	lock_guard<recursive_mutex> guard(mutex());
+	unique_ptr<ArrayType>& type = instance().m_stringStorage;
+	if (!type)
+		type = make_unique<ArrayType>(true);
+	return type.get();
 }
 
 Variant const* TypeProvider::variant()
 {
-    if (!m_variant)
-        m_variant = make_unique<Variant>();
-    return m_variant.get();
+	lock_guard<recursive_mutex> guard(mutex());
+	unique_ptr<Variant>& type = instance().m_variant;
+	if (!type)
+		type = make_unique<Variant>();
+	return type.get();
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = make_unique<ArrayType>(true);
-	return m_stringMemory.get();
+	lock_guard<recursive_mutex> guard(mutex());
+	unique_ptr<ArrayType>& type = instance().m_stringMemory;
+	if (!type)
+		type = make_unique<ArrayType>(true);
+	return type.get();
 }
 
 Type const* TypeProvider::forLiteral(Literal const& _literal)
@@ -855,6 +848,7 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
+	lock_guard<recursive_mutex> guard(mutex());
 	auto i = instance().m_stringLiteralTypes.find(literal);
 	if (i != instance().m_stringLiteralTypes.end())
 		return i->second.get();
@@ -863,6 +857,7 @@ StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 }
 
 VarInteger const* TypeProvider::varInteger(unsigned m, IntegerType::Modifier _modifier) {
+	lock_guard<recursive_mutex> guard(mutex());
 	auto& map = instance().m_varInterger;
 	auto i = map.find(make_pair(m, _modifier));
 	if (i != map.end())
@@ -877,6 +872,7 @@ VarInteger const* TypeProvider::varInteger(unsigned m, IntegerType::Modifier _mo
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
+	lock_guard<recursive_mutex> guard(mutex());
 	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
 
 	auto i = map.find(make_pair(m, n));
@@ -892,7 +888,7 @@ FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPoin
 TupleType const* TypeProvider::tuple(vector<Type const*> members)
 {
 	if (members.empty())
-		return &m_emptyTuple;
+		return emptyTuple();
 
 	return createAndGet<TupleType>(std::move(members));
 }
@@ -902,6 +898,7 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, bool
 	if (_type->isPointer() == _isPointer)
 		return _type;
 
+	lock_guard<recursive_mutex> guard(mutex());
 	instance().m_generalTypes.emplace_back(_type->copyForLocation(_isPointer));
 	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
 }
@@ -1031,7 +1028,7 @@ ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
 {
 	solAssert(_kind != MagicType::Kind::MetaType, "MetaType is handled separately");
-	return m_magics.at(static_cast<size_t>(_kind)).get();
+	return instance().m_magics.at(static_cast<size_t>(_kind)).get();
 }
 
 MagicType const* TypeProvider::meta(Type const* _type)
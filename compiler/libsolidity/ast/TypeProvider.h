@@ -23,6 +23,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -37,17 +38,47 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Every thread has its own set of types, so compilations in different threads don't share
+ * the types and their caches. Worker threads of a compilation use the types of the thread
+ * that runs it, see @ref Scope.
  */
 class TypeProvider
 {
 public:
-	TypeProvider() = default;
-	TypeProvider(TypeProvider&&) = default;
+	TypeProvider();
+	TypeProvider(TypeProvider&&) = delete;
 	TypeProvider(TypeProvider const&) = delete;
-	TypeProvider& operator=(TypeProvider&&) = default;
+	TypeProvider& operator=(TypeProvider&&) = delete;
 	TypeProvider& operator=(TypeProvider const&) = delete;
 	~TypeProvider() = default;
 
+	/// Makes the current thread use the types of another thread while it exists, so that
+	/// the types of annotations compare equal to the ones the current thread gets.
+	class Scope
+	{
+	public:
+		explicit Scope(TypeProvider& _provider): m_previous{shared()} { shared() = &_provider; }
+		~Scope() { shared() = m_previous; }
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+	private:
+		TypeProvider* m_previous;
+	};
+
+	/// TypeProvider instance of the current thread.
+	static TypeProvider& instance()
+	{
+		if (TypeProvider* provider = shared())
+			return *provider;
+		static thread_local TypeProvider _provider;
+		return _provider;
+	}
+
+	/// Guards the types of the current instance and their caches, which are shared by
+	/// the threads of a compilation. Locked by the functions that create types.
+	static std::recursive_mutex& mutex() { return instance().m_mutex; }
+
 	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
@@ -61,14 +92,14 @@ public:
 	static Type const* fromElementaryTypeName(std::string const& _name);
 
 	/// @returns boolean type.
-	static BoolType const* boolean() noexcept { return &m_boolean; }
-	static NullType const* nullType() noexcept { return &m_nullType; }
-	static EmptyMapType const* emptyMapType() noexcept { return &m_emptyMapType; }
-	static TvmCellType const* tvmcell() noexcept { return &m_tvmcell; }
-	static TvmSliceType const* tvmslice() noexcept { return &m_tvmslice; }
-	static TvmBuilderType const* tvmbuilder() noexcept { return &m_tvmbuilder; }
+	static BoolType const* boolean() noexcept { return &instance().m_boolean; }
+	static NullType const* nullType() noexcept { return &instance().m_nullType; }
+	static EmptyMapType const* emptyMapType() noexcept { return &instance().m_emptyMapType; }
+	static TvmCellType const* tvmcell() noexcept { return &instance().m_tvmcell; }
+	static TvmSliceType const* tvmslice() noexcept { return &instance().m_tvmslice; }
+	static TvmBuilderType const* tvmbuilder() noexcept { return &instance().m_tvmbuilder; }
 	static FixedBytesType const* byte() { return fixedBytes(1); }
-	static FixedBytesType const* fixedBytes(unsigned m) { return m_bytesM.at(m - 1).get(); }
+	static FixedBytesType const* fixedBytes(unsigned m) { return instance().m_bytesM.at(m - 1).get(); }
 	static ArrayType const* bytesStorage();
 	static ArrayType const* bytesMemory();
 	static ArrayType const* bytesCalldata();
@@ -87,20 +118,20 @@ public:
 
 	static ArraySliceType const* arraySlice(ArrayType const& _arrayType);
 
-	static AddressType const* address() noexcept { return &m_address; }
-	static InitializerListType const* initializerList() noexcept { return &m_initializerList; }
-	static CallListType const* callList() noexcept { return &m_callList; }
+	static AddressType const* address() noexcept { return &instance().m_address; }
+	static InitializerListType const* initializerList() noexcept { return &instance().m_initializerList; }
+	static CallListType const* callList() noexcept { return &instance().m_callList; }
 
 	static IntegerType const* integer(unsigned _bits, IntegerType::Modifier _modifier)
 	{
 		if (_bits == 257 && _modifier == IntegerType::Modifier::Signed) {
-			return m_int257.get();
+			return instance().m_int257.get();
 		}
 
 		if (_modifier == IntegerType::Modifier::Unsigned)
-			return m_uintM.at(_bits - 1).get();
+			return instance().m_uintM.at(_bits - 1).get();
 		else
-			return m_intM.at(_bits - 1).get();
+			return instance().m_intM.at(_bits - 1).get();
 	}
 
 	static IntegerType const* uint(unsigned _bits) { return integer(_bits, IntegerType::Modifier::Unsigned); }
@@ -118,7 +149,7 @@ public:
 	/// @returns a tuple type with the given members.
 	static TupleType const* tuple(std::vector<Type const*> members);
 
-	static TupleType const* emptyTuple() noexcept { return &m_emptyTuple; }
+	static TupleType const* emptyTuple() noexcept { return &instance().m_emptyTuple; }
 
 	static ReferenceType const* withLocation(ReferenceType const* _type, bool _isPointer);
 
@@ -179,7 +210,7 @@ public:
 
 	static ContractType const* contract(ContractDefinition const& _contract, bool _isSuper = false);
 
-	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &m_inaccessibleDynamic; }
+	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &instance().m_inaccessibleDynamic; }
 
 	/// @returns the type of an enum instance for given definition, there is one distinct type per enum definition.
 	static EnumType const* enumType(EnumDefinition const& _enum);
@@ -208,48 +239,48 @@ public:
 	static UserDefinedValueType const* userDefinedValueType(UserDefinedValueTypeDefinition const& _definition);
 
 private:
-	/// Global TypeProvider instance.
-	static TypeProvider& instance()
+	static TypeProvider*& shared()
 	{
-		static TypeProvider _provider;
+		static thread_local TypeProvider* _provider = nullptr;
 		return _provider;
 	}
 
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
-	static BoolType const m_boolean;
-	static NullType const m_nullType;
-	static EmptyMapType const m_emptyMapType;
-	static TvmCellType const m_tvmcell;
-	static TvmSliceType const m_tvmslice;
-	static TvmBuilderType const m_tvmbuilder;
+	BoolType const m_boolean{};
+	NullType const m_nullType{};
+	EmptyMapType const m_emptyMapType{};
+	TvmCellType const m_tvmcell{};
+	TvmSliceType const m_tvmslice{};
+	TvmBuilderType const m_tvmbuilder{};
 
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
+	InaccessibleDynamicType const m_inaccessibleDynamic{};
 
 	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-    static std::unique_ptr<Variant> m_variant;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_address;
-	static InitializerListType const m_initializerList;
-	static CallListType const m_callList;
-	static std::unique_ptr<IntegerType> const m_int257;
-	static std::array<std::unique_ptr<IntegerType>, 256> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 256> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 8> const m_magics;        ///< MagicType's except MetaType
+	std::unique_ptr<ArrayType> m_bytesStorage;
+	std::unique_ptr<ArrayType> m_bytesMemory;
+	std::unique_ptr<ArrayType> m_bytesCalldata;
+	std::unique_ptr<ArrayType> m_stringStorage;
+    std::unique_ptr<Variant> m_variant;
+	std::unique_ptr<ArrayType> m_stringMemory;
+
+	TupleType const m_emptyTuple{};
+	AddressType const m_address{};
+	InitializerListType const m_initializerList{};
+	CallListType const m_callList{};
+	std::unique_ptr<IntegerType> const m_int257;
+	std::array<std::unique_ptr<IntegerType>, 256> const m_intM;
+	std::array<std::unique_ptr<IntegerType>, 256> const m_uintM;
+	std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
+	std::array<std::unique_ptr<MagicType>, 8> const m_magics;        ///< MagicType's except MetaType
 
 	std::map<std::pair<unsigned, IntegerType::Modifier>, std::unique_ptr<VarInteger>> m_varInterger{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	std::recursive_mutex m_mutex;
 };
 
 }
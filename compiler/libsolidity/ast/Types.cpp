@@ -50,6 +50,7 @@
 #include <range/v3/view/transform.hpp>
 
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 #include <utility>
 
@@ -310,8 +311,34 @@ Type const* Type::commonType(Type const* _a, Type const* _b)
 		return nullptr;
 }
 
+vector<tuple<string, Type const*>> const& Type::stackItems() const
+{
+	lock_guard<recursive_mutex> guard(TypeProvider::mutex());
+	if (!m_stackItems)
+		m_stackItems = makeStackItems();
+	return *m_stackItems;
+}
+
+unsigned Type::sizeOnStack() const
+{
+	lock_guard<recursive_mutex> guard(TypeProvider::mutex());
+	if (!m_stackSize)
+	{
+		size_t sizeOnStack = 0;
+		for (auto const& slot: stackItems())
+			if (get<1>(slot))
+				sizeOnStack += get<1>(slot)->sizeOnStack();
+			else
+				++sizeOnStack;
+		m_stackSize = sizeOnStack;
+	}
+	return static_cast<unsigned>(*m_stackSize);
+}
+
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
+	// Types are shared by the threads of a compilation, see TypeProvider::Scope.
+	lock_guard<recursive_mutex> guard(TypeProvider::mutex());
 	if (!m_members[_currentScope])
 	{
 		solAssert(
@@ -363,11 +390,11 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 	}
 	else
 		solAssert(sourceUnit, "");
-	usingForDirectives += ASTNode::filteredNodes<UsingForDirective>(sourceUnit->nodes());
+	usingForDirectives += sourceUnit->usingForDirectives();
 
 	if (Declaration const* typeDefinition = _type.typeDefinition())
 		if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(typeDefinition->scope()))
-			for (auto usingFor: ASTNode::filteredNodes<UsingForDirective>(sourceUnit->nodes()))
+			for (auto usingFor: sourceUnit->usingForDirectives())
 				// We do not yet compare the type name because of normalization.
 				if (usingFor->global() && usingFor->typeName())
 					usingForDirectives.emplace_back(usingFor);
@@ -2182,6 +2209,7 @@ TypeResult ArrayType::interfaceType(bool) const
 	else
 		result = TypeProvider::array(baseInterfaceType, m_length);
 
+	lock_guard<recursive_mutex> guard(TypeProvider::mutex());
 	m_interfaceType = result;
 
 	return result;
@@ -2320,6 +2348,7 @@ MemberList::MemberMap ContractType::nativeMembers(ASTNode const*) const
 
 FunctionType const* ContractType::newExpressionType() const
 {
+	lock_guard<recursive_mutex> guard(TypeProvider::mutex());
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
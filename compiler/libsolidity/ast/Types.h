@@ -295,28 +295,10 @@ public:
 	/// The complete layout of a type on the stack can be obtained from its stack items recursively as follows:
 	/// - Each unnamed stack item is untyped (its type is ``nullptr``) and contributes exactly one stack slot.
 	/// - Each named stack item is typed and contributes the stack slots given by the stack items of its type.
-	std::vector<std::tuple<std::string, Type const*>> const& stackItems() const
-	{
-		if (!m_stackItems)
-			m_stackItems = makeStackItems();
-		return *m_stackItems;
-	}
+	std::vector<std::tuple<std::string, Type const*>> const& stackItems() const;
 	/// Total number of stack slots occupied by this type. This is the sum of ``sizeOnStack`` of all ``stackItems()``.
 	// TODO: consider changing the return type to be size_t
-	unsigned sizeOnStack() const
-	{
-		if (!m_stackSize)
-		{
-			size_t sizeOnStack = 0;
-			for (auto const& slot: stackItems())
-				if (std::get<1>(slot))
-					sizeOnStack += std::get<1>(slot)->sizeOnStack();
-				else
-					++sizeOnStack;
-			m_stackSize = sizeOnStack;
-		}
-		return static_cast<unsigned>(*m_stackSize);
-	}
+	unsigned sizeOnStack() const;
 	/// If it is possible to initialize such a value in memory by just writing zeros
 	/// of the size memoryHeadSize().
 	virtual bool hasSimpleZeroValueInMemory() const { return true; }
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2023 EverX. All Rights Reserved.
+ *
+ * Licensed under the  terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ *
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the  GNU General Public License for more details at: https://www.gnu.org/licenses/gpl-3.0.html
+ */
+/**
+ * Execution profile used for branch layout
+ */
+
+#include <sstream>
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "BranchProfile.hpp"
+
+using namespace solidity::frontend;
+
+std::optional<BranchProfile> BranchProfile::fromString(std::string const& _text) {
+	BranchProfile profile;
+	std::istringstream in{_text};
+	std::string line;
+	while (std::getline(in, line)) {
+		boost::trim(line);
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		size_t const space = line.find_last_of(" \t");
+		if (space == std::string::npos)
+			return {};
+		std::string location = boost::trim_copy(line.substr(0, space));
+		size_t const colon = location.rfind(':');
+		if (colon == std::string::npos || colon == 0)
+			return {};
+		std::string const lineStr = location.substr(colon + 1);
+		std::string const countStr = line.substr(space + 1);
+		// lexical_cast accepts a sign for unsigned types
+		if (lineStr.find_first_not_of("0123456789") != std::string::npos ||
+			countStr.find_first_not_of("0123456789") != std::string::npos)
+			return {};
+		try {
+			int const lineNumber = boost::lexical_cast<int>(lineStr);
+			uint64_t const count = boost::lexical_cast<uint64_t>(countStr);
+			profile.m_counts[{location.substr(0, colon), lineNumber}] += count;
+		} catch (boost::bad_lexical_cast const&) {
+			return {};
+		}
+	}
+	return profile;
+}
+
+std::optional<uint64_t> BranchProfile::count(std::string const& _file, int _line) const {
+	auto it = m_counts.find({_file, _line});
+	if (it == m_counts.end())
+		return {};
+	return it->second;
+}
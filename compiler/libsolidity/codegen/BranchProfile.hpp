@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2023 EverX. All Rights Reserved.
+ *
+ * Licensed under the  terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ *
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the  GNU General Public License for more details at: https://www.gnu.org/licenses/gpl-3.0.html
+ */
+/**
+ * Execution profile used for branch layout
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace solidity::frontend {
+
+// Execution counts of `.loc` source lines, collected from transaction traces.
+// Text format, one entry per line:
+//     <file>:<line> <count>
+// where <file> and <line> are the same as in `.loc <file>, <line>` of the generated code.
+// Empty lines and lines starting with '#' are ignored. Counts of repeated entries are summed up.
+class BranchProfile {
+public:
+	// returns nullopt if the text is malformed
+	static std::optional<BranchProfile> fromString(std::string const& _text);
+
+	std::optional<uint64_t> count(std::string const& _file, int _line) const;
+	bool empty() const { return m_counts.empty(); }
+private:
+	std::map<std::pair<std::string, int>, uint64_t> m_counts;
+};
+
+} // end solidity::frontend
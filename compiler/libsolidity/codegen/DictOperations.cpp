@@ -295,3 +295,86 @@ void DelMinOrMax::delMinOrMax() {
 	pusher.blockSwap(cntOfValuesOnStack - 1, 1); // optPair mapLValue... map
 	ec->collectLValue(lValueInfo, true, false); // value key
 }
+
+void ConstDictBuilder::add(std::string const& key, std::string const& value) {
+	solAssert(static_cast<int>(key.size()) == m_keyLength, "");
+	m_values[key] = value;
+}
+
+Pointer<PushCellOrSlice> ConstDictBuilder::build() const {
+	if (m_values.empty()) {
+		return nullptr;
+	}
+	return buildEdge(m_values.begin(), m_values.end(), 0, PushCellOrSlice::Type::PUSHREF);
+}
+
+Pointer<PushCellOrSlice> ConstDictBuilder::buildArray(Type const* baseType, std::vector<bigint> const& values) {
+	if (!isIn(baseType->category(), Type::Category::Integer, Type::Category::Bool)) {
+		return nullptr;
+	}
+	TypeInfo ti{baseType};
+	bigint const min = ti.isSigned ? -pow(bigint(2), ti.numBits - 1) : bigint(0);
+	bigint const max = ti.isSigned ? pow(bigint(2), ti.numBits - 1) : pow(bigint(2), ti.numBits);
+	ConstDictBuilder dict{TvmConst::ArrayKeyLength};
+	for (size_t i = 0; i < values.size(); ++i) {
+		if (values.at(i) < min || max <= values.at(i)) {
+			return nullptr;
+		}
+		dict.add(StrUtils::toBitString(i, TvmConst::ArrayKeyLength), StrUtils::toBitString(values.at(i), ti.numBits));
+	}
+	return dict.build();
+}
+
+// hm_edge#_ label:(HmLabel ~l n) node:(HashmapNode m X)
+// hmn_leaf#_ value:X
+// hmn_fork#_ left:^(Hashmap n X) right:^(Hashmap n X)
+Pointer<PushCellOrSlice> ConstDictBuilder::buildEdge(Iter begin, Iter end, int depth, PushCellOrSlice::Type type) const {
+	std::string const& first = begin->first;
+	std::string const& last = std::prev(end)->first;
+	// keys are sorted, so the common prefix of the range is the one of its first and last keys
+	int common = depth;
+	while (common < m_keyLength && first[common] == last[common]) {
+		++common;
+	}
+	std::string bits = label(first.substr(depth, common - depth), m_keyLength - depth);
+	std::vector<Pointer<PushCellOrSlice>> refs;
+	if (common == m_keyLength) {
+		bits += begin->second;
+	} else {
+		Iter middle = begin;
+		while (middle->first[common] == '0') {
+			++middle;
+		}
+		refs.emplace_back(buildEdge(begin, middle, common + 1, PushCellOrSlice::Type::CELL));
+		refs.emplace_back(buildEdge(middle, end, common + 1, PushCellOrSlice::Type::CELL));
+		if (refs.at(0) == nullptr || refs.at(1) == nullptr) {
+			return nullptr;
+		}
+	}
+	if (static_cast<int>(bits.size()) > TvmConst::CellBitLength) {
+		return nullptr;
+	}
+	return createNode<PushCellOrSlice>(type, "x" + StrUtils::binaryStringToSlice(bits), refs);
+}
+
+// Chooses the shortest form of the label as TVM does
+std::string ConstDictBuilder::label(std::string const& bits, int maxLength) {
+	int const len = bits.size();
+	int lenBits = 0; // bits to store a number in [0, maxLength]
+	while ((1 << lenBits) <= maxLength) {
+		++lenBits;
+	}
+	if (len == 0) {
+		return "00";
+	}
+	if (len > 1 && lenBits < 2 * len - 1 && bits.find(bits[0] == '0' ? '1' : '0') == std::string::npos) {
+		// hml_same$11 v:Bit n:(#<= m)
+		return "11" + bits.substr(0, 1) + StrUtils::toBitString(len, lenBits);
+	}
+	if (lenBits < len) {
+		// hml_long$10 n:(#<= m) s:(n * Bit)
+		return "10" + StrUtils::toBitString(len, lenBits) + bits;
+	}
+	// hml_short$0 len:(Unary ~n) s:(n * Bit)
+	return "0" + std::string(len, '1') + "0" + bits;
+}
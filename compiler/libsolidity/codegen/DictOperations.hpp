@@ -112,4 +112,24 @@ private:
 	std::string opcode;
 };
 
+// Builds a constant dictionary at compile time. The cells are the same as the ones DICTUSET makes at runtime,
+// so constant tables don't have to be computed while linking.
+class ConstDictBuilder {
+public:
+	explicit ConstDictBuilder(int keyLength) : m_keyLength{keyLength} { }
+	// key and value are bit strings
+	void add(std::string const& key, std::string const& value);
+	// returns the root cell of the dictionary or nullptr if it's empty or some leaf doesn't fit in a cell
+	Pointer<PushCellOrSlice> build() const;
+	// returns nullptr if the values don't fit in the base type or it isn't an integer or bool
+	static Pointer<PushCellOrSlice> buildArray(Type const* baseType, std::vector<bigint> const& values);
+private:
+	using Iter = std::map<std::string, std::string>::const_iterator;
+	Pointer<PushCellOrSlice> buildEdge(Iter begin, Iter end, int depth, PushCellOrSlice::Type type) const;
+	static std::string label(std::string const& bits, int maxLength);
+private:
+	int m_keyLength{};
+	std::map<std::string, std::string> m_values;
+};
+
 } // end solidity::frontend
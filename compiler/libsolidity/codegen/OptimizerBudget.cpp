@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2023 EverX. All Rights Reserved.
+ *
+ * Licensed under the  terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ *
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the  GNU General Public License for more details at: https://www.gnu.org/licenses/gpl-3.0.html
+ */
+/**
+ * Fuel and time budget of the optimizer
+ */
+
+#include "OptimizerBudget.hpp"
+
+using namespace solidity::frontend;
+
+OptimizerBudget::OptimizerBudget(OptimizerLimits const& _limits) :
+	m_limits{_limits}
+{
+	if (m_limits.timeLimitMs != 0) {
+		m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{m_limits.timeLimitMs};
+	}
+}
+
+void OptimizerBudget::startFunction(std::string const& _name) {
+	m_function = _name;
+}
+
+bool OptimizerBudget::exhausted() {
+	if (!m_timeOut && m_deadline && std::chrono::steady_clock::now() > *m_deadline) {
+		m_timeOut = true;
+	}
+	return
+		m_timeOut ||
+		(m_limits.contractFuel != 0 && m_contractFuel >= m_limits.contractFuel) ||
+		(m_limits.functionFuel != 0 && m_functionFuel[m_function] >= m_limits.functionFuel);
+}
+
+void OptimizerBudget::spend() {
+	++m_contractFuel;
+	++m_functionFuel[m_function];
+}
+
+void OptimizerBudget::refuse() {
+	m_stoppedFunctions.insert(m_function);
+}
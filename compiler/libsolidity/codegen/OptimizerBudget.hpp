@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2023 EverX. All Rights Reserved.
+ *
+ * Licensed under the  terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License.
+ *
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the  GNU General Public License for more details at: https://www.gnu.org/licenses/gpl-3.0.html
+ */
+/**
+ * Fuel and time budget of the optimizer
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace solidity::frontend {
+
+// 0 means no limit
+struct OptimizerLimits {
+	uint64_t functionFuel{};
+	uint64_t contractFuel{};
+	uint64_t timeLimitMs{};
+};
+
+// Bounds the work of the stack and peephole optimizers for one contract. Every rewrite costs one unit
+// of fuel of the current function and of the contract. Once a limit is reached the optimizers stop
+// rewriting; the code stays correct, it is just optimized less.
+class OptimizerBudget {
+public:
+	explicit OptimizerBudget(OptimizerLimits const& _limits);
+	void startFunction(std::string const& _name);
+	// returns true if no more rewrites are allowed in the current function
+	bool exhausted();
+	void spend();
+	// a rewrite of the current function was refused because the budget is exhausted
+	void refuse();
+	bool isStopped() const { return m_stoppedFunctions.count(m_function) != 0; }
+	// functions whose optimization was stopped by the budget
+	std::set<std::string> const& stoppedFunctions() const { return m_stoppedFunctions; }
+	bool isTimeOut() const { return m_timeOut; }
+private:
+	OptimizerLimits m_limits;
+	std::optional<std::chrono::steady_clock::time_point> m_deadline;
+	std::string m_function;
+	std::map<std::string, uint64_t> m_functionFuel;
+	uint64_t m_contractFuel{};
+	bool m_timeOut{};
+	std::set<std::string> m_stoppedFunctions;
+};
+
+} // end solidity::frontend
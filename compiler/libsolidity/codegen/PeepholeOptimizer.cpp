@@ -14,6 +14,12 @@
  * Peephole optimizer
  */
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
+#include <unordered_map>
+
 #include <boost/format.hpp>
 
 #include "PeepholeOptimizer.hpp"
@@ -46,6 +52,216 @@ struct Result {
 	}
 };
 
+// Commands of a block starting at the current position, .loc lines are skipped.
+// The commands are looked up on first access, so matching a short rule doesn't scan further.
+class PeepholeWindow {
+public:
+	static int constexpr MaxSize = 6;
+
+	// `_rest` holds the commands in reverse order, the current command is the last one
+	PeepholeWindow(std::vector<Pointer<TvmAstNode>> const& _rest, bool _withUnpackOpaque) :
+		m_rest{_rest},
+		m_withUnpackOpaque{_withUnpackOpaque}
+	{
+	}
+
+	// returns i-th command or nullptr if there is no such command
+	Pointer<TvmAstNode> const& operator[](int i) const {
+		solAssert(0 <= i && i < MaxSize, "");
+		int const n = static_cast<int>(m_rest.size());
+		while (m_size <= i && m_scanned < n) {
+			Pointer<TvmAstNode> const& cmd = m_rest.at(n - 1 - m_scanned);
+			++m_scanned;
+			if (!isLoc(cmd))
+				m_commands.at(m_size++) = &cmd;
+		}
+		static Pointer<TvmAstNode> const none;
+		return i < m_size ? *m_commands.at(i) : none;
+	}
+	bool withUnpackOpaque() const { return m_withUnpackOpaque; }
+
+private:
+	std::vector<Pointer<TvmAstNode>> const& m_rest;
+	bool m_withUnpackOpaque{};
+	mutable std::array<Pointer<TvmAstNode> const*, MaxSize> m_commands{};
+	mutable int m_size{};
+	mutable int m_scanned{};
+};
+
+// One command of a rule pattern: it has one of `keys` (see PeepholeMatcher::keyOf) or any key
+// if `keys` is empty, and satisfies `check` if it's set.
+struct OpPattern {
+	std::vector<std::string> keys;
+	std::function<bool(Pointer<TvmAstNode> const&)> check;
+};
+
+// If the commands at the current position match `pattern`, `rewrite` returns the replacement
+// or nullopt if the arguments of the commands don't fit.
+struct PeepholeRule {
+	std::vector<OpPattern> pattern;
+	std::function<std::optional<Result>(PeepholeWindow const&)> rewrite;
+};
+
+// Rules compiled into a prefix tree over the keys of commands. At a position only the rules
+// on the path of the actual commands are tried, in the order they are listed.
+class PeepholeMatcher {
+public:
+	explicit PeepholeMatcher(std::vector<PeepholeRule> _rules);
+	std::optional<Result> match(PeepholeWindow const& _window) const;
+	// opcode for GenOpcode, "#" + opcode for Stack and "#" + kind for other commands
+	static std::string const& keyOf(TvmAstNode const& _node);
+	static std::string const& stackKey(Stack::Opcode _opcode);
+
+	static std::string const ExceptionKey;
+	static std::string const IfElseKey;
+	static std::string const PushCellOrSliceKey;
+	static std::string const GlobKey;
+	static std::string const ReturnKey;
+	static std::string const SubProgramKey;
+	static std::string const LogCircuitKey;
+	static std::string const CodeBlockKey;
+	static std::string const WhileKey;
+	static std::string const OtherKey;
+
+private:
+	struct Node {
+		std::unordered_map<std::string, int> next;
+		int any = -1; // child for patterns that accept any command
+		std::vector<int> rules; // rules whose pattern ends here
+	};
+	int child(int _node, std::string const* _key);
+	void collect(int _node, int _depth, PeepholeWindow const& _window, std::vector<int>& _rules) const;
+
+	std::vector<PeepholeRule> m_rules;
+	std::vector<Node> m_nodes;
+};
+
+std::string const PeepholeMatcher::ExceptionKey = "#EXCEPTION";
+std::string const PeepholeMatcher::IfElseKey = "#IFELSE";
+std::string const PeepholeMatcher::PushCellOrSliceKey = "#PUSHCELLORSLICE";
+std::string const PeepholeMatcher::GlobKey = "#GLOB";
+std::string const PeepholeMatcher::ReturnKey = "#RETURN";
+std::string const PeepholeMatcher::SubProgramKey = "#SUBPROGRAM";
+std::string const PeepholeMatcher::LogCircuitKey = "#LOGCIRCUIT";
+std::string const PeepholeMatcher::CodeBlockKey = "#CODEBLOCK";
+std::string const PeepholeMatcher::WhileKey = "#WHILE";
+std::string const PeepholeMatcher::OtherKey = "#OTHER";
+
+PeepholeMatcher::PeepholeMatcher(std::vector<PeepholeRule> _rules) :
+	m_rules{std::move(_rules)}
+{
+	m_nodes.emplace_back();
+	for (int r = 0; r < static_cast<int>(m_rules.size()); ++r) {
+		std::vector<OpPattern> const& pattern = m_rules.at(r).pattern;
+		solAssert(!pattern.empty() && static_cast<int>(pattern.size()) <= PeepholeWindow::MaxSize, "");
+		std::vector<int> nodes{0};
+		for (OpPattern const& op : pattern) {
+			std::vector<int> children;
+			for (int node : nodes) {
+				if (op.keys.empty())
+					children.push_back(child(node, nullptr));
+				for (std::string const& key : op.keys)
+					children.push_back(child(node, &key));
+			}
+			nodes = std::move(children);
+		}
+		for (int node : nodes)
+			m_nodes.at(node).rules.push_back(r);
+	}
+}
+
+int PeepholeMatcher::child(int _node, std::string const* _key) {
+	Node& node = m_nodes.at(_node);
+	auto it = _key ? node.next.find(*_key) : node.next.end();
+	if (_key ? it != node.next.end() : node.any != -1)
+		return _key ? it->second : node.any;
+	int id = static_cast<int>(m_nodes.size());
+	if (_key)
+		node.next.emplace(*_key, id);
+	else
+		node.any = id;
+	m_nodes.emplace_back(); // invalidates `node`
+	return id;
+}
+
+void PeepholeMatcher::collect(int _node, int _depth, PeepholeWindow const& _window, std::vector<int>& _rules) const {
+	Node const& node = m_nodes.at(_node);
+	_rules.insert(_rules.end(), node.rules.begin(), node.rules.end());
+	if (_depth == PeepholeWindow::MaxSize || (node.next.empty() && node.any == -1))
+		return;
+	Pointer<TvmAstNode> const& cmd = _window[_depth];
+	if (!cmd)
+		return;
+	if (auto it = node.next.find(keyOf(*cmd)); it != node.next.end())
+		collect(it->second, _depth + 1, _window, _rules);
+	if (node.any != -1)
+		collect(node.any, _depth + 1, _window, _rules);
+}
+
+std::optional<Result> PeepholeMatcher::match(PeepholeWindow const& _window) const {
+	std::vector<int> candidates;
+	collect(0, 0, _window, candidates);
+	std::sort(candidates.begin(), candidates.end());
+	for (int r : candidates) {
+		PeepholeRule const& rule = m_rules.at(r);
+		bool ok = true;
+		for (int i = 0; ok && i < static_cast<int>(rule.pattern.size()); ++i) {
+			OpPattern const& op = rule.pattern.at(i);
+			ok = !op.check || op.check(_window[i]);
+		}
+		if (ok) {
+			if (std::optional<Result> res = rule.rewrite(_window))
+				return res;
+		}
+	}
+	return {};
+}
+
+std::string const& PeepholeMatcher::keyOf(TvmAstNode const& _node) {
+	if (auto gen = to<GenOpcode>(&_node))
+		return gen->opcode();
+	if (auto stack = to<Stack>(&_node))
+		return stackKey(stack->opcode());
+	if (to<TvmException>(&_node))
+		return ExceptionKey;
+	if (to<TvmIfElse>(&_node))
+		return IfElseKey;
+	if (to<PushCellOrSlice>(&_node))
+		return PushCellOrSliceKey;
+	if (to<Glob>(&_node))
+		return GlobKey;
+	if (to<TvmReturn>(&_node))
+		return ReturnKey;
+	if (to<SubProgram>(&_node))
+		return SubProgramKey;
+	if (to<LogCircuit>(&_node))
+		return LogCircuitKey;
+	if (to<CodeBlock>(&_node))
+		return CodeBlockKey;
+	if (to<While>(&_node))
+		return WhileKey;
+	return OtherKey;
+}
+
+std::string const& PeepholeMatcher::stackKey(Stack::Opcode _opcode) {
+	static std::map<Stack::Opcode, std::string> const keys{
+		{Stack::Opcode::DROP, "#DROP"},
+		{Stack::Opcode::BLKDROP2, "#BLKDROP2"},
+		{Stack::Opcode::POP_S, "#POP_S"},
+		{Stack::Opcode::BLKPUSH, "#BLKPUSH"},
+		{Stack::Opcode::PUSH2_S, "#PUSH2_S"},
+		{Stack::Opcode::PUSH3_S, "#PUSH3_S"},
+		{Stack::Opcode::PUSH_S, "#PUSH_S"},
+		{Stack::Opcode::BLKSWAP, "#BLKSWAP"},
+		{Stack::Opcode::REVERSE, "#REVERSE"},
+		{Stack::Opcode::XCHG, "#XCHG"},
+		{Stack::Opcode::TUCK, "#TUCK"},
+		{Stack::Opcode::PUXC, "#PUXC"},
+		{Stack::Opcode::XCPU, "#XCPU"},
+	};
+	return keys.at(_opcode);
+}
+
 class PrivatePeepholeOptimizer {
 public:
 	explicit PrivatePeepholeOptimizer(std::vector<Pointer<TvmAstNode>> instructions, bool _withUnpackOpaque, bool _optimizeSlice) :
@@ -54,27 +270,19 @@ public:
 		m_optimizeSlice{_optimizeSlice}
 	{
 	}
+	// every rewrite done by optimize() is charged to the budget, nullptr means unlimited
+	void setBudget(OptimizerBudget* _budget) { m_budget = _budget; }
 	vector<Pointer<TvmAstNode>> const &instructions() const { return m_instructions; }
 
+	// While optimize() runs, indexes are relative to the current command, so 0 is the current one
 	int nextCommandLine(int idx) const;
-	static int nextCommandLine(int idx, std::vector<Pointer<TvmAstNode>> instructions);
+	static int nextCommandLine(int idx, std::vector<Pointer<TvmAstNode>> const& instructions);
 	Pointer<TvmAstNode> get(int idx) const;
 	bool valid(int idx) const;
-	void remove(int idx);
-	void insert(int idx, const Pointer<TvmAstNode>& node);
 	std::optional<Result> optimizeAt(int idx1) const;
 	std::optional<Result> optimizeSlice(int idx1) const;
 	static std::optional<Result> optimizeAt1(Pointer<TvmAstNode> const& cmd1, bool m_withUnpackOpaque);
-	static std::optional<Result> optimizeAt2(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2) ;
-	static std::optional<Result> optimizeAt3(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2, Pointer<TvmAstNode> const& cmd3, bool m_withUnpackOpaque);
-	static std::optional<Result> optimizeAt4(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2, Pointer<TvmAstNode> const& cmd3,
-					   Pointer<TvmAstNode> const& cmd4);
-	static std::optional<Result> optimizeAt5(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2, Pointer<TvmAstNode> const& cmd3,
-					   Pointer<TvmAstNode> const& cmd4, Pointer<TvmAstNode> const& cmd5);
-	static std::optional<Result> optimizeAt6(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2, Pointer<TvmAstNode> const& cmd3,
-					   Pointer<TvmAstNode> const& cmd4, Pointer<TvmAstNode> const& cmd5, Pointer<TvmAstNode> const& cmd6);
 	std::optional<Result> optimizeAtInf(int idx1) const;
-	static bool hasRetOrJmp(TvmAstNode const* _node);
 
 	void updateLinesAndIndex(int idx1, const std::optional<Result>& res);
 	std::optional<Result> unsquash(bool _withUnpackOpaque, int idx1) const;
@@ -101,16 +309,40 @@ public:
 	static int getAddNum(Pointer<TvmAstNode> const& node);
 	static bool isStack(Pointer<TvmAstNode> const& node, Stack::Opcode op);
 private:
+	using OpCheck = std::function<bool(Pointer<TvmAstNode> const&)>;
+	static OpPattern genOp(std::vector<std::string> _opcodes, OpCheck _check = {});
+	static OpPattern stackOp(std::vector<Stack::Opcode> const& _opcodes, OpCheck _check = {});
+	static OpPattern kindOp(std::string const& _key, OpCheck _check = {});
+	static OpPattern anyOp(OpCheck _check = {});
+	static PeepholeMatcher const& singleCommandRules();
+	static PeepholeMatcher const& commandSequenceRules();
+
+	void stepForward();
+	void stepBack();
+	void skipLocs();
+
 	std::vector<Pointer<TvmAstNode>> m_instructions{};
+	// optimize() splits m_instructions at the current command: m_done holds the commands before it,
+	// m_rest holds it and the following ones in reverse order, so rewrites at the current command
+	// touch only the ends of both vectors
+	std::vector<Pointer<TvmAstNode>> m_done{};
+	std::vector<Pointer<TvmAstNode>> m_rest{};
 	bool m_withUnpackOpaque{};
 	bool m_optimizeSlice{};
+	OptimizerBudget* m_budget{};
 };
 
 int PrivatePeepholeOptimizer::nextCommandLine(int idx) const {
-	return nextCommandLine(idx + 1, m_instructions);
+	if (idx < 0)
+		return -1;
+	for (++idx; valid(idx); ++idx) {
+		if (!isLoc(get(idx)))
+			return idx;
+	}
+	return -1;
 }
 
-int PrivatePeepholeOptimizer::nextCommandLine(int idx, std::vector<Pointer<TvmAstNode>> instructions) {
+int PrivatePeepholeOptimizer::nextCommandLine(int idx, std::vector<Pointer<TvmAstNode>> const& instructions) {
 	solAssert(0 <= idx, "");
 	int n = instructions.size();
 	while (idx < n) {
@@ -124,19 +356,26 @@ int PrivatePeepholeOptimizer::nextCommandLine(int idx, std::vector<Pointer<TvmAs
 }
 
 Pointer<TvmAstNode> PrivatePeepholeOptimizer::get(int idx) const {
-	return valid(idx) ? m_instructions.at(idx) : nullptr;
+	return valid(idx) ? m_rest.at(m_rest.size() - 1 - idx) : nullptr;
 }
 
 bool PrivatePeepholeOptimizer::valid(int idx) const {
-	return idx >= 0 && size_t(idx) < m_instructions.size();
+	return idx >= 0 && size_t(idx) < m_rest.size();
+}
+
+void PrivatePeepholeOptimizer::stepForward() {
+	m_done.push_back(std::move(m_rest.back()));
+	m_rest.pop_back();
 }
 
-void PrivatePeepholeOptimizer::remove(int idx) {
-	m_instructions.erase(m_instructions.begin() + idx);
+void PrivatePeepholeOptimizer::stepBack() {
+	m_rest.push_back(std::move(m_done.back()));
+	m_done.pop_back();
 }
 
-void PrivatePeepholeOptimizer::insert(int idx, const Pointer<TvmAstNode>& node) {
-	m_instructions.insert(m_instructions.begin() + idx, node);
+void PrivatePeepholeOptimizer::skipLocs() {
+	while (!m_rest.empty() && isLoc(m_rest.back()))
+		stepForward();
 }
 
 std::optional<Result> PrivatePeepholeOptimizer::optimizeSlice(int idx1) const {
@@ -158,1349 +397,1344 @@ std::optional<Result> PrivatePeepholeOptimizer::optimizeSlice(int idx1) const {
 		// PUSHINT N
 		// STUR len
 		bigint num = StrUtils::toBigint(binStr);
-		int numLength = StrUtils::toBinString(num).length();
-		if (numLength <= 255 && len > numLength) {
-			return Result{2, gen("PUSHINT " + toString(num)), gen("STUR " + toString(len))};
-		}
-	}
-
-	return {};
-}
-
-std::optional<Result> PrivatePeepholeOptimizer::optimizeAt(const int idx1) const {
-	if (m_optimizeSlice) {
-		return optimizeSlice(idx1);
-	}
-
-	int idx2 = nextCommandLine(idx1);
-	int idx3 = nextCommandLine(idx2);
-	int idx4 = nextCommandLine(idx3);
-	int idx5 = nextCommandLine(idx4);
-	int idx6 = nextCommandLine(idx5);
-
-	Pointer<TvmAstNode> const &cmd1 = get(idx1);
-	Pointer<TvmAstNode> const &cmd2 = get(idx2);
-	Pointer<TvmAstNode> const &cmd3 = get(idx3);
-	Pointer<TvmAstNode> const &cmd4 = get(idx4);
-	Pointer<TvmAstNode> const &cmd5 = get(idx5);
-	Pointer<TvmAstNode> const &cmd6 = get(idx6);
-
-	std::optional<Result> res;
-
-	res = optimizeAt1(cmd1, m_withUnpackOpaque);
-	if (res) return res;
-
-	res = optimizeAtInf(idx1);
-	if (res) return res;
-
-	if (!cmd2) return {};
-	res = optimizeAt2(cmd1, cmd2);
-	if (res) return res;
-
-	if (!cmd3) return {};
-	res = optimizeAt3(cmd1, cmd2, cmd3, m_withUnpackOpaque);
-	if (res) return res;
-
-	if (!cmd4) return {};
-	res = optimizeAt4(cmd1, cmd2, cmd3, cmd4);
-	if (res) return res;
-
-	if (!cmd5) return {};
-	res = optimizeAt5(cmd1, cmd2, cmd3, cmd4, cmd5);
-	if (res) return res;
-
-	if (!cmd6) return {};
-	res = optimizeAt6(cmd1, cmd2, cmd3, cmd4, cmd5, cmd6);
-	if (res) return res;
-
-	return {};
-}
-
-std::optional<Result> PrivatePeepholeOptimizer::optimizeAt1(Pointer<TvmAstNode> const& cmd1, bool m_withUnpackOpaque) {
-	auto cmd1CodeBlock = to<CodeBlock>(cmd1.get());
-	auto cmd1GenOpcode = to<GenOpcode>(cmd1.get());
-	auto cmd1IfElse = to<TvmIfElse>(cmd1.get());
-	auto cmd1Sub = to<SubProgram>(cmd1.get());
-
-	if (cmd1GenOpcode && isIn(cmd1GenOpcode->fullOpcode(), "ADDCONST 0", "MULCONST 1")) {
-		return Result{1};
-	}
-	if (cmd1GenOpcode && cmd1GenOpcode->fullOpcode() == "ADDCONST 1") {
-		return Result{1, gen("INC")};
-	}
-	if (cmd1GenOpcode && cmd1GenOpcode->fullOpcode() == "ADDCONST -1") {
-		return Result{1, gen("DEC")};
-	}
-	if (cmd1GenOpcode && cmd1GenOpcode->fullOpcode() == "MULCONST -1") {
-		return Result{1, gen("NEGATE")};
-	}
-	// PUSHCONT {} IF/IFNOT => DROP
-	if (
-		cmd1IfElse && qtyWithoutLoc(cmd1IfElse->trueBody()->instructions()) == 0 &&
-		cmd1IfElse->falseBody() == nullptr && !cmd1IfElse->withJmp()
-	) {
-		return Result{1, makeDROP()};
-	}
-	// PUSHCONT {} IFJMP => IFRET
-	// PUSHCONT {} IFNOTJMP => IFNOTRET
-	if (cmd1IfElse && qtyWithoutLoc(cmd1IfElse->trueBody()->instructions()) == 0 && cmd1IfElse->falseBody() == nullptr && cmd1IfElse->withJmp()) {
-		if (cmd1IfElse->withNot())
-			return Result{1, makeIFNOTRET()};
-		return Result{1, makeIFRET()};
-	}
-	// PUSHCONT { THROW N } IF/IFJMP => THROWIF
-	// PUSHCONT { THROW N } IFNOT/IFNOTJMP => THROWIFNOT
-	if (cmd1IfElse && cmd1IfElse->falseBody() == nullptr) {
-		std::vector<Pointer<TvmAstNode>> const& inst = cmd1IfElse->trueBody()->instructions();
-		if (qtyWithoutLoc(inst) == 1) {
-			Pointer<TvmAstNode> pos;
-			for (const auto& x : inst) if (!to<Loc>(x.get())) pos = x;
-			auto _throw = to<TvmException>(pos.get());
-			if (_throw && _throw->opcode() == "THROW") {
-				if (cmd1IfElse->withNot())
-					return Result{1, makeTHROW("THROWIFNOT " + _throw->arg())};
-				return Result{1, makeTHROW("THROWIF " + _throw->arg())};
-			}
-		}
-	}
-
-	// PUSH[REF]CONT { RETALT } IF[NOT][JMP] => IFRETALT
-	if (cmd1IfElse && cmd1IfElse->falseBody() == nullptr) {
-		std::vector<Pointer<TvmAstNode>> const& inst = cmd1IfElse->trueBody()->instructions();
-		if (qtyWithoutLoc(inst) == 1) {
-			Pointer<TvmAstNode> pos;
-			for (const auto& x : inst) if (!to<Loc>(x.get())) pos = x;
-			auto ret = to<TvmReturn>(pos.get());
-			if (ret && !ret->withIf() && ret->withAlt()) {
-				if (cmd1IfElse->withNot())
-					return Result{1, makeIFNOTRETALT()};
-				return Result{1, makeIFRETALT()};
-			}
-		}
-	}
-
-	// PUSH[REF]CONT { RETALT } JMP/CALLX => RETALT
-	if (cmd1Sub) {
-		std::vector<Pointer<TvmAstNode>> const& inst = cmd1Sub->block()->instructions();
-		if (qtyWithoutLoc(inst) == 1) {
-			Pointer<TvmAstNode> pos;
-			for (const auto& x : inst) if (!to<Loc>(x.get())) pos = x;
-			auto ret = to<TvmReturn>(pos.get());
-			if (ret && !ret->withIf() && ret->withAlt()) {
-				return Result{1, makeRETALT()};
-			}
-		}
-	}
-
-	// PUSHCONT {
-	//  LDU 256
-	//	ENDS
-	// }
-	// PUSHCONT {
-	//	LDU 256
-	//	ENDS
-	// }
-	// IFELSE
-	// =>
-	// DROP
-	// PUSHCONT {
-	//	LDU 256
-	//	ENDS
-	// }
-	// CALLX
-	if (cmd1IfElse && cmd1IfElse->falseBody() != nullptr) {
-		std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
-		std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
-		if (t.size() == f.size()) {
-			bool eq = true;
-			int n = f.size();
-			for (int i = 0; i < n; ++i) {
-				eq &= *t.at(i) == *f.at(i);
-			}
-			if (eq) {
-				auto subProg = createNode<SubProgram>(0, 0, false, cmd1IfElse->trueBody(), false);
-				return Result{1, makeDROP(), subProg};
-			}
-		}
-	}
-
-	// PUSHCONT {
-	//   ...
-	//   Z
-	// }
-	// PUSHCONT {
-	//   ...
-	//   Z
-	// }
-	// IFELSE
-	// =>
-	// PUSHCONT {
-	//   ...
-	// }
-	// PUSHCONT {
-	//   ...
-	// }
-	// IFELSE
-	// Z
-	if (m_withUnpackOpaque && cmd1IfElse && cmd1IfElse->falseBody() != nullptr && cmd1IfElse->ret() == 0) {
-		std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
-		std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
-		if (!t.empty() &&
-			!f.empty() &&
-			*t.back() == *f.back() &&
-			!cmd1IfElse->withJmp() &&
-			cmd1IfElse->trueBody()->type() == CodeBlock::Type::PUSHCONT &&
-			cmd1IfElse->falseBody()->type() == CodeBlock::Type::PUSHCONT &&
-			!hasRetOrJmp(cmd1IfElse->trueBody().get()) &&
-			!hasRetOrJmp(cmd1IfElse->falseBody().get())
-		) {
-			auto tt = createNode<CodeBlock>(CodeBlock::Type::PUSHCONT, std::vector<Pointer<TvmAstNode>>(t.begin(), t.end() - 1));
-			auto ff = createNode<CodeBlock>(CodeBlock::Type::PUSHCONT, std::vector<Pointer<TvmAstNode>>(f.begin(), f.end() - 1));
-			auto ifElse2 = createNode<TvmIfElse>(cmd1IfElse->withNot(), false, tt, ff, 0);
-			return Result{1, ifElse2, t.back()};
-		}
-	}
-
-	// PUSHCONT {
-	//   ...
-	// }
-	// PUSHCONT {
-	// }
-	// IFELSE
-	// =>
-	// PUSHCONT {
-	//   ...
-	// }
-	// IF
-	if (cmd1IfElse && cmd1IfElse->falseBody() != nullptr) {
-		std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
-		if (qtyWithoutLoc(f) == 0 &&
-			!cmd1IfElse->withJmp()
-		) {
-			auto ifElse2 = createNode<TvmIfElse>(cmd1IfElse->withNot(), false, cmd1IfElse->trueBody(), nullptr, 0);
-			return Result{1, ifElse2};
-		}
-	}
-
-	// PUSHCONT {
-	// }
-	// PUSHCONT {
-	//    ...
-	// }
-	// IFELSE
-	// =>
-	// PUSHCONT {
-	//   ...
-	// }
-	// IFNOT
-	if (cmd1IfElse && cmd1IfElse->falseBody() != nullptr) {
-		std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
-		if (qtyWithoutLoc(t) == 0 &&
-			!cmd1IfElse->withJmp()
-		) {
-			auto ifElse2 = createNode<TvmIfElse>(!cmd1IfElse->withNot(), false, cmd1IfElse->falseBody(), nullptr, 0);
-			return Result{1, ifElse2};
-		}
-	}
-
-	// PUSHCONT { genA }
-	// PUSHCONT { genB }
-	// IFELSE
-	// =>
-	// genA
-	// genB
-	// CONDSEL
-	if (cmd1IfElse && cmd1IfElse->falseBody() != nullptr) {
-		std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
-		std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
-		if (qtyWithoutLoc(t) == 1 && qtyWithoutLoc(f) == 1) {
-			int ti = nextCommandLine(0, t);
-			int fi = nextCommandLine(0, f);
-			Pointer<TvmAstNode> a = t.at(ti);
-			Pointer<TvmAstNode> b = f.at(fi);
-			if (isPureGen01(*a) &&
-				isPureGen01(*b) &&
-				std::dynamic_pointer_cast<GenOpcode>(a) &&
-				std::dynamic_pointer_cast<GenOpcode>(b)
-			) {
-				return Result{1, a, b, gen("CONDSEL")};
-			}
-		}
-	}
-
-	// PUSHCONT { TRUE }
-	// PUSHCONT { ... }
-	// WHILE
-	// =>
-	// PUSHCONT { ... }
-	// AGAIN
-	if (auto _while = to<While>(cmd1.get())) {
-		std::vector<Pointer<TvmAstNode>> const& instr = _while->condition()->instructions();
-		if (instr.size() == 1 && is(instr.at(0), "TRUE") && !_while->isInfinite()) {
-			return Result{1, createNode<While>(true, _while->withBreakOrReturn(), _while->condition(), _while->body())};
-		}
-	}
-
-	// PUSHCONT { here }
-	// CALLX
-	// =>
-	// here
-	if (cmd1Sub && !cmd1Sub->isJmp() && cmd1Sub->block()->type() == CodeBlock::Type::PUSHCONT) {
-		bool ok = true;
-		for (Pointer<TvmAstNode> const& cmd : cmd1Sub->block()->instructions()) {
-			if (hasRetOrJmp(cmd.get())) {
-				ok = false;
-			}
-		}
-		if (ok) {
-			return Result{1, cmd1Sub->block()->instructions()};
-		}
-	}
-
-	// PUSHCONT {
-	//    CALLREF {
-	//       code
-	//    }
-	// }
-	// =>
-	// PUSHREF {
-	//    code
-	// }
-	if (cmd1CodeBlock && cmd1CodeBlock->type() == CodeBlock::Type::PUSHCONT) {
-		std::vector<Pointer<TvmAstNode>> const&  opcodes = cmd1CodeBlock->instructions();
-		if (qtyWithoutLoc(opcodes) == 1) {
-			int index = nextCommandLine(0, opcodes);
-			TvmAstNode const* opcode = opcodes.at(index).get();
-			if (auto sub = to<SubProgram>(opcode)) {
-				return Result{1, createNode<CodeBlock>(sub->block()->type(), sub->block()->instructions())};
-			}
-		}
-	}
-
-	auto f = [](bool isZero, bool isSwap, std::vector<Pointer<TvmAstNode>> const& instructions) {
-		if (instructions.size() != (isSwap ? 2 : 1)) {
-			return false;
-		}
-		return *instructions.at(0) == *gen(isZero ? "PUSHINT 0" : "NULL") &&
-			   (!isSwap || *instructions.at(1) == *makeXCH_S(1));
-	};
-
-	// PUSHCONT {
-	//    PUSHINT 0 / NULL
-	//    [SWAP]
-	// }
-	// IF[ELSE][NOT][JMP]
-	// =>
-	// ZERO/NULL SWAP/ROTR IF [NOT]
-	// PUSHCONT { ... }
-	// IF[ELSE][NOT][JMP]
-	if (m_withUnpackOpaque && cmd1IfElse) {
-		for (bool isZero : {true, false}) {
-			if (isZero && *GlobalParams::g_tvmVersion == langutil::TVMVersion::ton()){
-				// ignore ZERO SWAP/ROTR IF [NOT]
-				continue;
-			}
-			for (bool isSwap : {true, false}) {
-				for (bool trueBranch: {true, false}) {
-					Pointer<CodeBlock> curBranch = trueBranch ? cmd1IfElse->trueBody() : cmd1IfElse->falseBody();
-					if (!curBranch) {
-						continue;
-					}
-					if (f(isZero, isSwap, curBranch->instructions())) {
-						Pointer<AsymGen> align = getZeroOrNullAlignment(isZero, !isSwap,
-																		!trueBranch || cmd1IfElse->withNot());
-						solAssert(trueBranch ? true : !cmd1IfElse->withNot(), "");
-						auto emptyBlock = createNode<CodeBlock>(curBranch->type());
-						return Result{1,
-									  align,
-									  createNode<TvmIfElse>(cmd1IfElse->withNot(), cmd1IfElse->withJmp(),
-															trueBranch ? emptyBlock : cmd1IfElse->trueBody(),
-															trueBranch ? cmd1IfElse->falseBody() : emptyBlock,
-															cmd1IfElse->ret())
-						};
-					}
-				}
-			}
-		}
-	}
-
-	return {};
-}
-
-std::optional<Result> PrivatePeepholeOptimizer::optimizeAt2(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2) {
-	auto cmd1GenOp = to<GenOpcode>(cmd1.get());
-	auto cmd1Glob = to<Glob>(cmd1.get());
-
-	auto cmd2Exc = to<TvmException>(cmd2.get());
-	auto cmd2GenOpcode = to<GenOpcode>(cmd2.get());
-	auto cmd2Glob = to<Glob>(cmd2.get());
-	auto cmd2IfElse = to<TvmIfElse>(cmd2.get());
-	auto cmd1Ret = to<TvmReturn>(cmd1.get());
-
-	auto _isBLKDROP1 = isBLKDROP2(cmd1);
-	auto _isBLKDROP2 = isBLKDROP2(cmd2);
-	auto isBLKPUSH1 = isBLKPUSH(cmd1);
-	auto isPUSH1 = isPUSH(cmd1);
-
-	std::map<bigint, int> power2;
-	for (int p2 = 2, p = 1; p2 <= 256; p2 *= 2, ++p) {
-		power2[p2] = p;
-	}
-
-	if (isSWAP(cmd1)) {
-		if (is(cmd2, "STU")) return Result{2, gen("STUR " + arg(cmd2))};
-		if (is(cmd2, "STSLICE")) return Result{2, gen("STSLICER")};
-		if (is(cmd2, "SUB")) return Result{2, gen("SUBR")};
-		if (is(cmd2, "SUBR")) return Result{2, gen("SUB")};
-		if (isCommutative(cmd2)) return Result{1};
-		if (cmd2GenOpcode &&
-			boost::starts_with(cmd2GenOpcode->opcode(), "ST") &&
-			boost::ends_with(cmd2GenOpcode->opcode(), "R") &&
-			cmd2GenOpcode->take() == 2 &&
-			cmd2GenOpcode->ret() == 1
-		) {
-			auto opcode = cmd2GenOpcode->opcode();
-			opcode = opcode.substr(0, opcode.size() - 1);
-			return Result{2, gen(opcode + " " + arg(cmd2))};
-		}
-	}
-	if (isPUSHINT(cmd1)) {
-		if (arg(cmd1) == "1") {
-			if (is(cmd2, "ADD")) return Result{2, gen("INC")};
-			if (is(cmd2, "SUB")) return Result{2, gen("DEC")};
-		}
-		bigint value = pushintValue(cmd1);
-		if (-128 <= value && value <= 127) {
-			if (is(cmd2, "ADD")) return Result{2, gen("ADDCONST " + toString(value))};
-			if (is(cmd2, "MUL")) return Result{2, gen("MULCONST " + toString(value))};
-		}
-		if (-128 <= -value && -value <= 127) {
-			if (is(cmd2, "SUB")) return Result{2, gen("ADDCONST " + toString(-value))};
-		}
-	}
-	if ((cmd1Ret && !cmd1Ret->withIf()) || isExc(cmd1, "THROWANY", "THROW")) {
-		// delete commands after non return opcode
-		return Result{2, cmd1};
-	}
-	if (isPUSH1 && *isPUSH1 == 0 && isSWAP(cmd2)) {
-		return Result{2, cmd1};
-	}
-	// POP Sn
-	// DROP n-1
-	// =>
-	// BLKDROP2 n, 1
-	if (isPOP(cmd1) && isDrop(cmd2) && isPOP(cmd1).value() == isDrop(cmd2).value() + 1) {
-		int n = isPOP(cmd1).value();
-		if (1 <= n && n <= 15) {
-			return Result{2, makeBLKDROP2(n, 1)};
-		}
-	}
-	// SWAP
-	// POP S2
-	//
-	// BLKDROP2 1, 2
-	if (isSWAP(cmd1) && isPOP(cmd2) && isPOP(cmd2).value() == 2) {
-		return Result{2, makeBLKDROP2(1, 2)};
-	}
-	if ((isPUSH(cmd1) || isPureGen01(*cmd1)) && isDrop(cmd2)) {
-		int qty = isDrop(cmd2).value();
-		if (qty == 1) {
-			return Result{2};
-		} else {
-			return Result{2, makeDROP(qty - 1)};
-		}
-	}
-
-	// BLKPUSH N, index / DROP
-	// BLKDROP N
-	if (isBLKPUSH1 && isDrop(cmd2)) {
-		auto [qty, index] = isBLKPUSH1.value();
-		int diff = qty - isDrop(cmd2).value();
-		if (diff == 0)
-			return Result{2};
-		if (diff < 0)
-			return Result{2, makeDROP(-diff)};
-		else
-			return Result{2, makeBLKPUSH(diff, index)};
-	}
-
-	// PUSH S[n-1]
-	// BLKDROP2 N, 1 / NIP
-	// =>
-	// DROP N-1
-	if (isPUSH1 && _isBLKDROP2) {
-		int index = *isPUSH1;
-		auto [drop, rest] = _isBLKDROP2.value();
-
-		if (drop == index + 1 && rest == 1) {
-			if (drop == 1) {
-				return Result{2};
-			} else {
-				return Result{2, makeDROP(drop - 1)};
-			}
-		}
-	}
-	// s01
-	// BLKDROP2 N, M
-	// =>
-	// BLKDROP2 N, M-1
-	// s01
-	if (isPureGen01(*cmd1) && _isBLKDROP2) {
-		auto [down, up] = _isBLKDROP2.value();
-		return Result{2, makeBLKDROP2(down, up - 1), cmd1};
-	}
-	// BLKPUSH
-	// BLKDROP2
-	// =>
-	// ???
-	if (isBLKPUSH1 && _isBLKDROP2) {
-		auto [qty, index] = isBLKPUSH1.value();
-		auto [drop, rest] = _isBLKDROP2.value();
-
-		// BLKPUSH  qty, qty-1
-		// BLKDROP2 qty+X, qty
-		// =>
-		// BLKDROP2 X, qty
-		if (qty == index + 1 && rest == qty) {
-			if (drop == qty) {
-				return Result{2};
-			} else if (drop > qty) {
-				return Result{2, makeBLKDROP2(drop - qty, qty)};
-			}
-		}
-
-		// BLKPUSH   qty, index
-		// BLKDROP2 drop, qty
-		// =>
-		// DROP X, qty
-		if (qty == rest) {
-			int lastIndex = index - qty + 1; // include
-			if (lastIndex >= 0 && lastIndex + qty == drop) {
-				// a b c d e f X Y |
-				// X Y a b c d e f X Y | BLKPUSH
-				// X Y | BLKDROP2
-				int newDrop = lastIndex;
-				return Result{2, makeDROP(newDrop)};
-			}
-		}
-	}
-	// DUP
-	// BLKDROP2 n, 1
-	// =>
-	// BLKDROP2 n-1, 1
-	// Same as prev
-	if (isPUSH1 && *isPUSH1 == 0 &&
-		_isBLKDROP2 && _isBLKDROP2.value().second == 1
-	) {
-		int n = _isBLKDROP2.value().first;
-		if (n == 1) {
-			return Result{2};
-		} else {
-			return Result{2, makeBLKDROP2(n - 1, 1)};
-		}
-	}
-
-	// NIP
-	// DROP n
-	// =>
-	// DROP n+1
-	if (isNIP(cmd1) && isDrop(cmd2)) {
-		return Result{2, makeDROP(isDrop(cmd2).value() + 1)};
-	}
-	// NOT THROWIFNOT/THROWIF N => THROWIF/THROWIFNOT N
-	// NOT PUSHCONT {} IF/IFNOT => PUSHCONT {} IFNOT/IF
-	if (is(cmd1, "NOT")) {
-		if (isExc(cmd2, "THROWIF"))
-			return Result{2, makeTHROW("THROWIFNOT " + cmd2Exc->arg())};
-		if (isExc(cmd2, "THROWIFNOT"))
-			return Result{2, makeTHROW("THROWIF " + cmd2Exc->arg())};
-		if (cmd2IfElse)
-			return Result{2, flipIfElse(*cmd2IfElse)};
-	}
-	// EQINT 0 THROWIFNOT/THROWIF N => THROWIF/THROWIFNOT N
-	// EQINT 0 PUSHCONT {} IF/IFNOT => PUSHCONT {} IFNOT/IF
-	if (is(cmd1, "EQINT") && cmd1GenOp->arg() == "0") {
-		if (isExc(cmd2, "THROWIF"))
-			return Result{2, makeTHROW("THROWIFNOT " + cmd2Exc->arg())};
-		if (isExc(cmd2, "THROWIFNOT"))
-			return Result{2, makeTHROW("THROWIF " + cmd2Exc->arg())};
-		if (cmd2IfElse)
-			return Result{2, flipIfElse(*cmd2IfElse)};
-	}
-	// NEQINT 0, THROWIF/THROWIFNOT N => THROWIF/THROWIFNOT N
-	// NEQINT 0, PUSHCONT {} IF => PUSHCONT {} IF
-	if (is(cmd1, "NEQINT") && cmd1GenOp->arg() == "0") {
-		if (isExc(cmd2, "THROWIF"))
-			return Result{2, makeTHROW("THROWIF " + cmd2Exc->arg())};
-		if (isExc(cmd2, "THROWIFNOT"))
-			return Result{2, makeTHROW("THROWIFNOT " + cmd2Exc->arg())};
-		if (cmd2IfElse)
-			return Result{2, cmd2};
-	}
-
-	// TRUE
-	// PUSHCONT {} / PUSHREF {}
-	// ...
-	// IF / IFJMP / IFELSE / IFELSE_WITH_JMP
-	if (is(cmd1, "TRUE") && cmd2IfElse && !cmd2IfElse->withNot()) {
-		auto subProg = createNode<SubProgram>(0, 0, cmd2IfElse->withJmp(), cmd2IfElse->trueBody(), false);
-		return Result{2, subProg};
-	}
-
-	// BLKSWAP  down, up
-	// BLKDROP2 drop, rest where drop==up and rest==down
-	// ...
-	// DROP up
-	if (isBLKSWAP(cmd1) && isBLKDROP2(cmd2)) {
-		auto [down, up] = isBLKSWAP(cmd1).value();
-		auto [drop, rest] = isBLKDROP2(cmd2).value();
-		if (drop==up && rest==down)
-			return Result{2, makeDROP(up)};
-	}
-
-	// BLKDROP2 drop, rest
-	// BLKDROP rest + some
-	// ...
-	// BLKDROP drop + rest + some
-	if (isBLKDROP2(cmd1) && isDrop(cmd2)) {
-		auto [drop, rest] = isBLKDROP2(cmd1).value();
-		int n = isDrop(cmd2).value();
-		int some = n - rest;
-		if (some >= 0)
-			return Result{2, makeDROP(drop + rest + some)};
-	}
-
-	// BLKSWAP down, up
-	// DROP down
-	// =>
-	// BLKDROP down, up
-	if (isBLKSWAP(cmd1) && isDrop(cmd2)) {
-		auto [down, up] = isBLKSWAP(cmd1).value();
-		int n = isDrop(cmd2).value();
-		if (n == down)
-			return Result{2, makeBLKDROP2(down, up)};
-	}
-
-	if (isBLKSWAP(cmd1) && isBLKSWAP(cmd2)) {
-		auto [down1, top1] = isBLKSWAP(cmd1).value();
-		auto [down2, top2] = isBLKSWAP(cmd2).value();
-		if (down1 + top1 == down2 + top2) {
-			// BLKSWAP down1, top1 where down1 + top1 == n
-			// BLKSWAP     1, n-1
-			// ...
-			// BLKSWAP down1+1, top1-1
-			if (down2 == 1) {
-				if (top1 == 1) {
-					return Result{2};
-				} else {
-					return Result{2, makeBLKSWAP(down1 + 1, top1 - 1)};
-				}
-			}
-			// BLKSWAP down1, top1  where down1 + top1 == n
-			// BLKSWAP n-1,    1
-			// ...
-			// BLKSWAP down1-1, top1+1
-			if (top2 == 1) {
-				if (down1 == 1) {
-					return Result{2};
-				} else {
-					return Result{2, makeBLKSWAP(down1 - 1, top1 + 1)};
-				}
-			}
-		}
-	}
-	if (is(cmd1, "TUPLE") &&
-		is(cmd2, "UNTUPLE") &&
-		fetchInt(cmd1) == fetchInt(cmd2))
-	{
-		return Result{2};
-	}
-	if (is(cmd1, "UNTUPLE") &&
-		is(cmd2, "TUPLE") &&
-		fetchInt(cmd1) == fetchInt(cmd2))
-	{
-		return Result{2};
-	}
-	if (cmd1Glob && cmd1Glob->opcode() == Glob::Opcode::SetOrSetVar &&
-		cmd2Glob && cmd2Glob->opcode() == Glob::Opcode::GetOrGetVar &&
-		cmd1Glob->index() == cmd2Glob->index()
-	) {
-		return Result{2, makePUSH(0), makeSetGlob(cmd1Glob->index())};
-	}
-	if (isConstAdd(cmd1) && isConstAdd(cmd2)) {
-		int final_add = getAddNum(cmd1) + getAddNum(cmd2);
-		if (-128 <= final_add && final_add <= 127)
-			return Result{2, gen("ADDCONST " + std::to_string(final_add))};
-	}
-	if ((is(cmd1, "INDEX_NOEXCEP") || is(cmd1, "INDEX_EXCEP")) && 0 <= strToInt(arg(cmd1)) && strToInt(arg(cmd1)) <= 3 &&
-		(is(cmd2, "INDEX_NOEXCEP") || is(cmd2, "INDEX_EXCEP")) && 0 <= strToInt(arg(cmd2)) && strToInt(arg(cmd2)) <= 3) {
-		return Result{2, gen("INDEX2 " + arg(cmd1) + ", " + arg(cmd2))};
-	}
-	if (is(cmd1, "INDEX2") &&
-		(is(cmd2, "INDEX_NOEXCEP") || is(cmd2, "INDEX_EXCEP")) && 0 <= strToInt(arg(cmd2)) && strToInt(arg(cmd2)) <= 3
-	) {
-		auto [i, j] = getIndexes(arg(cmd1));
-		if (0 <= i && i <= 3 &&
-			0 <= j && j <= 3) {
-			return Result{2, gen("INDEX3 " + toString(i) + ", " + toString(j) + ", " + arg(cmd2))};
-		}
-	}
-	if (
-		isPUSHINT(cmd1) && 1 <= pushintValue(cmd1) && pushintValue(cmd1) <= 256 &&
-		(is(cmd2, "RSHIFT") || is(cmd2, "LSHIFT")) && arg(cmd2).empty()
-	) {
-		return Result{2, gen(cmd2GenOpcode->opcode() + " " + arg(cmd1))};
-	}
-	if (isPUSHINT(cmd1) &&
-		(is(cmd2, "DIV") || is(cmd2, "MUL"))) {
-		bigint val = pushintValue(cmd1);
-		if (power2.count(val)) {
-			const std::string& newOp = is(cmd2, "DIV") ? "RSHIFT" : "LSHIFT";
-			return Result{2, gen(newOp + " " + toString(power2.at(val)))};
-		}
-	}
-	if (isPUSHINT(cmd1) &&
-		is(cmd2, "MOD")) {
-		bigint val = pushintValue(cmd1);
-		if (power2.count(val)) {
-			return Result{2, gen("MODPOW2 " + toString(power2.at(val)))};
-		}
-	}
-	if (isPUSHINT(cmd1)) {
-		bigint val = pushintValue(cmd1);
-		if (-128 <= val && val < 128) {
-			if (is(cmd2, "NEQ"))
-				return Result{2, gen("NEQINT " + toString(val))};
-			if (is(cmd2, "EQUAL"))
-				return Result{2, gen("EQINT " + toString(val))};
-			if (is(cmd2, "GREATER"))
-				return Result{2, gen("GTINT " + toString(val))};
-			if (is(cmd2, "LESS"))
-				return Result{2, gen("LESSINT " + toString(val))};
-		}
-		if (-128 <= val - 1 && val - 1 < 128 && is(cmd2, "GEQ"))
-			return Result{2, gen("GTINT " + toString(val - 1))};
-		if (-128 <= val + 1 && val + 1 < 128 && is(cmd2, "LEQ"))
-			return Result{2, gen("LESSINT " + toString(val + 1))};
-	}
-	if (_isBLKDROP1 && _isBLKDROP2) {
-		auto [drop1, rest1] = _isBLKDROP1.value();
-		auto [drop2, rest2] = _isBLKDROP2.value();
-		// BLKDROP2 drop0, rest
-		// BLKDROP2 drop1, rest
-		// =>
-		// BLKDROP2 drop0+drop1, rest
-		if (rest1 == rest2 && drop1 + drop2 <= 15) {
-			return Result{2, makeBLKDROP2(drop1 + drop2, rest1)};
-		}
-		// BLKDROP2 drop1, rest1
-		// BLKDROP2 drop2, rest2
-		// =>
-		// BLKDROP2 drop1+drop2, rest1
-		if (rest1 == drop2 + rest2 && rest1 >= rest2) {
-			return Result{2, makeBLKDROP2(drop1 + drop2, rest2)};
-		}
-	}
-
-	// BLKSWAP bottom, top
-	// BLKDROP bottom
-	// =>
-	// BLKDROP2 bottom, top
-	if (isBLKSWAP(cmd1) &&
-		isDrop(cmd2)
-	) {
-		auto [bottom, top] = isBLKSWAP(cmd1).value();
-		int n = isDrop(cmd2).value();
-		if (n == bottom) {
-			return Result{2, makeBLKDROP2(n, top)};
-		}
-	}
-
-	if (is(cmd1, "NEWC") && is(cmd2, "ENDC")) {
-		return Result{2, makePUSHREF()};
-	}
-
-	// LESS | LEQ    | GREATER | GEQ  | EQUAL | NEQ   | EQINT  | NEQINT | NOT | TRUE  | FALSE
-	// NOT
-	// =>
-	// GEQ | GREATER | LEQ     | LESS | NEQ   | EQUAL | NEQINT | EQINT  |     | FALSE | TRUE
-	if (is(cmd2, "NOT")) {
-		if (is(cmd1, "LESS")) return Result{2, gen("GEQ")};
-		if (is(cmd1, "LEQ")) return Result{2, gen("GREATER")};
-		if (is(cmd1, "GREATER")) return Result{2, gen("LEQ")};
-		if (is(cmd1, "GEQ")) return Result{2, gen("LESS")};
-		if (is(cmd1, "EQUAL")) return Result{2, gen("NEQ")};
-		if (is(cmd1, "NEQ")) return Result{2, gen("EQUAL")};
-
-		if (is(cmd1, "EQINT")) return Result{2, gen("NEQINT " + arg(cmd1))};
-		if (is(cmd1, "NEQINT")) return Result{2, gen("EQINT " + arg(cmd1))};
-
-		if (is(cmd1, "NOT")) return Result{2};
-
-		if (is(cmd1, "TRUE")) return Result{2, gen("FALSE")};
-		if (is(cmd1, "FALSE")) return Result{2, gen("TRUE")};
-	}
-
-	if ((is(cmd1, "UFITS") && is(cmd2, "UFITS")) || (is(cmd1, "FITS") && is(cmd2, "FITS"))) {
-		int bitSize = std::min(fetchInt(cmd1), fetchInt(cmd2));
-		return Result{2, gen(cmd1GenOp->opcode() + " " + toString(bitSize))};
-	}
-	if ((is(cmd1, "TRUE") || is(cmd1, "FALSE")) &&
-		is(cmd2, "STIR") && fetchInt(cmd2) == 1
-	) {
-		if (is(cmd1, "FALSE"))
-			return Result{2, gen("STZERO")};
-		return Result{2, gen("STONE")};
-	}
-	if (
-		isPUSHINT(cmd1) && pushintValue(cmd1) == 0 &&
-		is(cmd2, "STUR")
-	) {
-		return Result{2,
-			gen("PUSHINT " + arg(cmd2)),
-			gen("STZEROES")};
-	}
-	if (
-		is(cmd1, "ABS") &&
-		is(cmd2, "UFITS") && fetchInt(cmd2) == 256
-	) {
-		return Result{2, gen("ABS")};
-	}
-
-	if (
-		isPUSHINT(cmd1) && pushintValue(cmd1) == 1 &&
-		is(cmd2, "STZEROES")
-	) {
-		return Result{2, gen("STZERO")};
-	}
-
-	// REVERSE N, 1
-	// BLKSWAP N, 1
-	// =>
-	// REVERSE N+1, 0
-	if (isREVERSE(cmd1) && isBLKSWAP(cmd2)) {
-		auto [qty, index] = isREVERSE(cmd1).value();
-		auto [bottom, top] = isBLKSWAP(cmd2).value();
-		if (top == 1 && index == 1 && qty == bottom)
-			return Result{2, makeREVERSE(qty + 1, 0)};
-	}
-
-	// REVERSE N+1, 0
-	// BLKDROP N
-	// =>
-	// BLKDROP2 N, 1
-	if (isREVERSE(cmd1) && isDrop(cmd2)) {
-		auto [qty, index] = isREVERSE(cmd1).value();
-		int n = isDrop(cmd2).value();
-		if (n + 1 == qty && index == 0)
-			return Result{2, makeBLKDROP2(n, 1)};
-	}
-
-	// ENDC
-	// STREFR
-	// =>
-	// STBREFR
-	if (
-		is(cmd1, "ENDC") &&
-		is(cmd2, "STREFR")
-	) {
-		return Result{2, gen("STBREFR")};
-	}
-
-	// s01
-	// XCHG S1, S2
-	// =>
-	// SWAP
-	// s01
-	if (isPureGen01(*cmd1) &&
-		isXCHG(cmd2, 1, 2)
-	) {
-		return Result{2, makeBLKSWAP(1, 1), cmd1};
-	}
-
-	// DUP
-	// PUSHCONT {
-	//   DROP
-	//   TRUE
-	// }
-	// IF
-	// =>
-	//
-	if (isPUSH1 && *isPUSH1 == 0) {
-		if (auto lc = to<LogCircuit>(cmd2.get())) {
-			if (lc->type() == LogCircuit::Type::AND && lc->body()->instructions().size() == 2) {
-				auto cmd2_0 = lc->body()->instructions().at(0);
-				auto cmd2_1 = lc->body()->instructions().at(1);
-				auto _true = to<GenOpcode>(cmd2_1.get());
-				if (isDrop(cmd2_0) == 1 && _true && _true->opcode() == "TRUE") {
-					return Result{2};
-				}
-			}
-		}
-	}
-
-	// TRUE
-	// AND
-	// =>
-	//
-	auto _true = to<GenOpcode>(cmd1.get());
-	auto _and = to<GenOpcode>(cmd2.get());
-	if (_true && _true->opcode() == "TRUE" &&
-		_and && _and->opcode() == "AND") {
-		return Result{2};
-	}
-
-	// NULL
-	// ISNULL
-	// =>
-	// TRUE
-	if (is(cmd1, "NULL") && is(cmd2, "ISNULL")) {
-		return Result{2, gen("TRUE")};
-	}
-
-	// TRUE       / FALSE
-	// THROWIFNOT / THROWIF
-	// =>
-	//
-	if ((is(cmd1, "TRUE") && isExc(cmd2, "THROWIFNOT")) || (is(cmd1, "FALSE") && isExc(cmd2, "THROWIF"))) {
-		return Result{2};
-	}
-
-	// PUSHINT N
-	// ISNULL
-	// =>
-	// FALSE
-	if (is(cmd1, "PUSHINT") && is(cmd2, "ISNULL")) {
-		return Result{2, gen("FALSE")};
-	}
-
-	// TRUE    / FALSE
-	// THROWIF / THROWIFNOT
-	// =>
-	//
-	if ((is(cmd1, "TRUE") && isExc(cmd2, "THROWIF")) || (is(cmd1, "FALSE") && isExc(cmd2, "THROWIFNOT"))) {
-		return Result{2, makeTHROW("THROW " + cmd2Exc->arg())};
-	}
-
-	if (cmd1GenOp && cmd1GenOp->isPure() &&
-		std::make_pair(cmd1GenOp->take(), cmd1GenOp->ret()) == std::make_pair(1, 1) &&
-		isDrop(cmd2)
-	) {
-		return Result{2, cmd2};
-	}
-
-	// BLKPUSH N, 0 / DUP
-	// BLKPUSH Q, 0 / DUP
-	// =>
-	// BLKPUSH N+Q, 0
-	if (isBLKPUSH(cmd1) && isBLKPUSH(cmd2)) {
-		auto [qty0, index0] = isBLKPUSH(cmd1).value();
-		auto [qty1, index1] = isBLKPUSH(cmd2).value();
-		if (index0 == 0 && index1 == 0 && qty0 + qty1 <= 15)
-			return Result{2, makeBLKPUSH(qty0 + qty1, 0)};
-	}
-
-	// LD[I|U] N / LDDICT / LDREF / LD[I|U]X N
-	// DROP
-	if ((is(cmd1, "LDU", "LDI", "LDREF", "LDDICT", "LDUX", "LDIX",
-			"LDSLICE", "LDSLICEX")) &&
-		isDrop(cmd2)
-	) {
-		// TODO add LD[I|U]LE[4|8]
-		int n = isDrop(cmd2).value();
-		Pointer<GenOpcode> newOpcode = gen("P" + cmd1GenOp->fullOpcode());
-		if (n == 1) {
-			return Result{2, newOpcode};
-		} else {
-			return Result{2, {newOpcode, makeDROP(n - 1)}};
+		int numLength = StrUtils::toBinString(num).length();
+		if (numLength <= 255 && len > numLength) {
+			return Result{2, gen("PUSHINT " + toString(num)), gen("STUR " + toString(len))};
 		}
 	}
 
 	return {};
 }
 
-std::optional<Result> PrivatePeepholeOptimizer::optimizeAt3(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2,
-											 Pointer<TvmAstNode> const& cmd3, bool m_withUnpackOpaque) {
-	auto isPUSH1 = isPUSH(cmd1);
-	auto cmd1PushCellOrSlice = to<PushCellOrSlice>(cmd1.get());
-	auto isPUSH2 = isPUSH(cmd2);
-	auto cmd2PushCellOrSlice = to<PushCellOrSlice>(cmd2.get());
-	auto cmd3GenOpcode = to<GenOpcode>(cmd3.get());
-	auto cmd3SubProgram = to<SubProgram>(cmd3.get());
-
-	// NEW
-	// s01
-	// ST**R
-	// =>
-	// s01
-	// NEW
-	// ST**
-	if (
-		is(cmd1, "NEWC") &&
-		isSimpleCommand(cmd2) &&
-		cmd3GenOpcode &&
-		boost::starts_with(cmd3GenOpcode->opcode(), "ST") && boost::ends_with(cmd3GenOpcode->opcode(), "R")
-	) {
-		const auto& opcode = cmd3GenOpcode->opcode();
-		return Result{3,
-					  cmd2,
-					  gen("NEWC"),
-					  gen(opcode.substr(0, opcode.size() - 1) + " " + arg(cmd3))};
-	}
-	// DUP
-	// THROWIFNOT 507
-	// DROP n
-	if (isPUSH1 && *isPUSH1 == 0 &&
-		isExc(cmd2, "THROWIFNOT", "THROWIF") &&
-		isDrop(cmd3)
-	) {
-		int n = isDrop(cmd3).value();
-		if (n == 1) {
-			return Result{3, cmd2};
-		} else {
-			return Result{3, cmd2, makeDROP(n - 1)};
-		}
-	}
-	if (
-		is(cmd1, "NEWC") &&
-		is(cmd2, "STSLICECONST") && arg(cmd2).length() > 1 &&
-		is(cmd3, "ENDC")
-	) {
-		return Result{3, makePUSHREF(arg(cmd2))};
+std::optional<Result> PrivatePeepholeOptimizer::optimizeAt(const int idx1) const {
+	solAssert(idx1 == 0, "");
+	if (m_optimizeSlice) {
+		return optimizeSlice(idx1);
 	}
 
-	// PUSHINT x
-	// PUSH Si (i!=0) or gen(0,1)
-	// CMP
-	// =>
-	// PUSH S(i-1) or gen(0,1)
-	// CMP2
-	if (isPUSHINT(cmd1) && ((isPUSH2 && *isPUSH2 != 0) || isPureGen01(*cmd2))) {
-		auto newCmd2 = isPUSH2 ? makePUSH(*isPUSH2 - 1) : cmd2;
-		bigint val = pushintValue(cmd1);
-		if (-128 <= val && val < 128) {
-			if (is(cmd3, "NEQ"))
-				return Result{3, newCmd2, gen("NEQINT " + toString(val))};
-			if (is(cmd3, "EQUAL"))
-				return Result{3, newCmd2, gen("EQINT " + toString(val))};
-			if (is(cmd3, "GREATER"))
-				return Result{3, newCmd2, gen("LESSINT " + toString(val))};
-			if (is(cmd3, "LESS"))
-				return Result{3, newCmd2, gen("GTINT " + toString(val))};
-		}
-		if (-128 <= val + 1 && val + 1 < 128 && is(cmd3, "GEQ"))
-			return Result{3, newCmd2, gen("LESSINT " + toString(val + 1))};
-		if (-128 <= val - 1 && val - 1 < 128 && is(cmd3, "LEQ"))
-			return Result{3, newCmd2, gen("GTINT " + toString(val - 1))};
-	}
-	if (isPUSHINT(cmd1) &&
-		isPUSHINT(cmd2) &&
-		cmd3GenOpcode && cmd3GenOpcode->opcode() == "MUL"
-	) {
-		bigint a = pushintValue(cmd1);
-		bigint b = pushintValue(cmd2);
-		bigint c = a * b;
-		return Result{3, gen("PUSHINT " + toString(c))};
-	}
+	PeepholeWindow window{m_rest, m_withUnpackOpaque};
+	std::optional<Result> res = singleCommandRules().match(window);
+	if (res) return res;
 
-	if (isPUSHINT(cmd1) &&
-		isPUSHINT(cmd2) &&
-		cmd3GenOpcode && cmd3GenOpcode->opcode() == "DIV"
-	) {
-		bigint a = pushintValue(cmd1);
-		bigint b = pushintValue(cmd2);
-		if (a >= 0 && b > 0) { // note in TVM  -9 / 2 == -5
-			bigint c = a / b;
-			return Result{3, gen("PUSHINT " + toString(c))};
-		}
-	}
+	res = optimizeAtInf(idx1);
+	if (res) return res;
 
-	// TRUE
-	// NEWC
-	// STI 1
-	if ((is(cmd1, "TRUE") || is(cmd1, "FALSE")) &&
-		is(cmd2, "NEWC") &&
-		is(cmd3, "STI") && arg(cmd3) == "1"
-	) {
-		if (is(cmd1, "TRUE"))
-			return Result{3, gen("NEWC"), gen("STONE")};
-		return Result{3, gen("NEWC"), gen("STZERO")};
-	}
+	return commandSequenceRules().match(window);
+}
 
-	if (
-		isBLKSWAP(cmd1) &&
-		isPureGen01(*cmd2) &&
-		isBLKSWAP(cmd3)
-	) {
-		auto [bottom1, top1] = isBLKSWAP(cmd1).value();
-		auto [bottom3, top3] = isBLKSWAP(cmd3).value();
-		if (bottom1 == 1 && bottom3 == 1 && top3 == 1) {
-			return Result{3, cmd2, makeBLKSWAP(bottom1, top1 + 1)};
-		}
-	}
+std::optional<Result> PrivatePeepholeOptimizer::optimizeAt1(Pointer<TvmAstNode> const& cmd1, bool m_withUnpackOpaque) {
+	std::vector<Pointer<TvmAstNode>> const rest{cmd1};
+	return singleCommandRules().match(PeepholeWindow{rest, m_withUnpackOpaque});
+}
 
-	if (is(cmd1, "NULL") && isPUSH2 && *isPUSH2 == 0 && is(cmd3, "ISNULL")) {
-		return Result{3, gen("NULL"), gen("TRUE")};
-	}
+OpPattern PrivatePeepholeOptimizer::genOp(std::vector<std::string> _opcodes, OpCheck _check) {
+	return OpPattern{std::move(_opcodes), std::move(_check)};
+}
 
-	// gen(0, 1)
-	// BLKPUSH N, 0
-	// gen(0, 1)
-	// =>
-	// gen(0, 1)
-	// BLKPUSH N+1, 0
-	if (
-		isPureGen01(*cmd1) &&
-		isBLKPUSH(cmd2) &&
-		isPureGen01(*cmd3) &&
-		*cmd1 == *cmd3
-	) {
-		auto [qty, index] = isBLKPUSH(cmd2).value();
-		if (index == 0 && qty + 1 <= 15) {
-			return Result{3, cmd1, makeBLKPUSH(qty + 1, index)};
-		}
-	}
+OpPattern PrivatePeepholeOptimizer::stackOp(std::vector<Stack::Opcode> const& _opcodes, OpCheck _check) {
+	std::vector<std::string> keys;
+	for (Stack::Opcode opcode : _opcodes)
+		keys.push_back(PeepholeMatcher::stackKey(opcode));
+	return OpPattern{std::move(keys), std::move(_check)};
+}
 
-	//            ; a b
-	// SWAP       ; b a
-	// gen(0, 1)  ; b a c
-	// ROT        ; a c b
-	// =>
-	// gen(0,1)
-	// SWAP
-	if (isSWAP(cmd1)) {
-		std::optional<std::pair<int, int>> rot = isBLKSWAP(cmd3);
-		if (rot && *rot == std::make_pair(1, 2)) {
-			if (isPureGen01(*cmd2)) {
-				return Result{3, cmd2, makeXCH_S(1)};
-			}
-		}
-	}
+OpPattern PrivatePeepholeOptimizer::kindOp(std::string const& _key, OpCheck _check) {
+	return OpPattern{{_key}, std::move(_check)};
+}
 
+OpPattern PrivatePeepholeOptimizer::anyOp(OpCheck _check) {
+	return OpPattern{{}, std::move(_check)};
+}
 
-	if (cmd1PushCellOrSlice && cmd1PushCellOrSlice->type() == PushCellOrSlice::Type::PUSHREF &&
-		cmd2PushCellOrSlice && cmd2PushCellOrSlice->type() == PushCellOrSlice::Type::PUSHREF
-	) {
-		if (cmd3SubProgram) {
-			std::vector<Pointer<TvmAstNode>> const& instructions = cmd3SubProgram->block()->instructions();
-			if (instructions.size() == 1 &&
-				*instructions.at(0) == *createNode<GenOpcode>(".inline __concatenateStrings_macro", 2, 1)) {
-				string hexStr = cmd1PushCellOrSlice->chainBlob() + cmd2PushCellOrSlice->chainBlob();
-				return Result{3, makePushCellOrSlice(hexStr, false)};
+// Rules for a single command, they are also applied to code blocks in PeepholeOptimizer::endVisit
+PeepholeMatcher const& PrivatePeepholeOptimizer::singleCommandRules() {
+	using R = std::optional<Result>;
+	static PeepholeMatcher const matcher{{
+		{{genOp({"ADDCONST", "MULCONST"})}, [](PeepholeWindow const& w) -> R {
+			if (isIn(to<GenOpcode>(w[0].get())->fullOpcode(), "ADDCONST 0", "MULCONST 1"))
+				return Result{1};
+			return {};
+		}},
+		{{genOp({"ADDCONST"})}, [](PeepholeWindow const& w) -> R {
+			if (arg(w[0]) == "1")
+				return Result{1, gen("INC")};
+			return {};
+		}},
+		{{genOp({"ADDCONST"})}, [](PeepholeWindow const& w) -> R {
+			if (arg(w[0]) == "-1")
+				return Result{1, gen("DEC")};
+			return {};
+		}},
+		{{genOp({"MULCONST"})}, [](PeepholeWindow const& w) -> R {
+			if (arg(w[0]) == "-1")
+				return Result{1, gen("NEGATE")};
+			return {};
+		}},
+		// PUSHCONT {} IF/IFNOT => DROP
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (qtyWithoutLoc(cmd1IfElse->trueBody()->instructions()) == 0 &&
+				cmd1IfElse->falseBody() == nullptr && !cmd1IfElse->withJmp()
+			) {
+				return Result{1, makeDROP()};
 			}
-		}
-	}
-
-	// TODO delete, fix in stackOpt
-	// Note: breaking stack
-	// DUP
-	// IFREF { CALL $c7_to_c4$ / $upd_only_time_in_c4$ }
-	// =>
-	// IFREF { CALL $c7_to_c4$ / $upd_only_time_in_c4$ }
-	if (m_withUnpackOpaque && isPUSH(cmd1)) {
-		if (auto ifRef = to<TvmIfElse>(cmd2.get());
-			ifRef && !ifRef->withJmp() && !ifRef->withNot() && ifRef->falseBody() == nullptr
-		) {
-			std::vector<Pointer<TvmAstNode>> const &cmds = ifRef->trueBody()->instructions();
-			if (cmds.size() == 1) {
-				if (auto gen = to<GenOpcode>(cmds.at(0).get())) {
-					if (isIn(gen->fullOpcode(), ".inline __c7_to_c4", ".inline __upd_only_time_in_c4")) {
-						return Result{2, cmd2};
+			return {};
+		}},
+		// PUSHCONT {} IFJMP => IFRET
+		// PUSHCONT {} IFNOTJMP => IFNOTRET
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (qtyWithoutLoc(cmd1IfElse->trueBody()->instructions()) == 0 && cmd1IfElse->falseBody() == nullptr && cmd1IfElse->withJmp()) {
+				if (cmd1IfElse->withNot())
+					return Result{1, makeIFNOTRET()};
+				return Result{1, makeIFRET()};
+			}
+			return {};
+		}},
+		// PUSHCONT { THROW N } IF/IFJMP => THROWIF
+		// PUSHCONT { THROW N } IFNOT/IFNOTJMP => THROWIFNOT
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (cmd1IfElse->falseBody() == nullptr) {
+				std::vector<Pointer<TvmAstNode>> const& inst = cmd1IfElse->trueBody()->instructions();
+				if (qtyWithoutLoc(inst) == 1) {
+					Pointer<TvmAstNode> pos;
+					for (const auto& x : inst) if (!to<Loc>(x.get())) pos = x;
+					auto _throw = to<TvmException>(pos.get());
+					if (_throw && _throw->opcode() == "THROW") {
+						if (cmd1IfElse->withNot())
+							return Result{1, makeTHROW("THROWIFNOT " + _throw->arg())};
+						return Result{1, makeTHROW("THROWIF " + _throw->arg())};
 					}
 				}
 			}
-		}
-	}
-
-	return {};
+			return {};
+		}},
+		// PUSH[REF]CONT { RETALT } IF[NOT][JMP] => IFRETALT
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (cmd1IfElse->falseBody() == nullptr) {
+				std::vector<Pointer<TvmAstNode>> const& inst = cmd1IfElse->trueBody()->instructions();
+				if (qtyWithoutLoc(inst) == 1) {
+					Pointer<TvmAstNode> pos;
+					for (const auto& x : inst) if (!to<Loc>(x.get())) pos = x;
+					auto ret = to<TvmReturn>(pos.get());
+					if (ret && !ret->withIf() && ret->withAlt()) {
+						if (cmd1IfElse->withNot())
+							return Result{1, makeIFNOTRETALT()};
+						return Result{1, makeIFRETALT()};
+					}
+				}
+			}
+			return {};
+		}},
+		// PUSH[REF]CONT { RETALT } JMP/CALLX => RETALT
+		{{kindOp(PeepholeMatcher::SubProgramKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1Sub = to<SubProgram>(w[0].get());
+			std::vector<Pointer<TvmAstNode>> const& inst = cmd1Sub->block()->instructions();
+			if (qtyWithoutLoc(inst) == 1) {
+				Pointer<TvmAstNode> pos;
+				for (const auto& x : inst) if (!to<Loc>(x.get())) pos = x;
+				auto ret = to<TvmReturn>(pos.get());
+				if (ret && !ret->withIf() && ret->withAlt()) {
+					return Result{1, makeRETALT()};
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT {
+		//  LDU 256
+		//	ENDS
+		// }
+		// PUSHCONT {
+		//	LDU 256
+		//	ENDS
+		// }
+		// IFELSE
+		// =>
+		// DROP
+		// PUSHCONT {
+		//	LDU 256
+		//	ENDS
+		// }
+		// CALLX
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (cmd1IfElse->falseBody() != nullptr) {
+				std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
+				std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
+				if (t.size() == f.size()) {
+					bool eq = true;
+					int n = f.size();
+					for (int i = 0; i < n; ++i) {
+						eq &= *t.at(i) == *f.at(i);
+					}
+					if (eq) {
+						auto subProg = createNode<SubProgram>(0, 0, false, cmd1IfElse->trueBody(), false);
+						return Result{1, makeDROP(), subProg};
+					}
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT {
+		//   ...
+		//   Z
+		// }
+		// PUSHCONT {
+		//   ...
+		//   Z
+		// }
+		// IFELSE
+		// =>
+		// PUSHCONT {
+		//   ...
+		// }
+		// PUSHCONT {
+		//   ...
+		// }
+		// IFELSE
+		// Z
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (w.withUnpackOpaque() && cmd1IfElse->falseBody() != nullptr && cmd1IfElse->ret() == 0) {
+				std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
+				std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
+				if (!t.empty() &&
+					!f.empty() &&
+					*t.back() == *f.back() &&
+					!cmd1IfElse->withJmp() &&
+					cmd1IfElse->trueBody()->type() == CodeBlock::Type::PUSHCONT &&
+					cmd1IfElse->falseBody()->type() == CodeBlock::Type::PUSHCONT &&
+					!hasRetOrJmp(cmd1IfElse->trueBody().get()) &&
+					!hasRetOrJmp(cmd1IfElse->falseBody().get())
+				) {
+					auto tt = createNode<CodeBlock>(CodeBlock::Type::PUSHCONT, std::vector<Pointer<TvmAstNode>>(t.begin(), t.end() - 1));
+					auto ff = createNode<CodeBlock>(CodeBlock::Type::PUSHCONT, std::vector<Pointer<TvmAstNode>>(f.begin(), f.end() - 1));
+					auto ifElse2 = createNode<TvmIfElse>(cmd1IfElse->withNot(), false, tt, ff, 0);
+					return Result{1, ifElse2, t.back()};
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT {
+		//   ...
+		// }
+		// PUSHCONT {
+		// }
+		// IFELSE
+		// =>
+		// PUSHCONT {
+		//   ...
+		// }
+		// IF
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (cmd1IfElse->falseBody() != nullptr) {
+				std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
+				if (qtyWithoutLoc(f) == 0 &&
+					!cmd1IfElse->withJmp()
+				) {
+					auto ifElse2 = createNode<TvmIfElse>(cmd1IfElse->withNot(), false, cmd1IfElse->trueBody(), nullptr, 0);
+					return Result{1, ifElse2};
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT {
+		// }
+		// PUSHCONT {
+		//    ...
+		// }
+		// IFELSE
+		// =>
+		// PUSHCONT {
+		//   ...
+		// }
+		// IFNOT
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (cmd1IfElse->falseBody() != nullptr) {
+				std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
+				if (qtyWithoutLoc(t) == 0 &&
+					!cmd1IfElse->withJmp()
+				) {
+					auto ifElse2 = createNode<TvmIfElse>(!cmd1IfElse->withNot(), false, cmd1IfElse->falseBody(), nullptr, 0);
+					return Result{1, ifElse2};
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT { genA }
+		// PUSHCONT { genB }
+		// IFELSE
+		// =>
+		// genA
+		// genB
+		// CONDSEL
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (cmd1IfElse->falseBody() != nullptr) {
+				std::vector<Pointer<TvmAstNode>> const& t = cmd1IfElse->trueBody()->instructions();
+				std::vector<Pointer<TvmAstNode>> const& f = cmd1IfElse->falseBody()->instructions();
+				if (qtyWithoutLoc(t) == 1 && qtyWithoutLoc(f) == 1) {
+					int ti = nextCommandLine(0, t);
+					int fi = nextCommandLine(0, f);
+					Pointer<TvmAstNode> a = t.at(ti);
+					Pointer<TvmAstNode> b = f.at(fi);
+					if (isPureGen01(*a) &&
+						isPureGen01(*b) &&
+						std::dynamic_pointer_cast<GenOpcode>(a) &&
+						std::dynamic_pointer_cast<GenOpcode>(b)
+					) {
+						return Result{1, a, b, gen("CONDSEL")};
+					}
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT { TRUE }
+		// PUSHCONT { ... }
+		// WHILE
+		// =>
+		// PUSHCONT { ... }
+		// AGAIN
+		{{kindOp(PeepholeMatcher::WhileKey)}, [](PeepholeWindow const& w) -> R {
+			auto _while = to<While>(w[0].get());
+			std::vector<Pointer<TvmAstNode>> const& instr = _while->condition()->instructions();
+			if (instr.size() == 1 && is(instr.at(0), "TRUE") && !_while->isInfinite()) {
+				return Result{1, createNode<While>(true, _while->withBreakOrReturn(), _while->condition(), _while->body())};
+			}
+			return {};
+		}},
+		// PUSHCONT { here }
+		// CALLX
+		// =>
+		// here
+		{{kindOp(PeepholeMatcher::SubProgramKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1Sub = to<SubProgram>(w[0].get());
+			if (!cmd1Sub->isJmp() && cmd1Sub->block()->type() == CodeBlock::Type::PUSHCONT) {
+				bool ok = true;
+				for (Pointer<TvmAstNode> const& cmd : cmd1Sub->block()->instructions()) {
+					if (hasRetOrJmp(cmd.get())) {
+						ok = false;
+					}
+				}
+				if (ok) {
+					return Result{1, cmd1Sub->block()->instructions()};
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT {
+		//    CALLREF {
+		//       code
+		//    }
+		// }
+		// =>
+		// PUSHREF {
+		//    code
+		// }
+		{{kindOp(PeepholeMatcher::CodeBlockKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1CodeBlock = to<CodeBlock>(w[0].get());
+			if (cmd1CodeBlock->type() == CodeBlock::Type::PUSHCONT) {
+				std::vector<Pointer<TvmAstNode>> const&  opcodes = cmd1CodeBlock->instructions();
+				if (qtyWithoutLoc(opcodes) == 1) {
+					int index = nextCommandLine(0, opcodes);
+					TvmAstNode const* opcode = opcodes.at(index).get();
+					if (auto sub = to<SubProgram>(opcode)) {
+						return Result{1, createNode<CodeBlock>(sub->block()->type(), sub->block()->instructions())};
+					}
+				}
+			}
+			return {};
+		}},
+		// PUSHCONT {
+		//    PUSHINT 0 / NULL
+		//    [SWAP]
+		// }
+		// IF[ELSE][NOT][JMP]
+		// =>
+		// ZERO/NULL SWAP/ROTR IF [NOT]
+		// PUSHCONT { ... }
+		// IF[ELSE][NOT][JMP]
+		{{kindOp(PeepholeMatcher::IfElseKey)}, [](PeepholeWindow const& w) -> R {
+			auto cmd1IfElse = to<TvmIfElse>(w[0].get());
+			if (!w.withUnpackOpaque()) {
+				return {};
+			}
+			auto f = [](bool isZero, bool isSwap, std::vector<Pointer<TvmAstNode>> const& instructions) {
+				if (instructions.size() != (isSwap ? 2 : 1)) {
+					return false;
+				}
+				return *instructions.at(0) == *gen(isZero ? "PUSHINT 0" : "NULL") &&
+					   (!isSwap || *instructions.at(1) == *makeXCH_S(1));
+			};
+			for (bool isZero : {true, false}) {
+				if (isZero && GlobalParams::g_tvmVersion == langutil::TVMVersion::ton()){
+					// ignore ZERO SWAP/ROTR IF [NOT]
+					continue;
+				}
+				for (bool isSwap : {true, false}) {
+					for (bool trueBranch: {true, false}) {
+						Pointer<CodeBlock> curBranch = trueBranch ? cmd1IfElse->trueBody() : cmd1IfElse->falseBody();
+						if (!curBranch) {
+							continue;
+						}
+						if (f(isZero, isSwap, curBranch->instructions())) {
+							Pointer<AsymGen> align = getZeroOrNullAlignment(isZero, !isSwap,
+																			!trueBranch || cmd1IfElse->withNot());
+							solAssert(trueBranch ? true : !cmd1IfElse->withNot(), "");
+							auto emptyBlock = createNode<CodeBlock>(curBranch->type());
+							return Result{1,
+										  align,
+										  createNode<TvmIfElse>(cmd1IfElse->withNot(), cmd1IfElse->withJmp(),
+																trueBranch ? emptyBlock : cmd1IfElse->trueBody(),
+																trueBranch ? cmd1IfElse->falseBody() : emptyBlock,
+																cmd1IfElse->ret())
+							};
+						}
+					}
+				}
+			}
+			return {};
+		}},
+	}};
+	return matcher;
 }
 
-std::optional<Result> PrivatePeepholeOptimizer::optimizeAt4(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2,
-											 Pointer<TvmAstNode> const& cmd3, Pointer<TvmAstNode> const& cmd4) {
-	auto cmd3Exc = to<TvmException>(cmd3.get());
+// Rules for two and more commands
+PeepholeMatcher const& PrivatePeepholeOptimizer::commandSequenceRules() {
+	using R = std::optional<Result>;
+	using S = Stack::Opcode;
+
+	static std::map<bigint, int> const power2 = [](){
+		std::map<bigint, int> res;
+		for (int p2 = 2, p = 1; p2 <= 256; p2 *= 2, ++p) {
+			res[p2] = p;
+		}
+		return res;
+	}();
+
+	static PeepholeMatcher const matcher = [](){
+		OpPattern const swap = stackOp({S::BLKSWAP, S::XCHG, S::REVERSE}, [](Pointer<TvmAstNode> const& c) { return isSWAP(c); });
+		OpPattern const blkSwap = stackOp({S::BLKSWAP, S::XCHG, S::REVERSE}, [](Pointer<TvmAstNode> const& c) { return isBLKSWAP(c).has_value(); });
+		OpPattern const reverse = stackOp({S::REVERSE, S::BLKSWAP, S::XCHG}, [](Pointer<TvmAstNode> const& c) { return isREVERSE(c).has_value(); });
+		OpPattern const drop = stackOp({S::DROP});
+		OpPattern const blkDrop2 = stackOp({S::BLKDROP2, S::POP_S}, [](Pointer<TvmAstNode> const& c) { return isBLKDROP2(c).has_value(); });
+		OpPattern const pop = stackOp({S::POP_S, S::BLKDROP2}, [](Pointer<TvmAstNode> const& c) { return isPOP(c).has_value(); });
+		OpPattern const nip = stackOp({S::POP_S, S::BLKDROP2}, [](Pointer<TvmAstNode> const& c) { return isNIP(c); });
+		OpPattern const push = stackOp({S::PUSH_S, S::BLKPUSH}, [](Pointer<TvmAstNode> const& c) { return isPUSH(c).has_value(); });
+		OpPattern const dup = stackOp({S::PUSH_S, S::BLKPUSH}, [](Pointer<TvmAstNode> const& c) { return isPUSH(c) == 0; });
+		OpPattern const blkPush = stackOp({S::BLKPUSH, S::PUSH_S}, [](Pointer<TvmAstNode> const& c) { return isBLKPUSH(c).has_value(); });
+		OpPattern const pushint = genOp({"PUSHINT"}, [](Pointer<TvmAstNode> const& c) { return isPUSHINT(c); });
+		OpPattern const constAdd = genOp({"INC", "DEC", "ADDCONST"});
+		OpPattern const pureGen01 = anyOp([](Pointer<TvmAstNode> const& c) { return isPureGen01(*c); });
+		OpPattern const ifElse = kindOp(PeepholeMatcher::IfElseKey);
+		OpPattern const plainPushSlice = kindOp(PeepholeMatcher::PushCellOrSliceKey, [](Pointer<TvmAstNode> const& c) { return isPlainPushSlice(c) != nullptr; });
+		auto exc = [](std::string const& opcode) {
+			return kindOp(PeepholeMatcher::ExceptionKey, [opcode](Pointer<TvmAstNode> const& c) { return isExc(c, opcode); });
+		};
+		// ST**R that takes builder and value
+		OpPattern const storeR = anyOp([](Pointer<TvmAstNode> const& c) {
+			auto g = to<GenOpcode>(c.get());
+			return g && boost::starts_with(g->opcode(), "ST") && boost::ends_with(g->opcode(), "R");
+		});
+		// the comparison that takes PUSHINT and is replaced by the opcode with the constant argument
+		auto cmpInt = [](std::string const& cmp, std::string const& cmpInt, int shift) {
+			return [cmp, cmpInt, shift](bigint const& val, Pointer<TvmAstNode> const& cmd) -> Pointer<TvmAstNode> {
+				if (is(cmd, cmp) && -128 <= val + shift && val + shift < 128)
+					return gen(cmpInt + " " + toString(val + shift));
+				return nullptr;
+			};
+		};
+
+		std::vector<PeepholeRule> rules{
+			{{swap, genOp({"STU"})}, [](PeepholeWindow const& w) -> R {
+				return Result{2, gen("STUR " + arg(w[1]))};
+			}},
+			{{swap, genOp({"STSLICE"})}, [](PeepholeWindow const&) -> R {
+				return Result{2, gen("STSLICER")};
+			}},
+			{{swap, genOp({"SUB"})}, [](PeepholeWindow const&) -> R {
+				return Result{2, gen("SUBR")};
+			}},
+			{{swap, genOp({"SUBR"})}, [](PeepholeWindow const&) -> R {
+				return Result{2, gen("SUB")};
+			}},
+			{{swap, genOp({"ADD", "AND", "EQUAL", "MAX", "MIN", "MUL", "NEQ", "OR", "SDEQ", "XOR"})}, [](PeepholeWindow const& w) -> R {
+				if (isCommutative(w[1])) return Result{1};
+				return {};
+			}},
+			{{swap, storeR}, [](PeepholeWindow const& w) -> R {
+				auto cmd2GenOpcode = to<GenOpcode>(w[1].get());
+				if (cmd2GenOpcode->take() == 2 && cmd2GenOpcode->ret() == 1) {
+					auto opcode = cmd2GenOpcode->opcode();
+					opcode = opcode.substr(0, opcode.size() - 1);
+					return Result{2, gen(opcode + " " + arg(w[1]))};
+				}
+				return {};
+			}},
+			{{pushint, genOp({"ADD"})}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "1") return Result{2, gen("INC")};
+				return {};
+			}},
+			{{pushint, genOp({"SUB"})}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "1") return Result{2, gen("DEC")};
+				return {};
+			}},
+			{{pushint, genOp({"ADD", "MUL"})}, [](PeepholeWindow const& w) -> R {
+				bigint value = pushintValue(w[0]);
+				if (-128 <= value && value <= 127) {
+					if (is(w[1], "ADD")) return Result{2, gen("ADDCONST " + toString(value))};
+					if (is(w[1], "MUL")) return Result{2, gen("MULCONST " + toString(value))};
+				}
+				return {};
+			}},
+			{{pushint, genOp({"SUB"})}, [](PeepholeWindow const& w) -> R {
+				bigint value = pushintValue(w[0]);
+				if (-128 <= -value && -value <= 127) return Result{2, gen("ADDCONST " + toString(-value))};
+				return {};
+			}},
+			// delete commands after non return opcode
+			{{kindOp(PeepholeMatcher::ReturnKey), anyOp()}, [](PeepholeWindow const& w) -> R {
+				if (!to<TvmReturn>(w[0].get())->withIf()) return Result{2, w[0]};
+				return {};
+			}},
+			{{kindOp(PeepholeMatcher::ExceptionKey), anyOp()}, [](PeepholeWindow const& w) -> R {
+				if (isExc(w[0], "THROWANY", "THROW")) return Result{2, w[0]};
+				return {};
+			}},
+			{{dup, swap}, [](PeepholeWindow const& w) -> R {
+				return Result{2, w[0]};
+			}},
+			// POP Sn
+			// DROP n-1
+			// =>
+			// BLKDROP2 n, 1
+			{{pop, drop}, [](PeepholeWindow const& w) -> R {
+				if (isPOP(w[0]).value() == isDrop(w[1]).value() + 1) {
+					int n = isPOP(w[0]).value();
+					if (1 <= n && n <= 15) {
+						return Result{2, makeBLKDROP2(n, 1)};
+					}
+				}
+				return {};
+			}},
+			// SWAP
+			// POP S2
+			//
+			// BLKDROP2 1, 2
+			{{swap, pop}, [](PeepholeWindow const& w) -> R {
+				if (isPOP(w[1]).value() == 2) return Result{2, makeBLKDROP2(1, 2)};
+				return {};
+			}},
+			{{anyOp([](Pointer<TvmAstNode> const& c) { return isPUSH(c) || isPureGen01(*c); }), drop}, [](PeepholeWindow const& w) -> R {
+				int qty = isDrop(w[1]).value();
+				if (qty == 1) {
+					return Result{2};
+				} else {
+					return Result{2, makeDROP(qty - 1)};
+				}
+			}},
+			// BLKPUSH N, index / DROP
+			// BLKDROP N
+			{{blkPush, drop}, [](PeepholeWindow const& w) -> R {
+				auto [qty, index] = isBLKPUSH(w[0]).value();
+				int diff = qty - isDrop(w[1]).value();
+				if (diff == 0)
+					return Result{2};
+				if (diff < 0)
+					return Result{2, makeDROP(-diff)};
+				else
+					return Result{2, makeBLKPUSH(diff, index)};
+			}},
+			// PUSH S[n-1]
+			// BLKDROP2 N, 1 / NIP
+			// =>
+			// DROP N-1
+			{{push, blkDrop2}, [](PeepholeWindow const& w) -> R {
+				int index = *isPUSH(w[0]);
+				auto [drop, rest] = isBLKDROP2(w[1]).value();
+				if (drop == index + 1 && rest == 1) {
+					if (drop == 1) {
+						return Result{2};
+					} else {
+						return Result{2, makeDROP(drop - 1)};
+					}
+				}
+				return {};
+			}},
+			// s01
+			// BLKDROP2 N, M
+			// =>
+			// BLKDROP2 N, M-1
+			// s01
+			{{pureGen01, blkDrop2}, [](PeepholeWindow const& w) -> R {
+				auto [down, up] = isBLKDROP2(w[1]).value();
+				return Result{2, makeBLKDROP2(down, up - 1), w[0]};
+			}},
+			// BLKPUSH
+			// BLKDROP2
+			// =>
+			// ???
+			{{blkPush, blkDrop2}, [](PeepholeWindow const& w) -> R {
+				auto [qty, index] = isBLKPUSH(w[0]).value();
+				auto [drop, rest] = isBLKDROP2(w[1]).value();
+
+				// BLKPUSH  qty, qty-1
+				// BLKDROP2 qty+X, qty
+				// =>
+				// BLKDROP2 X, qty
+				if (qty == index + 1 && rest == qty) {
+					if (drop == qty) {
+						return Result{2};
+					} else if (drop > qty) {
+						return Result{2, makeBLKDROP2(drop - qty, qty)};
+					}
+				}
 
-	if (isPUSHINT(cmd1) && isPUSHINT(cmd3)) {
-		if (isAddOrSub(cmd2) && isAddOrSub(cmd4)) {
-			bigint sum = 0;
-			sum += (is(cmd2, "ADD") ? +1 : -1) * pushintValue(cmd1);
-			sum += (is(cmd4, "ADD") ? +1 : -1) * pushintValue(cmd3);
-			return Result{4, gen("PUSHINT " + toString(sum)), gen("ADD")};
-		}
-	}
-	if (isPlainPushSlice(cmd1) &&
-		is(cmd2, "NEWC") &&
-		is(cmd3, "STSLICECONST") &&
-		is(cmd4, "STSLICE")) {
-		std::optional<std::string> slice = StrUtils::unitSlices(arg(cmd3), isPlainPushSlice(cmd1)->blob());
-		if (slice.has_value()) {
-			return Result{4,
-						  genPushSlice(*slice),
-						   gen("NEWC"),
-						   gen("STSLICE")};
-		}
-	}
-	// ADDCONST/INC/DEC
-	// UFIT/FIT N
-	// ADDCONST/INC/DEC
-	// UFIT/FIT N
-	// =>
-	// ADDCONST
-	// UFIT/FIT N
-	if (isConstAdd(cmd1) && isConstAdd(cmd3)) {
-		for (std::string fit : {"UFITS", "FITS"}) {
-			if (is(cmd2, fit) && is(cmd4, fit) && arg(cmd2) == arg(cmd4)) {
-				int final_add = getAddNum(cmd1) + getAddNum(cmd3);
+				// BLKPUSH   qty, index
+				// BLKDROP2 drop, qty
+				// =>
+				// DROP X, qty
+				if (qty == rest) {
+					int lastIndex = index - qty + 1; // include
+					if (lastIndex >= 0 && lastIndex + qty == drop) {
+						// a b c d e f X Y |
+						// X Y a b c d e f X Y | BLKPUSH
+						// X Y | BLKDROP2
+						int newDrop = lastIndex;
+						return Result{2, makeDROP(newDrop)};
+					}
+				}
+				return {};
+			}},
+			// DUP
+			// BLKDROP2 n, 1
+			// =>
+			// BLKDROP2 n-1, 1
+			// Same as prev
+			{{dup, blkDrop2}, [](PeepholeWindow const& w) -> R {
+				if (isBLKDROP2(w[1]).value().second == 1) {
+					int n = isBLKDROP2(w[1]).value().first;
+					if (n == 1) {
+						return Result{2};
+					} else {
+						return Result{2, makeBLKDROP2(n - 1, 1)};
+					}
+				}
+				return {};
+			}},
+			// NIP
+			// DROP n
+			// =>
+			// DROP n+1
+			{{nip, drop}, [](PeepholeWindow const& w) -> R {
+				return Result{2, makeDROP(isDrop(w[1]).value() + 1)};
+			}},
+			// NOT THROWIFNOT/THROWIF N => THROWIF/THROWIFNOT N
+			// NOT PUSHCONT {} IF/IFNOT => PUSHCONT {} IFNOT/IF
+			{{genOp({"NOT"}), exc("THROWIF")}, [](PeepholeWindow const& w) -> R {
+				return Result{2, makeTHROW("THROWIFNOT " + to<TvmException>(w[1].get())->arg())};
+			}},
+			{{genOp({"NOT"}), exc("THROWIFNOT")}, [](PeepholeWindow const& w) -> R {
+				return Result{2, makeTHROW("THROWIF " + to<TvmException>(w[1].get())->arg())};
+			}},
+			{{genOp({"NOT"}), ifElse}, [](PeepholeWindow const& w) -> R {
+				return Result{2, flipIfElse(*to<TvmIfElse>(w[1].get()))};
+			}},
+			// EQINT 0 THROWIFNOT/THROWIF N => THROWIF/THROWIFNOT N
+			// EQINT 0 PUSHCONT {} IF/IFNOT => PUSHCONT {} IFNOT/IF
+			{{genOp({"EQINT"}), exc("THROWIF")}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "0") return Result{2, makeTHROW("THROWIFNOT " + to<TvmException>(w[1].get())->arg())};
+				return {};
+			}},
+			{{genOp({"EQINT"}), exc("THROWIFNOT")}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "0") return Result{2, makeTHROW("THROWIF " + to<TvmException>(w[1].get())->arg())};
+				return {};
+			}},
+			{{genOp({"EQINT"}), ifElse}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "0") return Result{2, flipIfElse(*to<TvmIfElse>(w[1].get()))};
+				return {};
+			}},
+			// NEQINT 0, THROWIF/THROWIFNOT N => THROWIF/THROWIFNOT N
+			// NEQINT 0, PUSHCONT {} IF => PUSHCONT {} IF
+			{{genOp({"NEQINT"}), exc("THROWIF")}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "0") return Result{2, makeTHROW("THROWIF " + to<TvmException>(w[1].get())->arg())};
+				return {};
+			}},
+			{{genOp({"NEQINT"}), exc("THROWIFNOT")}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "0") return Result{2, makeTHROW("THROWIFNOT " + to<TvmException>(w[1].get())->arg())};
+				return {};
+			}},
+			{{genOp({"NEQINT"}), ifElse}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[0]) == "0") return Result{2, w[1]};
+				return {};
+			}},
+			// TRUE
+			// PUSHCONT {} / PUSHREF {}
+			// ...
+			// IF / IFJMP / IFELSE / IFELSE_WITH_JMP
+			{{genOp({"TRUE"}), ifElse}, [](PeepholeWindow const& w) -> R {
+				auto cmd2IfElse = to<TvmIfElse>(w[1].get());
+				if (!cmd2IfElse->withNot()) {
+					auto subProg = createNode<SubProgram>(0, 0, cmd2IfElse->withJmp(), cmd2IfElse->trueBody(), false);
+					return Result{2, subProg};
+				}
+				return {};
+			}},
+			// BLKSWAP  down, up
+			// BLKDROP2 drop, rest where drop==up and rest==down
+			// ...
+			// DROP up
+			{{blkSwap, blkDrop2}, [](PeepholeWindow const& w) -> R {
+				auto [down, up] = isBLKSWAP(w[0]).value();
+				auto [drop, rest] = isBLKDROP2(w[1]).value();
+				if (drop==up && rest==down)
+					return Result{2, makeDROP(up)};
+				return {};
+			}},
+			// BLKDROP2 drop, rest
+			// BLKDROP rest + some
+			// ...
+			// BLKDROP drop + rest + some
+			{{blkDrop2, drop}, [](PeepholeWindow const& w) -> R {
+				auto [drop, rest] = isBLKDROP2(w[0]).value();
+				int n = isDrop(w[1]).value();
+				int some = n - rest;
+				if (some >= 0)
+					return Result{2, makeDROP(drop + rest + some)};
+				return {};
+			}},
+			// BLKSWAP down, up
+			// DROP down
+			// =>
+			// BLKDROP down, up
+			{{blkSwap, drop}, [](PeepholeWindow const& w) -> R {
+				auto [down, up] = isBLKSWAP(w[0]).value();
+				int n = isDrop(w[1]).value();
+				if (n == down)
+					return Result{2, makeBLKDROP2(down, up)};
+				return {};
+			}},
+			{{blkSwap, blkSwap}, [](PeepholeWindow const& w) -> R {
+				auto [down1, top1] = isBLKSWAP(w[0]).value();
+				auto [down2, top2] = isBLKSWAP(w[1]).value();
+				if (down1 + top1 == down2 + top2) {
+					// BLKSWAP down1, top1 where down1 + top1 == n
+					// BLKSWAP     1, n-1
+					// ...
+					// BLKSWAP down1+1, top1-1
+					if (down2 == 1) {
+						if (top1 == 1) {
+							return Result{2};
+						} else {
+							return Result{2, makeBLKSWAP(down1 + 1, top1 - 1)};
+						}
+					}
+					// BLKSWAP down1, top1  where down1 + top1 == n
+					// BLKSWAP n-1,    1
+					// ...
+					// BLKSWAP down1-1, top1+1
+					if (top2 == 1) {
+						if (down1 == 1) {
+							return Result{2};
+						} else {
+							return Result{2, makeBLKSWAP(down1 - 1, top1 + 1)};
+						}
+					}
+				}
+				return {};
+			}},
+			{{genOp({"TUPLE"}), genOp({"UNTUPLE"})}, [](PeepholeWindow const& w) -> R {
+				if (fetchInt(w[0]) == fetchInt(w[1])) return Result{2};
+				return {};
+			}},
+			{{genOp({"UNTUPLE"}), genOp({"TUPLE"})}, [](PeepholeWindow const& w) -> R {
+				if (fetchInt(w[0]) == fetchInt(w[1])) return Result{2};
+				return {};
+			}},
+			{{kindOp(PeepholeMatcher::GlobKey), kindOp(PeepholeMatcher::GlobKey)}, [](PeepholeWindow const& w) -> R {
+				auto cmd1Glob = to<Glob>(w[0].get());
+				auto cmd2Glob = to<Glob>(w[1].get());
+				if (cmd1Glob->opcode() == Glob::Opcode::SetOrSetVar &&
+					cmd2Glob->opcode() == Glob::Opcode::GetOrGetVar &&
+					cmd1Glob->index() == cmd2Glob->index()
+				) {
+					return Result{2, makePUSH(0), makeSetGlob(cmd1Glob->index())};
+				}
+				return {};
+			}},
+			{{constAdd, constAdd}, [](PeepholeWindow const& w) -> R {
+				int final_add = getAddNum(w[0]) + getAddNum(w[1]);
 				if (-128 <= final_add && final_add <= 127)
+					return Result{2, gen("ADDCONST " + std::to_string(final_add))};
+				return {};
+			}},
+			{{genOp({"INDEX_NOEXCEP", "INDEX_EXCEP"}), genOp({"INDEX_NOEXCEP", "INDEX_EXCEP"})}, [](PeepholeWindow const& w) -> R {
+				if (0 <= strToInt(arg(w[0])) && strToInt(arg(w[0])) <= 3 &&
+					0 <= strToInt(arg(w[1])) && strToInt(arg(w[1])) <= 3) {
+					return Result{2, gen("INDEX2 " + arg(w[0]) + ", " + arg(w[1]))};
+				}
+				return {};
+			}},
+			{{genOp({"INDEX2"}), genOp({"INDEX_NOEXCEP", "INDEX_EXCEP"})}, [](PeepholeWindow const& w) -> R {
+				if (0 <= strToInt(arg(w[1])) && strToInt(arg(w[1])) <= 3) {
+					auto [i, j] = getIndexes(arg(w[0]));
+					if (0 <= i && i <= 3 &&
+						0 <= j && j <= 3) {
+						return Result{2, gen("INDEX3 " + toString(i) + ", " + toString(j) + ", " + arg(w[1]))};
+					}
+				}
+				return {};
+			}},
+			{{pushint, genOp({"RSHIFT", "LSHIFT"})}, [](PeepholeWindow const& w) -> R {
+				if (1 <= pushintValue(w[0]) && pushintValue(w[0]) <= 256 && arg(w[1]).empty()) {
+					return Result{2, gen(to<GenOpcode>(w[1].get())->opcode() + " " + arg(w[0]))};
+				}
+				return {};
+			}},
+			{{pushint, genOp({"DIV", "MUL"})}, [](PeepholeWindow const& w) -> R {
+				bigint val = pushintValue(w[0]);
+				if (power2.count(val)) {
+					const std::string& newOp = is(w[1], "DIV") ? "RSHIFT" : "LSHIFT";
+					return Result{2, gen(newOp + " " + toString(power2.at(val)))};
+				}
+				return {};
+			}},
+			{{pushint, genOp({"MOD"})}, [](PeepholeWindow const& w) -> R {
+				bigint val = pushintValue(w[0]);
+				if (power2.count(val)) {
+					return Result{2, gen("MODPOW2 " + toString(power2.at(val)))};
+				}
+				return {};
+			}},
+			{{pushint, genOp({"NEQ", "EQUAL", "GREATER", "LESS", "GEQ", "LEQ"})}, [cmpInt](PeepholeWindow const& w) -> R {
+				bigint val = pushintValue(w[0]);
+				for (auto const& cmp : {
+					cmpInt("NEQ", "NEQINT", 0),
+					cmpInt("EQUAL", "EQINT", 0),
+					cmpInt("GREATER", "GTINT", 0),
+					cmpInt("LESS", "LESSINT", 0),
+					cmpInt("GEQ", "GTINT", -1),
+					cmpInt("LEQ", "LESSINT", +1)
+				}) {
+					if (Pointer<TvmAstNode> res = cmp(val, w[1]))
+						return Result{2, res};
+				}
+				return {};
+			}},
+			{{blkDrop2, blkDrop2}, [](PeepholeWindow const& w) -> R {
+				auto [drop1, rest1] = isBLKDROP2(w[0]).value();
+				auto [drop2, rest2] = isBLKDROP2(w[1]).value();
+				// BLKDROP2 drop0, rest
+				// BLKDROP2 drop1, rest
+				// =>
+				// BLKDROP2 drop0+drop1, rest
+				if (rest1 == rest2 && drop1 + drop2 <= 15) {
+					return Result{2, makeBLKDROP2(drop1 + drop2, rest1)};
+				}
+				// BLKDROP2 drop1, rest1
+				// BLKDROP2 drop2, rest2
+				// =>
+				// BLKDROP2 drop1+drop2, rest1
+				if (rest1 == drop2 + rest2 && rest1 >= rest2) {
+					return Result{2, makeBLKDROP2(drop1 + drop2, rest2)};
+				}
+				return {};
+			}},
+			{{genOp({"NEWC"}), genOp({"ENDC"})}, [](PeepholeWindow const&) -> R {
+				return Result{2, makePUSHREF()};
+			}},
+			// LESS | LEQ    | GREATER | GEQ  | EQUAL | NEQ   | EQINT  | NEQINT | NOT | TRUE  | FALSE
+			// NOT
+			// =>
+			// GEQ | GREATER | LEQ     | LESS | NEQ   | EQUAL | NEQINT | EQINT  |     | FALSE | TRUE
+			{{genOp({"LESS", "LEQ", "GREATER", "GEQ", "EQUAL", "NEQ", "EQINT", "NEQINT", "NOT", "TRUE", "FALSE"}), genOp({"NOT"})},
+			[](PeepholeWindow const& w) -> R {
+				static std::map<std::string, std::string> const inverse{
+					{"LESS", "GEQ"}, {"LEQ", "GREATER"}, {"GREATER", "LEQ"}, {"GEQ", "LESS"},
+					{"EQUAL", "NEQ"}, {"NEQ", "EQUAL"}, {"TRUE", "FALSE"}, {"FALSE", "TRUE"}
+				};
+				auto cmd1 = to<GenOpcode>(w[0].get());
+				if (cmd1->opcode() == "EQINT") return Result{2, gen("NEQINT " + arg(w[0]))};
+				if (cmd1->opcode() == "NEQINT") return Result{2, gen("EQINT " + arg(w[0]))};
+				if (cmd1->opcode() == "NOT") return Result{2};
+				return Result{2, gen(inverse.at(cmd1->opcode()))};
+			}},
+			{{genOp({"UFITS", "FITS"}), genOp({"UFITS", "FITS"})}, [](PeepholeWindow const& w) -> R {
+				auto cmd1GenOp = to<GenOpcode>(w[0].get());
+				if (cmd1GenOp->opcode() == to<GenOpcode>(w[1].get())->opcode()) {
+					int bitSize = std::min(fetchInt(w[0]), fetchInt(w[1]));
+					return Result{2, gen(cmd1GenOp->opcode() + " " + toString(bitSize))};
+				}
+				return {};
+			}},
+			{{genOp({"TRUE", "FALSE"}), genOp({"STIR"})}, [](PeepholeWindow const& w) -> R {
+				if (fetchInt(w[1]) == 1) {
+					if (is(w[0], "FALSE"))
+						return Result{2, gen("STZERO")};
+					return Result{2, gen("STONE")};
+				}
+				return {};
+			}},
+			{{pushint, genOp({"STUR"})}, [](PeepholeWindow const& w) -> R {
+				if (pushintValue(w[0]) == 0) {
+					return Result{2,
+						gen("PUSHINT " + arg(w[1])),
+						gen("STZEROES")};
+				}
+				return {};
+			}},
+			{{genOp({"ABS"}), genOp({"UFITS"})}, [](PeepholeWindow const& w) -> R {
+				if (fetchInt(w[1]) == 256) return Result{2, gen("ABS")};
+				return {};
+			}},
+			{{pushint, genOp({"STZEROES"})}, [](PeepholeWindow const& w) -> R {
+				if (pushintValue(w[0]) == 1) return Result{2, gen("STZERO")};
+				return {};
+			}},
+			// REVERSE N, 1
+			// BLKSWAP N, 1
+			// =>
+			// REVERSE N+1, 0
+			{{reverse, blkSwap}, [](PeepholeWindow const& w) -> R {
+				auto [qty, index] = isREVERSE(w[0]).value();
+				auto [bottom, top] = isBLKSWAP(w[1]).value();
+				if (top == 1 && index == 1 && qty == bottom)
+					return Result{2, makeREVERSE(qty + 1, 0)};
+				return {};
+			}},
+			// REVERSE N+1, 0
+			// BLKDROP N
+			// =>
+			// BLKDROP2 N, 1
+			{{reverse, drop}, [](PeepholeWindow const& w) -> R {
+				auto [qty, index] = isREVERSE(w[0]).value();
+				int n = isDrop(w[1]).value();
+				if (n + 1 == qty && index == 0)
+					return Result{2, makeBLKDROP2(n, 1)};
+				return {};
+			}},
+			// ENDC
+			// STREFR
+			// =>
+			// STBREFR
+			{{genOp({"ENDC"}), genOp({"STREFR"})}, [](PeepholeWindow const&) -> R {
+				return Result{2, gen("STBREFR")};
+			}},
+			// s01
+			// XCHG S1, S2
+			// =>
+			// SWAP
+			// s01
+			{{pureGen01, stackOp({S::XCHG}, [](Pointer<TvmAstNode> const& c) { return isXCHG(c, 1, 2); })}, [](PeepholeWindow const& w) -> R {
+				return Result{2, makeBLKSWAP(1, 1), w[0]};
+			}},
+			// DUP
+			// PUSHCONT {
+			//   DROP
+			//   TRUE
+			// }
+			// IF
+			// =>
+			//
+			{{dup, kindOp(PeepholeMatcher::LogCircuitKey)}, [](PeepholeWindow const& w) -> R {
+				auto lc = to<LogCircuit>(w[1].get());
+				if (lc->type() == LogCircuit::Type::AND && lc->body()->instructions().size() == 2) {
+					auto cmd2_0 = lc->body()->instructions().at(0);
+					auto cmd2_1 = lc->body()->instructions().at(1);
+					auto _true = to<GenOpcode>(cmd2_1.get());
+					if (isDrop(cmd2_0) == 1 && _true && _true->opcode() == "TRUE") {
+						return Result{2};
+					}
+				}
+				return {};
+			}},
+			// TRUE
+			// AND
+			// =>
+			//
+			{{genOp({"TRUE"}), genOp({"AND"})}, [](PeepholeWindow const&) -> R {
+				return Result{2};
+			}},
+			// NULL
+			// ISNULL
+			// =>
+			// TRUE
+			{{genOp({"NULL"}), genOp({"ISNULL"})}, [](PeepholeWindow const&) -> R {
+				return Result{2, gen("TRUE")};
+			}},
+			// TRUE       / FALSE
+			// THROWIFNOT / THROWIF
+			// =>
+			//
+			{{genOp({"TRUE"}), exc("THROWIFNOT")}, [](PeepholeWindow const&) -> R {
+				return Result{2};
+			}},
+			{{genOp({"FALSE"}), exc("THROWIF")}, [](PeepholeWindow const&) -> R {
+				return Result{2};
+			}},
+			// PUSHINT N
+			// ISNULL
+			// =>
+			// FALSE
+			{{genOp({"PUSHINT"}), genOp({"ISNULL"})}, [](PeepholeWindow const&) -> R {
+				return Result{2, gen("FALSE")};
+			}},
+			// TRUE    / FALSE
+			// THROWIF / THROWIFNOT
+			// =>
+			//
+			{{genOp({"TRUE"}), exc("THROWIF")}, [](PeepholeWindow const& w) -> R {
+				return Result{2, makeTHROW("THROW " + to<TvmException>(w[1].get())->arg())};
+			}},
+			{{genOp({"FALSE"}), exc("THROWIFNOT")}, [](PeepholeWindow const& w) -> R {
+				return Result{2, makeTHROW("THROW " + to<TvmException>(w[1].get())->arg())};
+			}},
+			{{anyOp([](Pointer<TvmAstNode> const& c) {
+				auto cmd1GenOp = to<GenOpcode>(c.get());
+				return cmd1GenOp && cmd1GenOp->isPure() &&
+					std::make_pair(cmd1GenOp->take(), cmd1GenOp->ret()) == std::make_pair(1, 1);
+			}), drop}, [](PeepholeWindow const& w) -> R {
+				return Result{2, w[1]};
+			}},
+			// BLKPUSH N, 0 / DUP
+			// BLKPUSH Q, 0 / DUP
+			// =>
+			// BLKPUSH N+Q, 0
+			{{blkPush, blkPush}, [](PeepholeWindow const& w) -> R {
+				auto [qty0, index0] = isBLKPUSH(w[0]).value();
+				auto [qty1, index1] = isBLKPUSH(w[1]).value();
+				if (index0 == 0 && index1 == 0 && qty0 + qty1 <= 15)
+					return Result{2, makeBLKPUSH(qty0 + qty1, 0)};
+				return {};
+			}},
+			// LD[I|U] N / LDDICT / LDREF / LD[I|U]X N
+			// DROP
+			{{genOp({"LDU", "LDI", "LDREF", "LDDICT", "LDUX", "LDIX", "LDSLICE", "LDSLICEX"}), drop}, [](PeepholeWindow const& w) -> R {
+				// TODO add LD[I|U]LE[4|8]
+				int n = isDrop(w[1]).value();
+				Pointer<GenOpcode> newOpcode = gen("P" + to<GenOpcode>(w[0].get())->fullOpcode());
+				if (n == 1) {
+					return Result{2, newOpcode};
+				} else {
+					return Result{2, {newOpcode, makeDROP(n - 1)}};
+				}
+			}},
+
+			// NEW
+			// s01
+			// ST**R
+			// =>
+			// s01
+			// NEW
+			// ST**
+			{{genOp({"NEWC"}), anyOp([](Pointer<TvmAstNode> const& c) { return isSimpleCommand(c); }), storeR}, [](PeepholeWindow const& w) -> R {
+				const auto& opcode = to<GenOpcode>(w[2].get())->opcode();
+				return Result{3,
+							  w[1],
+							  gen("NEWC"),
+							  gen(opcode.substr(0, opcode.size() - 1) + " " + arg(w[2]))};
+			}},
+			// DUP
+			// THROWIFNOT 507
+			// DROP n
+			{{dup, kindOp(PeepholeMatcher::ExceptionKey), drop}, [](PeepholeWindow const& w) -> R {
+				if (isExc(w[1], "THROWIFNOT", "THROWIF")) {
+					int n = isDrop(w[2]).value();
+					if (n == 1) {
+						return Result{3, w[1]};
+					} else {
+						return Result{3, w[1], makeDROP(n - 1)};
+					}
+				}
+				return {};
+			}},
+			{{genOp({"NEWC"}), genOp({"STSLICECONST"}), genOp({"ENDC"})}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[1]).length() > 1) return Result{3, makePUSHREF(arg(w[1]))};
+				return {};
+			}},
+			// PUSHINT x
+			// PUSH Si (i!=0) or gen(0,1)
+			// CMP
+			// =>
+			// PUSH S(i-1) or gen(0,1)
+			// CMP2
+			{{
+				pushint,
+				anyOp([](Pointer<TvmAstNode> const& c) { return (isPUSH(c) && *isPUSH(c) != 0) || isPureGen01(*c); }),
+				genOp({"NEQ", "EQUAL", "GREATER", "LESS", "GEQ", "LEQ"})
+			}, [cmpInt](PeepholeWindow const& w) -> R {
+				auto newCmd2 = isPUSH(w[1]) ? makePUSH(*isPUSH(w[1]) - 1) : w[1];
+				bigint val = pushintValue(w[0]);
+				for (auto const& cmp : {
+					cmpInt("NEQ", "NEQINT", 0),
+					cmpInt("EQUAL", "EQINT", 0),
+					cmpInt("GREATER", "LESSINT", 0),
+					cmpInt("LESS", "GTINT", 0),
+					cmpInt("GEQ", "LESSINT", +1),
+					cmpInt("LEQ", "GTINT", -1)
+				}) {
+					if (Pointer<TvmAstNode> res = cmp(val, w[2]))
+						return Result{3, newCmd2, res};
+				}
+				return {};
+			}},
+			{{pushint, pushint, genOp({"MUL"})}, [](PeepholeWindow const& w) -> R {
+				bigint a = pushintValue(w[0]);
+				bigint b = pushintValue(w[1]);
+				bigint c = a * b;
+				return Result{3, gen("PUSHINT " + toString(c))};
+			}},
+			{{pushint, pushint, genOp({"DIV"})}, [](PeepholeWindow const& w) -> R {
+				bigint a = pushintValue(w[0]);
+				bigint b = pushintValue(w[1]);
+				if (a >= 0 && b > 0) { // note in TVM  -9 / 2 == -5
+					bigint c = a / b;
+					return Result{3, gen("PUSHINT " + toString(c))};
+				}
+				return {};
+			}},
+			// TRUE
+			// NEWC
+			// STI 1
+			{{genOp({"TRUE", "FALSE"}), genOp({"NEWC"}), genOp({"STI"})}, [](PeepholeWindow const& w) -> R {
+				if (arg(w[2]) == "1") {
+					if (is(w[0], "TRUE"))
+						return Result{3, gen("NEWC"), gen("STONE")};
+					return Result{3, gen("NEWC"), gen("STZERO")};
+				}
+				return {};
+			}},
+			{{blkSwap, pureGen01, blkSwap}, [](PeepholeWindow const& w) -> R {
+				auto [bottom1, top1] = isBLKSWAP(w[0]).value();
+				auto [bottom3, top3] = isBLKSWAP(w[2]).value();
+				if (bottom1 == 1 && bottom3 == 1 && top3 == 1) {
+					return Result{3, w[1], makeBLKSWAP(bottom1, top1 + 1)};
+				}
+				return {};
+			}},
+			{{genOp({"NULL"}), dup, genOp({"ISNULL"})}, [](PeepholeWindow const&) -> R {
+				return Result{3, gen("NULL"), gen("TRUE")};
+			}},
+			// gen(0, 1)
+			// BLKPUSH N, 0
+			// gen(0, 1)
+			// =>
+			// gen(0, 1)
+			// BLKPUSH N+1, 0
+			{{pureGen01, blkPush, pureGen01}, [](PeepholeWindow const& w) -> R {
+				if (*w[0] == *w[2]) {
+					auto [qty, index] = isBLKPUSH(w[1]).value();
+					if (index == 0 && qty + 1 <= 15) {
+						return Result{3, w[0], makeBLKPUSH(qty + 1, index)};
+					}
+				}
+				return {};
+			}},
+			//            ; a b
+			// SWAP       ; b a
+			// gen(0, 1)  ; b a c
+			// ROT        ; a c b
+			// =>
+			// gen(0,1)
+			// SWAP
+			{{swap, pureGen01, blkSwap}, [](PeepholeWindow const& w) -> R {
+				if (*isBLKSWAP(w[2]) == std::make_pair(1, 2)) {
+					return Result{3, w[1], makeXCH_S(1)};
+				}
+				return {};
+			}},
+			{{
+				kindOp(PeepholeMatcher::PushCellOrSliceKey),
+				kindOp(PeepholeMatcher::PushCellOrSliceKey),
+				kindOp(PeepholeMatcher::SubProgramKey)
+			}, [](PeepholeWindow const& w) -> R {
+				auto cmd1PushCellOrSlice = to<PushCellOrSlice>(w[0].get());
+				auto cmd2PushCellOrSlice = to<PushCellOrSlice>(w[1].get());
+				if (cmd1PushCellOrSlice->type() == PushCellOrSlice::Type::PUSHREF &&
+					cmd2PushCellOrSlice->type() == PushCellOrSlice::Type::PUSHREF
+				) {
+					std::vector<Pointer<TvmAstNode>> const& instructions = to<SubProgram>(w[2].get())->block()->instructions();
+					if (instructions.size() == 1 &&
+						*instructions.at(0) == *createNode<GenOpcode>(".inline __concatenateStrings_macro", 2, 1)) {
+						string hexStr = cmd1PushCellOrSlice->chainBlob() + cmd2PushCellOrSlice->chainBlob();
+						return Result{3, makePushCellOrSlice(hexStr, false)};
+					}
+				}
+				return {};
+			}},
+			// TODO delete, fix in stackOpt
+			// Note: breaking stack
+			// DUP
+			// IFREF { CALL $c7_to_c4$ / $upd_only_time_in_c4$ }
+			// =>
+			// IFREF { CALL $c7_to_c4$ / $upd_only_time_in_c4$ }
+			{{push, ifElse, anyOp()}, [](PeepholeWindow const& w) -> R {
+				auto ifRef = to<TvmIfElse>(w[1].get());
+				if (w.withUnpackOpaque() &&
+					!ifRef->withJmp() && !ifRef->withNot() && ifRef->falseBody() == nullptr
+				) {
+					std::vector<Pointer<TvmAstNode>> const &cmds = ifRef->trueBody()->instructions();
+					if (cmds.size() == 1) {
+						if (auto gen = to<GenOpcode>(cmds.at(0).get())) {
+							if (isIn(gen->fullOpcode(), ".inline __c7_to_c4", ".inline __upd_only_time_in_c4")) {
+								return Result{2, w[1]};
+							}
+						}
+					}
+				}
+				return {};
+			}},
+
+			{{pushint, genOp({"ADD", "SUB"}), pushint, genOp({"ADD", "SUB"})}, [](PeepholeWindow const& w) -> R {
+				bigint sum = 0;
+				sum += (is(w[1], "ADD") ? +1 : -1) * pushintValue(w[0]);
+				sum += (is(w[3], "ADD") ? +1 : -1) * pushintValue(w[2]);
+				return Result{4, gen("PUSHINT " + toString(sum)), gen("ADD")};
+			}},
+			{{plainPushSlice, genOp({"NEWC"}), genOp({"STSLICECONST"}), genOp({"STSLICE"})}, [](PeepholeWindow const& w) -> R {
+				std::optional<std::string> slice = StrUtils::unitSlices(arg(w[2]), isPlainPushSlice(w[0])->blob());
+				if (slice.has_value()) {
 					return Result{4,
-										   gen("ADDCONST " + std::to_string(final_add)),
-										   gen(fit + " " + arg(cmd2))};
-			}
-		}
-	}
-	if (isPUSHINT(cmd1) &&
-		is(cmd2, "NEWC") &&
-		is(cmd3, "STSLICECONST") &&
-		is(cmd4, "STU")) {
-		std::string bitStr = StrUtils::toBitString(arg(cmd3)) +
-			StrUtils::toBitString(pushintValue(cmd1), fetchInt(cmd4));
-		std::optional<std::string> slice = StrUtils::unitBitStringToHex(bitStr, "");
-		if (slice.has_value()) {
-			return Result{4,
-			  genPushSlice(*slice),
-				gen("NEWC"),
-				gen("STSLICE")};
-		}
-	}
-	if (
-		isPlainPushSlice(cmd1) &&
-		is(cmd2, "NEWC") &&
-		is(cmd3, "STSLICE") &&
-		is(cmd4, "ENDC")
-	) {
-		return Result{4, makePUSHREF(isPlainPushSlice(cmd1)->blob())};
-	}
-	if (isPUSHINT(cmd1) && pushintValue(cmd1) == 0 &&
-		is(cmd2, "STUR") &&
-		isPUSHINT(cmd3) && pushintValue(cmd3) == 0 &&
-		is(cmd4, "STUR")
-	) {
-		int bitSize = fetchInt(cmd2) + fetchInt(cmd4);
-		if (bitSize <= 256)
-			return Result{4, gen("PUSHINT 0"), gen("STUR " + toString(bitSize))};
-	}
-
-
-	// PUSHSLICE xXXX
-	// NEWC
-	// STSLICE
-	// STBREFR
-	// =>
-	// PUSHCELL
-	// STREFR
-	if (
-		isPlainPushSlice(cmd1) &&
-		is(cmd2, "NEWC") &&
-		is(cmd3, "STSLICE") &&
-		is(cmd4, "STBREFR")
-	) {
-		return Result{4, makePUSHREF(isPlainPushSlice(cmd1)->blob()), gen("STREFR")};
-	}
-
-	// DUP
-	// ISNULL
-	// THROWIF 63
-	// UNSINGLE
-	// =>
-	// UNSINGLE
-	if (
-		isPUSH(cmd1) && isPUSH(cmd1).value() == 0 &&
-		is(cmd2, "ISNULL") &&
-		cmd3Exc && cmd3Exc->opcode() == "THROWIF" && cmd3Exc->arg() == toString(TvmConst::RuntimeException::GetOptionalException) &&
-		is(cmd4, "UNTUPLE") && fetchInt(cmd4) == 1
-	) {
-		return Result{4, cmd4};
-	}
-
-	return {};
-}
-
-std::optional<Result> PrivatePeepholeOptimizer::optimizeAt5(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2,
-											 Pointer<TvmAstNode> const& cmd3, Pointer<TvmAstNode> const& cmd4,
-											 Pointer<TvmAstNode> const& cmd5) {
-	// PUSHSLICE A
-	// PUSHSLICE B
-	// NEWC
-	// STSLICE
-	// STSLICE
-	// =>
-	// PUSHSLICE BA
-	// NEWC
-	// STSLICE
-	if (isPlainPushSlice(cmd1) &&
-		isPlainPushSlice(cmd2) &&
-		is(cmd3, "NEWC") &&
-		is(cmd4, "STSLICE") &&
-		is(cmd5, "STSLICE")
-	) {
-		std::string bitStr = StrUtils::toBitString(isPlainPushSlice(cmd2)->blob()) +
-							 StrUtils::toBitString(isPlainPushSlice(cmd1)->blob());
-		std::optional<std::string> slice = StrUtils::unitBitStringToHex(bitStr, "");
-		if (slice.has_value()) {
-			return Result{5,
-						  genPushSlice(*slice),
-						  gen("NEWC"),
-						  gen("STSLICE")};
-		}
-	}
-
-	// PUSHINT ?
-	// PUSHSLICE ?
-	// NEWC
-	// STSLICE ?
-	// STU ?
-	if (isPUSHINT(cmd1) &&
-		isPlainPushSlice(cmd2) &&
-		is(cmd3, "NEWC") &&
-		is(cmd4, "STSLICE") &&
-		is(cmd5, "STU")
-	) {
-		std::string bitStr = StrUtils::toBitString(isPlainPushSlice(cmd2)->blob()) +
-			StrUtils::toBitString(pushintValue(cmd1), fetchInt(cmd5));
-		std::optional<std::string> slice = StrUtils::unitBitStringToHex(bitStr, "");
-		if (slice.has_value()) {
-			return Result{5,
-					genPushSlice(*slice),
-					gen("NEWC"),
-					gen("STSLICE")};
-		}
-	}
-	return {};
-}
+								  genPushSlice(*slice),
+								  gen("NEWC"),
+								  gen("STSLICE")};
+				}
+				return {};
+			}},
+			// ADDCONST/INC/DEC
+			// UFIT/FIT N
+			// ADDCONST/INC/DEC
+			// UFIT/FIT N
+			// =>
+			// ADDCONST
+			// UFIT/FIT N
+			{{constAdd, genOp({"UFITS", "FITS"}), constAdd, genOp({"UFITS", "FITS"})}, [](PeepholeWindow const& w) -> R {
+				for (std::string fit : {"UFITS", "FITS"}) {
+					if (is(w[1], fit) && is(w[3], fit) && arg(w[1]) == arg(w[3])) {
+						int final_add = getAddNum(w[0]) + getAddNum(w[2]);
+						if (-128 <= final_add && final_add <= 127)
+							return Result{4,
+								gen("ADDCONST " + std::to_string(final_add)),
+								gen(fit + " " + arg(w[1]))};
+					}
+				}
+				return {};
+			}},
+			{{pushint, genOp({"NEWC"}), genOp({"STSLICECONST"}), genOp({"STU"})}, [](PeepholeWindow const& w) -> R {
+				std::string bitStr = StrUtils::toBitString(arg(w[2])) +
+					StrUtils::toBitString(pushintValue(w[0]), fetchInt(w[3]));
+				std::optional<std::string> slice = StrUtils::unitBitStringToHex(bitStr, "");
+				if (slice.has_value()) {
+					return Result{4,
+						genPushSlice(*slice),
+						gen("NEWC"),
+						gen("STSLICE")};
+				}
+				return {};
+			}},
+			{{plainPushSlice, genOp({"NEWC"}), genOp({"STSLICE"}), genOp({"ENDC"})}, [](PeepholeWindow const& w) -> R {
+				return Result{4, makePUSHREF(isPlainPushSlice(w[0])->blob())};
+			}},
+			{{pushint, genOp({"STUR"}), pushint, genOp({"STUR"})}, [](PeepholeWindow const& w) -> R {
+				if (pushintValue(w[0]) == 0 && pushintValue(w[2]) == 0) {
+					int bitSize = fetchInt(w[1]) + fetchInt(w[3]);
+					if (bitSize <= 256)
+						return Result{4, gen("PUSHINT 0"), gen("STUR " + toString(bitSize))};
+				}
+				return {};
+			}},
+			// PUSHSLICE xXXX
+			// NEWC
+			// STSLICE
+			// STBREFR
+			// =>
+			// PUSHCELL
+			// STREFR
+			{{plainPushSlice, genOp({"NEWC"}), genOp({"STSLICE"}), genOp({"STBREFR"})}, [](PeepholeWindow const& w) -> R {
+				return Result{4, makePUSHREF(isPlainPushSlice(w[0])->blob()), gen("STREFR")};
+			}},
+			// DUP
+			// ISNULL
+			// THROWIF 63
+			// UNSINGLE
+			// =>
+			// UNSINGLE
+			{{dup, genOp({"ISNULL"}), exc("THROWIF"), genOp({"UNTUPLE"})}, [](PeepholeWindow const& w) -> R {
+				if (to<TvmException>(w[2].get())->arg() == toString(TvmConst::RuntimeException::GetOptionalException) &&
+					fetchInt(w[3]) == 1
+				) {
+					return Result{4, w[3]};
+				}
+				return {};
+			}},
 
-std::optional<Result> PrivatePeepholeOptimizer::optimizeAt6(Pointer<TvmAstNode> const& cmd1, Pointer<TvmAstNode> const& cmd2,
-											 Pointer<TvmAstNode> const& cmd3, Pointer<TvmAstNode> const& cmd4,
-											 Pointer<TvmAstNode> const& cmd5, Pointer<TvmAstNode> const& cmd6) {
-
-	if (
-		isPlainPushSlice(cmd1) &&
-		is(cmd2, "NEWC") &&
-		is(cmd3, "STSLICE") &&
-		is(cmd4, "NEWC") &&
-		is(cmd5, "STSLICECONST") &&
-		is(cmd6, "STB")
-	) {
-		std::string str1 = StrUtils::toBitString(isPlainPushSlice(cmd1)->blob());
-		std::string str5 = StrUtils::toBitString(arg(cmd5));
-		std::optional<std::string> slice = StrUtils::unitBitStringToHex(str5, str1);
-		if (slice.has_value()) {
-			return Result{6,
-						  genPushSlice(*slice),
-						  gen("NEWC"),
-						  gen("STSLICE")
-			};
-		}
-	}
-	return {};
+			// PUSHSLICE A
+			// PUSHSLICE B
+			// NEWC
+			// STSLICE
+			// STSLICE
+			// =>
+			// PUSHSLICE BA
+			// NEWC
+			// STSLICE
+			{{plainPushSlice, plainPushSlice, genOp({"NEWC"}), genOp({"STSLICE"}), genOp({"STSLICE"})}, [](PeepholeWindow const& w) -> R {
+				std::string bitStr = StrUtils::toBitString(isPlainPushSlice(w[1])->blob()) +
+									 StrUtils::toBitString(isPlainPushSlice(w[0])->blob());
+				std::optional<std::string> slice = StrUtils::unitBitStringToHex(bitStr, "");
+				if (slice.has_value()) {
+					return Result{5,
+								  genPushSlice(*slice),
+								  gen("NEWC"),
+								  gen("STSLICE")};
+				}
+				return {};
+			}},
+			// PUSHINT ?
+			// PUSHSLICE ?
+			// NEWC
+			// STSLICE ?
+			// STU ?
+			{{pushint, plainPushSlice, genOp({"NEWC"}), genOp({"STSLICE"}), genOp({"STU"})}, [](PeepholeWindow const& w) -> R {
+				std::string bitStr = StrUtils::toBitString(isPlainPushSlice(w[1])->blob()) +
+					StrUtils::toBitString(pushintValue(w[0]), fetchInt(w[4]));
+				std::optional<std::string> slice = StrUtils::unitBitStringToHex(bitStr, "");
+				if (slice.has_value()) {
+					return Result{5,
+							genPushSlice(*slice),
+							gen("NEWC"),
+							gen("STSLICE")};
+				}
+				return {};
+			}},
+
+			{{
+				plainPushSlice,
+				genOp({"NEWC"}),
+				genOp({"STSLICE"}),
+				genOp({"NEWC"}),
+				genOp({"STSLICECONST"}),
+				genOp({"STB"})
+			}, [](PeepholeWindow const& w) -> R {
+				std::string str1 = StrUtils::toBitString(isPlainPushSlice(w[0])->blob());
+				std::string str5 = StrUtils::toBitString(arg(w[4]));
+				std::optional<std::string> slice = StrUtils::unitBitStringToHex(str5, str1);
+				if (slice.has_value()) {
+					return Result{6,
+								  genPushSlice(*slice),
+								  gen("NEWC"),
+								  gen("STSLICE")
+					};
+				}
+				return {};
+			}},
+		};
+		return PeepholeMatcher{std::move(rules)};
+	}();
+	return matcher;
 }
 
 std::optional<Result> PrivatePeepholeOptimizer::optimizeAtInf(int idx1) const {
@@ -1908,38 +2142,6 @@ std::optional<Result> PrivatePeepholeOptimizer::optimizeAtInf(int idx1) const {
 	return {};
 }
 
-bool PrivatePeepholeOptimizer::hasRetOrJmp(TvmAstNode const* _node) {
-	if (auto opaque = to<Opaque>(_node)) {
-		for (Pointer<TvmAstNode> const& i : opaque->block()->instructions()) {
-			if (hasRetOrJmp(i.get())) {
-				return true;
-			}
-		}
-	}
-	if (auto cb = to<CodeBlock>(_node)) {
-		for (Pointer<TvmAstNode> const& i : cb->instructions()) {
-			if (hasRetOrJmp(i.get())) {
-				return true;
-			}
-		}
-	}
-	if (to<ReturnOrBreakOrCont>(_node)) {
-		return true;
-	}
-	if (to<TvmReturn>(_node)) {
-		return true;
-	}
-	if (auto sub = to<SubProgram>(_node)) {
-		if (sub->isJmp())
-			return true;
-	}
-	if (auto isElse = to<TvmIfElse>(_node)) {
-		if (isElse->withJmp())
-			return true;
-	}
-	return false;
-}
-
 std::optional<Result> PrivatePeepholeOptimizer::unsquash(bool _withUnpackOpaque, const int idx1) const {
 	auto c = get(idx1);
 	auto stack = to<Stack>(c.get());
@@ -2081,78 +2283,71 @@ void PrivatePeepholeOptimizer::updateLinesAndIndex(int idx1, const std::optional
 	solAssert(res, "");
 	if (res && res.value().removeQty > 0) {
 		solAssert(valid(idx1), "");
-		solAssert(!isLoc(m_instructions.at(idx1)), "");
+		solAssert(!isLoc(get(idx1)), "");
 		int lastInx = idx1;
 		for (int iter = 0; iter + 1 < res.value().removeQty; ++iter) {
 			lastInx = nextCommandLine(lastInx);
 			solAssert(valid(lastInx), "");
-			solAssert(!isLoc(m_instructions.at(lastInx)), "");
+			solAssert(!isLoc(get(lastInx)), "");
 		}
 
 		Pointer<TvmAstNode> locLine;
 		for (int i = idx1; i <= lastInx; ++i) {
-			if (isLoc(m_instructions.at(i))) {
-				locLine = m_instructions.at(i);
+			if (isLoc(get(i))) {
+				locLine = get(i);
 			}
 		}
 
-		// save opcodes after the peephole
-		std::vector<Pointer<TvmAstNode>> codeTail(m_instructions.begin() + lastInx + 1, m_instructions.end());
-		// delete the peephole and all after it
-		m_instructions.erase(m_instructions.begin() + idx1, m_instructions.end());
-		// insert new peephole
-		for (Pointer<TvmAstNode> const& inst : res.value().commands) {
-			m_instructions.emplace_back(inst);
-		}
-		// insert .loc if it presents
+		// replace the peephole in place, keeping the .loc if it presents
+		std::vector<Pointer<TvmAstNode>> peephole = res.value().commands;
 		if (locLine != nullptr) {
-			m_instructions.push_back(locLine);
+			peephole.push_back(locLine);
 		}
-		// insert the tail
-		m_instructions.insert(m_instructions.end(), codeTail.begin(), codeTail.end());
+		int const n = m_rest.size();
+		auto last = m_rest.erase(m_rest.begin() + (n - 1 - lastInx), m_rest.begin() + (n - idx1));
+		m_rest.insert(last, peephole.rbegin(), peephole.rend());
 	}
 }
 
 bool PrivatePeepholeOptimizer::optimize(const std::function<std::optional<Result>(int)> &f) {
-	int idx1 = 0;
-	while (idx1 < static_cast<int>(m_instructions.size()) && isLoc(m_instructions.at(idx1))) {
-		++idx1;
-	}
+	m_done.clear();
+	m_rest.assign(m_instructions.rbegin(), m_instructions.rend());
+	skipLocs();
 
 	bool didSomething = false;
-	while (valid(idx1)) {
-		solAssert(!isLoc(m_instructions.at(idx1)), "");
-		std::optional<Result> res = f(idx1);
+	while (!m_rest.empty()) {
+		solAssert(!isLoc(m_rest.back()), "");
+		std::optional<Result> res = f(0);
 		if (res) {
-			{
-//				std::cout << ">>>A\n";
-//				Printer p{std::cout};
-//				for (const auto &x: m_instructions) x->accept(p);
-//				std::cout << std::endl;
+			if (m_budget) {
+				if (m_budget->exhausted()) {
+					m_budget->refuse();
+					break;
+				}
+				m_budget->spend();
 			}
 			didSomething = true;
-			updateLinesAndIndex(idx1, res);
+			updateLinesAndIndex(0, res);
 			// step back to several commands
-			idx1 = std::min<int>(idx1, m_instructions.size() - 1);
-			idx1 = max(idx1, 0);
+			if (m_rest.empty() && !m_done.empty())
+				stepBack();
 			int cnt = 10;
-			while (cnt > 0 && idx1 > 0) {
-				--idx1;
-				if (!isLoc(m_instructions.at(idx1)))
+			while (cnt > 0 && !m_done.empty()) {
+				stepBack();
+				if (!isLoc(m_rest.back()))
 					--cnt;
 			}
-			while (idx1 < static_cast<int>(m_instructions.size()) && isLoc(m_instructions.at(idx1))) {
-				++idx1;
-			}
-
-//			std::cout << "<<<B\n";
-//			Printer p{std::cout};
-//			for (const auto& x : m_instructions) x->accept(p);
-//			std::cout << std::endl;
+			skipLocs();
 		} else {
-			idx1 = nextCommandLine(idx1);
+			stepForward();
+			skipLocs();
 		}
 	}
+
+	m_instructions = std::move(m_done);
+	m_instructions.insert(m_instructions.end(), m_rest.rbegin(), m_rest.rend());
+	m_done.clear();
+	m_rest.clear();
 	return didSomething;
 }
 
@@ -2309,10 +2504,19 @@ void PeepholeOptimizer::endVisit(CodeBlock &_node) {
 		return optimizer.unsquash(m_withUnpackOpaque, index);
 	});
 
+	// only the rewriting loop is budgeted, unsquash and squashPush are single linear passes
+	optimizer.setBudget(m_budget);
 	while (optimizer.optimize([&optimizer](int index){ return optimizer.optimizeAt(index); })) {}
+	optimizer.setBudget(nullptr);
 
 	optimizer.optimize([&optimizer](int index){ return optimizer.squashPush(index);});
 	_node.upd(optimizer.instructions());
 }
 
+bool PeepholeOptimizer::visit(Function &_node) {
+	if (m_budget)
+		m_budget->startFunction(_node.name());
+	return true;
+}
+
 } // end solidity::frontend
@@ -16,17 +16,20 @@
 
 #pragma once
 
+#include "OptimizerBudget.hpp"
 #include "TvmAstVisitor.hpp"
 
 namespace solidity::frontend {
 	class PeepholeOptimizer : public TvmAstVisitor {
 	public:
-		explicit PeepholeOptimizer(bool _withUnpackOpaque, bool _optimizeSlice)
-			: m_withUnpackOpaque{_withUnpackOpaque}, m_optimizeSlice{_optimizeSlice} {}
+		explicit PeepholeOptimizer(bool _withUnpackOpaque, bool _optimizeSlice, OptimizerBudget* _budget = nullptr)
+			: m_withUnpackOpaque{_withUnpackOpaque}, m_optimizeSlice{_optimizeSlice}, m_budget{_budget} {}
+		bool visit(Function &_node) override;
 		void endVisit(CodeBlock &_node) override;
 	private:
 		bool m_withUnpackOpaque{};
 		bool m_optimizeSlice{};
+		OptimizerBudget* m_budget{};
 	};
 } // end solidity::frontend
 
@@ -84,76 +84,76 @@ bool StackState::apply(Stack const &opcode) {
 	return ok;
 }
 
+struct StackOpcodeSquasher::Tables {
+	std::unordered_map<StackState, int8_t> dp;
+	std::unordered_map<StackState, std::pair<StackState, Pointer<Stack>>> prev;
+};
+
 int StackOpcodeSquasher::steps(StackState const& _state) {
-	if (m_dp.empty()) {
-		init();
-	}
-	auto it = m_dp.find(_state);
-	if (it == m_dp.end()) {
+	std::unordered_map<StackState, int8_t> const& dp = tables().dp;
+	auto it = dp.find(_state);
+	if (it == dp.end()) {
 		return -1;
 	}
 	return it->second;
 }
 
-std::unordered_map<StackState, int8_t> StackOpcodeSquasher::m_dp {};
-std::unordered_map<StackState, std::pair<StackState, Pointer<Stack>>> StackOpcodeSquasher::m_prev {};
-
-void StackOpcodeSquasher::init() {
-	std::vector<Pointer<Stack>> edges;
-	for (int down = 1; down < StackState::maxStackDepth; ++down) {
-		for (int up = 1; down + up < StackState::maxStackDepth; ++up) {
-			edges.emplace_back(std::make_shared<Stack>(Stack::Opcode::BLKSWAP, down, up));
+StackOpcodeSquasher::Tables const& StackOpcodeSquasher::tables() {
+	// initialization of a local static is thread-safe
+	static Tables const tables = []() {
+		std::vector<Pointer<Stack>> edges;
+		for (int down = 1; down < StackState::maxStackDepth; ++down) {
+			for (int up = 1; down + up < StackState::maxStackDepth; ++up) {
+				edges.emplace_back(std::make_shared<Stack>(Stack::Opcode::BLKSWAP, down, up));
+			}
 		}
-	}
-	for (int i = 0; i < StackState::maxStackDepth; ++i) {
-		for (int j = i + 1; j < StackState::maxStackDepth; ++j) {
-			edges.emplace_back(std::make_shared<Stack>(Stack::Opcode::XCHG, i, j));
+		for (int i = 0; i < StackState::maxStackDepth; ++i) {
+			for (int j = i + 1; j < StackState::maxStackDepth; ++j) {
+				edges.emplace_back(std::make_shared<Stack>(Stack::Opcode::XCHG, i, j));
+			}
 		}
-	}
-	for (int i = 0; i < StackState::maxStackDepth; ++i) {
-		for (int n = 2; i + n <= StackState::maxStackDepth; ++n) {
-			edges.emplace_back(std::make_shared<Stack>(Stack::Opcode::REVERSE, n, i));
+		for (int i = 0; i < StackState::maxStackDepth; ++i) {
+			for (int n = 2; i + n <= StackState::maxStackDepth; ++n) {
+				edges.emplace_back(std::make_shared<Stack>(Stack::Opcode::REVERSE, n, i));
+			}
 		}
-	}
 
-
-	//std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
-	StackState state;
-	m_dp[state] = 0;
-	std::deque<StackState> q;
-	q.push_back(state);
-	while (!q.empty()) {
-		state = q.front();
-		q.pop_front();
-		int8_t nextDp = m_dp.at(state) + 1;
-		if (nextDp == 4) {
-			break;
-		}
-		for (Pointer<Stack> const &e: edges) {
-			StackState nextState = state;
-			nextState.apply(*e.get());
-			auto it = m_dp.find(nextState);
-			if (it == m_dp.end()) {
-				m_dp.emplace_hint(it, nextState, nextDp);
-				m_prev.emplace(nextState, std::make_pair(state, e));
-				q.push_back(nextState);
+		Tables t;
+		StackState state;
+		t.dp[state] = 0;
+		std::deque<StackState> q;
+		q.push_back(state);
+		while (!q.empty()) {
+			state = q.front();
+			q.pop_front();
+			int8_t nextDp = t.dp.at(state) + 1;
+			if (nextDp == 4) {
+				break;
+			}
+			for (Pointer<Stack> const &e: edges) {
+				StackState nextState = state;
+				nextState.apply(*e.get());
+				auto it = t.dp.find(nextState);
+				if (it == t.dp.end()) {
+					t.dp.emplace_hint(it, nextState, nextDp);
+					t.prev.emplace(nextState, std::make_pair(state, e));
+					q.push_back(nextState);
+				}
 			}
 		}
-	}
-	//std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-	//std::cerr << "Time difference = " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "[ms]" << std::endl;
+		return t;
+	}();
+	return tables;
 }
 
-
 std::vector<Pointer<TvmAstNode>> StackOpcodeSquasher::recover(StackState state) {
 	std::vector<Pointer<TvmAstNode>> res;
 	StackState start;
 	while (state != start) {
-		std::pair<StackState, Pointer<Stack>> p = m_prev.at(state);
+		std::pair<StackState, Pointer<Stack>> const& p = tables().prev.at(state);
 		state = p.first;
 		res.push_back(p.second);
 	}
 	std::reverse(res.begin(), res.end());
 	return res;
 }
-
@@ -39,13 +39,11 @@ namespace solidity::frontend {
 	class StackOpcodeSquasher {
 	public:
 		static int steps(StackState const& _state);
-	private:
-		static void init();
-	public:
 		static std::vector<Pointer<TvmAstNode>> recover(StackState state);
 	private:
-		static std::unordered_map<StackState, int8_t> m_dp;
-		static std::unordered_map<StackState, std::pair<StackState, Pointer<Stack>>> m_prev;
+		// Built on the first use and read-only afterwards, so it's shared by all threads
+		struct Tables;
+		static Tables const& tables();
 	};
 } // end solidity::frontend
 
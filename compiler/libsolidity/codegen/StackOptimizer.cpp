@@ -96,42 +96,7 @@ bool StackOptimizer::visit(Glob &_node) {
 }
 
 bool StackOptimizer::visit(Stack &_node) {
-	int delta{};
-	switch (_node.opcode()) {
-		case Stack::Opcode::DROP:
-		case Stack::Opcode::BLKDROP2:
-			delta = - _node.i();
-			break;
-
-		case Stack::Opcode::POP_S:
-			delta = -1;
-			break;
-
-		case Stack::Opcode::BLKPUSH:
-			delta = _node.i();
-			break;
-		case Stack::Opcode::PUSH2_S:
-			delta = 2;
-			break;
-		case Stack::Opcode::PUSH3_S:
-			delta = 3;
-			break;
-		case Stack::Opcode::PUSH_S:
-			delta = 1;
-			break;
-
-		case Stack::Opcode::BLKSWAP:
-		case Stack::Opcode::REVERSE:
-		case Stack::Opcode::XCHG:
-			break;
-
-		case Stack::Opcode::TUCK:
-		case Stack::Opcode::PUXC:
-		case Stack::Opcode::XCPU:
-			delta = 1;
-			break;
-	}
-	this->delta(delta);
+	delta(stackDelta(_node));
 	return false;
 }
 
@@ -139,7 +104,18 @@ bool StackOptimizer::visit(CodeBlock &_node) {
 	std::vector<Pointer<TvmAstNode>> instructions = _node.instructions();
 
 	for (size_t i = 0; i < instructions.size(); ) {
-		if (successfullyUpdate(i, instructions)) {
+		bool updated = false;
+		if (!m_budget || !m_budget->exhausted()) {
+			updated = successfullyUpdate(i, instructions);
+			if (updated && m_budget)
+				m_budget->spend();
+		} else if (!m_budget->isStopped()) {
+			// the rewrite is refused, it's tried on a copy only to report the function
+			std::vector<Pointer<TvmAstNode>> copy = instructions;
+			if (successfullyUpdate(i, copy))
+				m_budget->refuse();
+		}
+		if (updated) {
 			m_didSome = true;
 
 			//Printer p{std::cout};
@@ -275,6 +251,8 @@ bool StackOptimizer::visit(Function &f) {
 		case Function::FunctionType::OnCodeUpgrade:
 		case Function::FunctionType::OnTickTock: {
 			if (f.name() != "c7_to_c4_for_await") {
+				if (m_budget)
+					m_budget->startFunction(f.name());
 				for (int iter = 0; iter < TvmConst::IterStackOptQty; ++iter) {
 					m_didSome = false;
 					m_stackSize.clear();
@@ -319,6 +297,9 @@ bool StackOptimizer::successfullyUpdate(int index, std::vector<Pointer<TvmAstNod
 	if (to<Loc>(op.get()))
 		return false;
 
+	if (hoistBranchShuffles(index, instructions) || hoistLoopShuffles(index, instructions))
+		return true;
+
 	auto stack = to<Stack>(op.get());
 	bool cmd1IsPUSH= stack && stack->opcode() == Stack::Opcode::PUSH_S;
 	bool ok = false;
@@ -486,6 +467,261 @@ bool StackOptimizer::successfullyUpdate(int index, std::vector<Pointer<TvmAstNod
 }
 
 
+// Stack shuffles that both branches of IFELSE start or finish with are moved out of the branches.
+// Then they are optimized together with the code around IFELSE.
+bool StackOptimizer::hoistBranchShuffles(int index, std::vector<Pointer<TvmAstNode>>& instructions) {
+	auto ifElse = to<TvmIfElse>(instructions.at(index).get());
+	if (!ifElse || ifElse->falseBody() == nullptr)
+		return false;
+
+	auto firstOp = [](std::vector<Pointer<TvmAstNode>> const& inst) {
+		return std::find_if(inst.begin(), inst.end(), [](Pointer<TvmAstNode> const& op) {
+			return to<Loc>(op.get()) == nullptr;
+		});
+	};
+	auto lastOp = [](std::vector<Pointer<TvmAstNode>> const& inst) {
+		auto it = std::find_if(inst.rbegin(), inst.rend(), [](Pointer<TvmAstNode> const& op) {
+			return to<Loc>(op.get()) == nullptr;
+		});
+		return it == inst.rend() ? inst.end() : std::prev(it.base());
+	};
+	auto erase = [](Pointer<CodeBlock> const& block, std::vector<Pointer<TvmAstNode>>::const_iterator it) {
+		std::vector<Pointer<TvmAstNode>> inst = block->instructions();
+		inst.erase(inst.begin() + (it - block->instructions().begin()));
+		return createNode<CodeBlock>(block->type(), inst);
+	};
+
+	std::vector<Pointer<TvmAstNode>> const& t = ifElse->trueBody()->instructions();
+	std::vector<Pointer<TvmAstNode>> const& f = ifElse->falseBody()->instructions();
+
+	// PUSHCONT { DROP N; ... }
+	// PUSHCONT { DROP N; ... }
+	// IFELSE
+	// =>
+	// BLKDROP2 N, 1 ; condition stays on the top
+	// PUSHCONT { ... }
+	// PUSHCONT { ... }
+	// IFELSE
+	{
+		auto tFirst = firstOp(t);
+		auto fFirst = firstOp(f);
+		if (tFirst != t.end() && fFirst != f.end() && **tFirst == **fFirst &&
+			isDrop(*tFirst) && isDrop(*tFirst).value() <= 15
+		) {
+			int n = isDrop(*tFirst).value();
+			// the branches don't drop N values anymore, so they leave N more values than before
+			auto newIfElse = createNode<TvmIfElse>(ifElse->withNot(), ifElse->withJmp(),
+				erase(ifElse->trueBody(), tFirst), erase(ifElse->falseBody(), fFirst), ifElse->ret() + n);
+			instructions.at(index) = newIfElse;
+			instructions.insert(instructions.begin() + index, makeBLKDROP2(n, 1));
+			return true;
+		}
+	}
+
+	// PUSHCONT { ...; X }
+	// PUSHCONT { ...; X }
+	// IFELSE
+	// =>
+	// PUSHCONT { ... }
+	// PUSHCONT { ... }
+	// IFELSE
+	// X
+	if (!ifElse->withJmp() &&
+		!hasRetOrJmp(ifElse->trueBody().get()) &&
+		!hasRetOrJmp(ifElse->falseBody().get())
+	) {
+		auto tLast = lastOp(t);
+		auto fLast = lastOp(f);
+		if (tLast != t.end() && fLast != f.end() && **tLast == **fLast) {
+			auto stack = to<Stack>(tLast->get());
+			if (stack && ifElse->ret() - stackDelta(*stack) >= 0) {
+				Pointer<TvmAstNode> shuffle = *tLast;
+				auto newIfElse = createNode<TvmIfElse>(ifElse->withNot(), false,
+					erase(ifElse->trueBody(), tLast), erase(ifElse->falseBody(), fLast),
+					ifElse->ret() - stackDelta(*stack));
+				instructions.at(index) = newIfElse;
+				instructions.insert(instructions.begin() + index + 1, shuffle);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// A loop body that starts with a stack permutation and finishes with the inverse one works
+// with the permuted layout, and every iteration restores the layout that the next one permutes again.
+// The permutation is done once before the loop and undone once after it instead.
+bool StackOptimizer::hoistLoopShuffles(int index, std::vector<Pointer<TvmAstNode>>& instructions) {
+	Pointer<CodeBlock> body;
+	Pointer<CodeBlock> condition;
+	auto repeat = to<TvmRepeat>(instructions.at(index).get());
+	auto _while = to<While>(instructions.at(index).get());
+	if (repeat && !repeat->withBreakOrReturn()) {
+		body = repeat->body();
+	} else if (_while && !_while->isInfinite() && !_while->withBreakOrReturn()) {
+		body = _while->body();
+		condition = _while->condition();
+	} else {
+		return false;
+	}
+	// `continue` leaves the body without the inverse permutation
+	if (hasRetOrJmp(body.get()))
+		return false;
+
+	std::vector<Pointer<TvmAstNode>> const& inst = body->instructions();
+	auto first = std::find_if(inst.begin(), inst.end(), [](Pointer<TvmAstNode> const& op) {
+		return !isLoc(op);
+	});
+	auto lastRev = std::find_if(inst.rbegin(), inst.rend(), [](Pointer<TvmAstNode> const& op) {
+		return !isLoc(op);
+	});
+	if (first == inst.end() || std::prev(lastRev.base()) <= first)
+		return false;
+	auto last = std::prev(lastRev.base());
+	auto perm = to<Stack>(first->get());
+	auto inverse = to<Stack>(last->get());
+	if (!perm || !inverse || perm->opcode() != inverse->opcode())
+		return false;
+
+	// the least moved position and the permutation applied under the REPEAT count
+	int lo{};
+	Pointer<TvmAstNode> underCount;
+	switch (perm->opcode()) {
+		case Stack::Opcode::XCHG:
+			if (!(*perm == *inverse))
+				return false;
+			lo = std::min(perm->i(), perm->j());
+			if (std::max(perm->i(), perm->j()) + 1 <= 15)
+				underCount = makeXCH_S_S(perm->i() + 1, perm->j() + 1);
+			break;
+		case Stack::Opcode::REVERSE:
+			if (!(*perm == *inverse))
+				return false;
+			lo = perm->j();
+			if (perm->j() + 1 <= 15)
+				underCount = makeREVERSE(perm->i(), perm->j() + 1);
+			break;
+		case Stack::Opcode::BLKSWAP:
+			if (std::make_pair(perm->i(), perm->j()) != std::make_pair(inverse->j(), inverse->i()))
+				return false;
+			lo = 0;
+			break;
+		default:
+			return false;
+	}
+
+	std::vector<Pointer<TvmAstNode>> newInst = inst;
+	newInst.erase(newInst.begin() + (last - inst.begin()));
+	newInst.erase(newInst.begin() + (first - inst.begin()));
+	auto newBody = createNode<CodeBlock>(body->type(), newInst);
+
+	Pointer<TvmAstNode> before;
+	Pointer<TvmAstNode> loop;
+	if (repeat) {
+		// PUSHCONT { P; ...; P^-1 } REPEAT  =>  P'; PUSHCONT { ... } REPEAT; P^-1
+		// P' is P for the values under the count
+		if (!underCount)
+			return false;
+		before = underCount;
+		loop = createNode<TvmRepeat>(false, newBody);
+	} else {
+		// the condition runs on the permuted layout now, so it must not touch the moved values
+		std::optional<int> deepest = deepestTouched(condition->instructions());
+		if (!deepest || *deepest >= lo)
+			return false;
+		before = *first;
+		loop = createNode<While>(false, false, condition, newBody);
+	}
+	instructions.at(index) = loop;
+	instructions.insert(instructions.begin() + index + 1, *last);
+	instructions.insert(instructions.begin() + index, before);
+	return true;
+}
+
+// The deepest position of the stack before the code that the code reads or changes,
+// -1 if it touches only the values it pushes. nullopt if it's unknown
+std::optional<int> StackOptimizer::deepestTouched(std::vector<Pointer<TvmAstNode>> const& inst) {
+	int res = -1;
+	int pushed = 0;
+	for (Pointer<TvmAstNode> const& op : inst) {
+		if (isLoc(op))
+			continue;
+		int touched = -1;
+		int delta = 0;
+		if (auto stack = to<Stack>(op.get())) {
+			int const i = stack->i();
+			int const j = stack->j();
+			int const k = stack->k();
+			switch (stack->opcode()) {
+				case Stack::Opcode::DROP: touched = i - 1; break;
+				case Stack::Opcode::BLKDROP2: touched = i + j - 1; break;
+				case Stack::Opcode::POP_S: touched = i; break;
+				case Stack::Opcode::BLKPUSH: touched = j; break;
+				case Stack::Opcode::PUSH2_S: touched = std::max(i, j); break;
+				case Stack::Opcode::PUSH3_S: touched = std::max({i, j, k}); break;
+				case Stack::Opcode::PUSH_S: touched = i; break;
+				case Stack::Opcode::BLKSWAP: touched = i + j - 1; break;
+				case Stack::Opcode::REVERSE: touched = i + j - 1; break;
+				case Stack::Opcode::XCHG: touched = std::max(i, j); break;
+				case Stack::Opcode::TUCK: touched = 1; break;
+				case Stack::Opcode::PUXC:
+				case Stack::Opcode::XCPU: touched = std::max(i, j) + 1; break;
+			}
+			delta = stackDelta(*stack);
+		} else if (to<GenOpcode>(op.get()) || to<Glob>(op.get()) || to<PushCellOrSlice>(op.get())) {
+			auto gen = to<Gen>(op.get());
+			touched = gen->take() - 1;
+			delta = gen->ret() - gen->take();
+		} else {
+			// nested code may read any value of the stack
+			return std::nullopt;
+		}
+		res = std::max(res, touched - pushed);
+		pushed += delta;
+	}
+	return res;
+}
+
+int StackOptimizer::stackDelta(Stack const& _node) {
+	int delta{};
+	switch (_node.opcode()) {
+		case Stack::Opcode::DROP:
+		case Stack::Opcode::BLKDROP2:
+			delta = - _node.i();
+			break;
+
+		case Stack::Opcode::POP_S:
+			delta = -1;
+			break;
+
+		case Stack::Opcode::BLKPUSH:
+			delta = _node.i();
+			break;
+		case Stack::Opcode::PUSH2_S:
+			delta = 2;
+			break;
+		case Stack::Opcode::PUSH3_S:
+			delta = 3;
+			break;
+		case Stack::Opcode::PUSH_S:
+			delta = 1;
+			break;
+
+		case Stack::Opcode::BLKSWAP:
+		case Stack::Opcode::REVERSE:
+		case Stack::Opcode::XCHG:
+			break;
+
+		case Stack::Opcode::TUCK:
+		case Stack::Opcode::PUXC:
+		case Stack::Opcode::XCPU:
+			delta = 1;
+			break;
+	}
+	return delta;
+}
+
 void StackOptimizer::initStack(int size) {
 	solAssert(m_stackSize.empty(), "");
 	m_stackSize.emplace_back(size);
@@ -16,11 +16,13 @@
 
 #pragma once
 
+#include <libsolidity/codegen/OptimizerBudget.hpp>
 #include <libsolidity/codegen/TvmAstVisitor.hpp>
 
 namespace solidity::frontend {
 	class StackOptimizer : public TvmAstVisitor {
 	public:
+		explicit StackOptimizer(OptimizerBudget* _budget = nullptr) : m_budget{_budget} {}
 		bool visit(DeclRetFlag &_node) override;
 		bool visit(Opaque &_node) override;
 		bool visit(HardCode &_node) override;
@@ -48,6 +50,10 @@ namespace solidity::frontend {
 		void endVisitNode(TvmAstNode const&) override;
 	private:
 		bool successfullyUpdate(int index, std::vector<Pointer<TvmAstNode>>& instructions);
+		static bool hoistBranchShuffles(int index, std::vector<Pointer<TvmAstNode>>& instructions);
+		static bool hoistLoopShuffles(int index, std::vector<Pointer<TvmAstNode>>& instructions);
+		static std::optional<int> deepestTouched(std::vector<Pointer<TvmAstNode>> const& inst);
+		static int stackDelta(Stack const& _node);
 		void initStack(int size);
 		void delta(int delta);
 		int size();
@@ -57,6 +63,7 @@ namespace solidity::frontend {
 	private:
 		bool m_didSome{};
 		std::vector<int> m_stackSize;
+		OptimizerBudget* m_budget{};
 	};
 } // end solidity::frontend
 
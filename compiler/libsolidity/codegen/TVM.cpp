@@ -21,9 +21,35 @@
 using namespace std;
 using namespace solidity::frontend;
 
-solidity::langutil::ErrorReporter* GlobalParams::g_errorReporter{};
-solidity::langutil::CharStreamProvider* GlobalParams::g_charStreamProvider{};
-solidity::util::SetOnce<solidity::langutil::TVMVersion> GlobalParams::g_tvmVersion{};
+thread_local solidity::langutil::ErrorReporter* GlobalParams::g_errorReporter{};
+thread_local solidity::langutil::CharStreamProvider* GlobalParams::g_charStreamProvider{};
+thread_local solidity::langutil::TVMVersion GlobalParams::g_tvmVersion{};
+thread_local solidity::frontend::BranchProfile const* GlobalParams::g_branchProfile{};
+thread_local solidity::frontend::OptimizerLimits GlobalParams::g_optimizerLimits{};
+thread_local unsigned GlobalParams::g_optimizationLevel{2};
+thread_local bool GlobalParams::g_packStateVariables{};
+
+GlobalParams::Values GlobalParams::values() {
+	return {
+		g_errorReporter,
+		g_charStreamProvider,
+		g_tvmVersion,
+		g_branchProfile,
+		g_optimizerLimits,
+		g_optimizationLevel,
+		g_packStateVariables
+	};
+}
+
+void GlobalParams::setValues(Values const& _values) {
+	g_errorReporter = _values.errorReporter;
+	g_charStreamProvider = _values.charStreamProvider;
+	g_tvmVersion = _values.tvmVersion;
+	g_branchProfile = _values.branchProfile;
+	g_optimizerLimits = _values.optimizerLimits;
+	g_optimizationLevel = _values.optimizationLevel;
+	g_packStateVariables = _values.packStateVariables;
+}
 
 std::string getPathToFiles(
 	const std::string& solFileName,
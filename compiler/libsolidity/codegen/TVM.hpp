@@ -21,13 +21,46 @@
 #include <liblangutil/TVMVersion.h>
 #include <libsolidity/ast/ASTForward.h>
 #include <liblangutil/CharStreamProvider.h>
-#include <libsolutil/SetOnce.h>
+#include <libsolidity/codegen/BranchProfile.hpp>
+#include <libsolidity/codegen/OptimizerBudget.hpp>
 
+// Settings of the compilation that runs in the current thread, they are set by CompilerStack.
+// Thread-local, so that several CompilerStack instances may compile in parallel threads.
+// Worker threads of a compilation get them from the thread that runs it, see Scope.
 class GlobalParams {
 public:
-	static solidity::langutil::ErrorReporter* g_errorReporter;
-	static solidity::langutil::CharStreamProvider* g_charStreamProvider;
-	static solidity::util::SetOnce<solidity::langutil::TVMVersion> g_tvmVersion;
+	struct Values {
+		solidity::langutil::ErrorReporter* errorReporter{};
+		solidity::langutil::CharStreamProvider* charStreamProvider{};
+		solidity::langutil::TVMVersion tvmVersion{};
+		solidity::frontend::BranchProfile const* branchProfile{};
+		solidity::frontend::OptimizerLimits optimizerLimits{};
+		unsigned optimizationLevel{2};
+		bool packStateVariables{};
+	};
+
+	// Settings of the current thread
+	static Values values();
+	static void setValues(Values const& _values);
+
+	// Applies the settings to the current thread while it exists and restores the previous ones
+	class Scope {
+	public:
+		explicit Scope(Values const& _values) : m_previous{values()} { setValues(_values); }
+		~Scope() { setValues(m_previous); }
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+	private:
+		Values m_previous;
+	};
+
+	static thread_local solidity::langutil::ErrorReporter* g_errorReporter;
+	static thread_local solidity::langutil::CharStreamProvider* g_charStreamProvider;
+	static thread_local solidity::langutil::TVMVersion g_tvmVersion;
+	static thread_local solidity::frontend::BranchProfile const* g_branchProfile;
+	static thread_local solidity::frontend::OptimizerLimits g_optimizerLimits;
+	static thread_local unsigned g_optimizationLevel;
+	static thread_local bool g_packStateVariables;
 };
 
 std::string getPathToFiles(
@@ -205,7 +205,7 @@ Json::Value TVMABI::generateABIJson(
 			fields.append(field);
 		}
 
-		for (VariableDeclaration const* stateVar : ctx.notConstantStateVariables()) {
+		for (VariableDeclaration const* stateVar : ctx.storedStateVariables()) {
 			Json::Value cur = setupNameTypeComponents(stateVar->name(), stateVar->type());
 			fields.append(cur);
 		}
@@ -272,12 +272,10 @@ std::vector<const FunctionDefinition *> TVMABI::publicFunctions(ContractDefiniti
 	if (auto main_constr = contract.constructor(); main_constr != nullptr)
 		publicFunctions.push_back(contract.constructor());
 
-	for (auto c : contract.annotation().linearizedBaseContracts) {
-		for (const auto &_function : c->definedFunctions()) {
-			if (!_function->isConstructor() && _function->isPublic() &&
-				!_function->isReceive() && !_function->isFallback() && !_function->isOnBounce() && !_function->isOnTickTock())
-				publicFunctions.push_back(_function);
-		}
+	for (const auto &_function : contract.linearizedDefinedFunctions()) {
+		if (!_function->isConstructor() && _function->isPublic() &&
+			!_function->isReceive() && !_function->isFallback() && !_function->isOnBounce() && !_function->isOnTickTock())
+			publicFunctions.push_back(_function);
 	}
 	return publicFunctions;
 }
@@ -624,31 +622,49 @@ void ChainDataDecoder::decodePublicFunctionParameters(
 	bool isResponsible,
 	bool isInternal
 ) {
-	if (isInternal) {
-		DecodePositionAbiV2 position{minBits(isResponsible), 0, types};
-		decodeParameters(types, position);
-	} else {
-		DecodePositionAbiV2 position{maxBits(isResponsible), 0, types};
-		decodeParameters(types, position);
+	decodePublicFunctionParameters(types, isResponsible, isInternal, static_cast<int>(types.size()));
+}
+
+void ChainDataDecoder::decodePublicFunctionParameters(
+	const std::vector<Type const*>& types,
+	bool isResponsible,
+	bool isInternal,
+	int decodedQty
+) {
+	solAssert(0 <= decodedQty && decodedQty <= static_cast<int>(types.size()), "");
+	// position is built for all types so that cell boundaries are the same as in encoder
+	DecodePositionAbiV2 position{isInternal ? minBits(isResponsible) : maxBits(isResponsible), 0, types};
+	std::vector<Type const*> decodedTypes{types.begin(), types.begin() + decodedQty};
+	decodeParameters(decodedTypes, position);
+	for (int i = decodedQty; i < static_cast<int>(types.size()); ++i) {
+		skipParameter(types.at(i), &position);
 	}
 	*pusher << "ENDS";
 }
 
 void ChainDataDecoder::decodeFunctionParameters(const std::vector<Type const*>& types, bool isResponsible) {
+	decodeFunctionParameters(types, isResponsible, static_cast<int>(types.size()));
+}
+
+void ChainDataDecoder::decodeFunctionParameters(
+	const std::vector<Type const*>& types,
+	bool isResponsible,
+	int decodedQty
+) {
 	pusher->startOpaque();
 	pusher->pushS(1);
 	pusher->fixStack(-1); // fix stack
 
 	pusher->startContinuation();
-	decodePublicFunctionParameters(types, isResponsible, false);
+	decodePublicFunctionParameters(types, isResponsible, false, decodedQty);
 	pusher->endContinuation();
 
 	pusher->startContinuation();
-	decodePublicFunctionParameters(types, isResponsible, true);
+	decodePublicFunctionParameters(types, isResponsible, true, decodedQty);
 	pusher->endContinuation();
 
 	pusher->ifElse();
-	pusher->endOpaque(1, types.size());
+	pusher->endOpaque(1, decodedQty);
 }
 
 void ChainDataDecoder::decodeData(int offset, int usedRefs, const std::vector<Type const*>& types) {
@@ -754,6 +770,29 @@ void ChainDataDecoder::decodeParameter(Type const* type, DecodePosition* positio
 	}
 }
 
+void ChainDataDecoder::skipParameter(Type const* type, DecodePosition* position) {
+	// stack: slice
+	if (auto structType = to<StructType>(type)) {
+		for (const ASTPointer<VariableDeclaration> &m : structType->structDefinition().members()) {
+			skipParameter(m->type(), position);
+		}
+	} else if (auto userDefType = to<UserDefinedValueType>(type)) {
+		skipParameter(&userDefType->underlyingType(), position);
+	} else if ((isIntegralType(type) && !to<EnumType>(type)) || to<FunctionType>(type)) {
+		loadNextSliceIfNeed(position->loadNextCell(type));
+		pusher->pushInt(ABITypeSize{type}.maxBits);
+		*pusher << "SDSKIPFIRST";
+	} else if (to<TvmCellType>(type) || isStringOrStringLiteralOrBytes(type)) {
+		loadNextSliceIfNeed(position->loadNextCell(type));
+		*pusher << "LDREF";
+		pusher->dropUnder(1, 1);
+	} else {
+		// variable size or the value must be checked (e.g. enum)
+		decodeParameter(type, position);
+		pusher->dropUnder(1, 1);
+	}
+}
+
 void ChainDataDecoder::decodeParameterQ(Type const* type, DecodePosition* position, int ind) {
 	const Type::Category category = type->category();
 	if (/*auto structType =*/ to<StructType>(type)) {
@@ -825,30 +864,41 @@ std::pair<uint32_t, bool> ChainDataEncoder::calculateFunctionID(const CallableDe
 	if (functionDefinition != nullptr && functionDefinition->functionID().has_value()) {
 		return {functionDefinition->functionID().value(), true};
 	}
+	return {signatureHash(declaration, false), false};
+}
+
+uint32_t ChainDataEncoder::signatureHash(const CallableDeclaration *declaration, bool isLib) {
+	std::optional<uint32_t>& hash = declaration->annotation().signatureHash[isLib];
+	if (hash) {
+		return *hash;
+	}
 
-	std::string name;
-	if (functionDefinition != nullptr && functionDefinition->isConstructor())
-		name = "constructor";
-	else
-		name = declaration->name();
+	std::string name = declaration->name();
+	bool isResponsible{};
+	if (auto f = to<FunctionDefinition>(declaration)) {
+		if (f->isConstructor()) {
+			name = "constructor";
+		}
+		isResponsible = f->isResponsible();
+	}
 
-	std::vector<VariableDeclaration const*> tmpRet;
-	std::vector<VariableDeclaration const*>* ret = nullptr;
+	std::vector<VariableDeclaration const*> outputs;
+	std::vector<VariableDeclaration const*>* retParams = nullptr;
 	if (declaration->returnParameterList()) {
-		tmpRet = convertArray(declaration->returnParameters());
-		ret = &tmpRet;
+		outputs = convertArray(declaration->returnParameters());
+		retParams = &outputs;
 	}
 
-	std::vector<Type const*> inputTypes = getTypesFromVarDecls(declaration->parameters());
-	if (functionDefinition->isResponsible()) {
-		inputTypes.insert(inputTypes.begin(), TypeProvider::uint(32));
+	std::vector<Type const*> inputs = getTypesFromVarDecls(declaration->parameters());
+	if (isLib) {
+		inputs.erase(inputs.begin(), inputs.begin() + 1);
+	}
+	if (isResponsible) {
+		inputs.insert(inputs.begin(), TypeProvider::uint(32));
 	}
-	uint32_t id = calculateFunctionID(
-			name,
-			inputTypes,
-			ret
-	);
-	return {id, false};
+
+	hash = calculateFunctionID(name, inputs, retParams);
+	return *hash;
 }
 
 uint32_t ChainDataEncoder::toHash256(std::string const& str) {
@@ -905,32 +955,12 @@ uint32_t ChainDataEncoder::calculateFunctionIDWithReason(
 		const ReasonOfOutboundMessage &reason,
 		bool isLib
 ) {
-	std::vector<VariableDeclaration const*> outputs;
-	std::vector<VariableDeclaration const*>* retParams = nullptr;
-	if (funcDef->returnParameterList()) {
-		outputs = convertArray(funcDef->returnParameters());
-		retParams = &outputs;
-	}
-	std::optional<uint32_t> functionId;
-	std::string name = funcDef->name();
 	if (auto f = to<FunctionDefinition>(funcDef)) {
-		functionId = f->functionID();
-		if (f->isConstructor()) {
-			name = "constructor";
+		if (f->functionID().has_value()) {
+			return f->functionID().value();
 		}
 	}
-
-	bool isResponsible{};
-	if (auto fd = to<FunctionDefinition>(funcDef)) {
-		isResponsible = fd->isResponsible();
-	}
-
-	std::vector<Type const*> input = getTypesFromVarDecls(funcDef->parameters());
-	if (isLib) {
-		input.erase(input.begin(), input.begin() + 1);
-	}
-
-	return calculateFunctionIDWithReason(name, input, retParams, reason, functionId, isResponsible);
+	return applyReason(signatureHash(funcDef, isLib), reason);
 }
 
 uint32_t ChainDataEncoder::calculateFunctionIDWithReason(
@@ -949,16 +979,20 @@ uint32_t ChainDataEncoder::calculateFunctionIDWithReason(
 	if (isManuallyOverridden) {
 		funcID = functionId.value();
 	} else {
-		funcID = calculateFunctionID(name, inputs, outputs);
-		switch (reason) {
-			case ReasonOfOutboundMessage::FunctionReturnExternal:
-				funcID |= 0x80000000;
-				break;
-			case ReasonOfOutboundMessage::EmitEventExternal:
-			case ReasonOfOutboundMessage::RemoteCallInternal:
-				funcID &= 0x7FFFFFFFu;
-				break;
-		}
+		funcID = applyReason(calculateFunctionID(name, inputs, outputs), reason);
+	}
+	return funcID;
+}
+
+uint32_t ChainDataEncoder::applyReason(uint32_t funcID, const ReasonOfOutboundMessage &reason) {
+	switch (reason) {
+		case ReasonOfOutboundMessage::FunctionReturnExternal:
+			funcID |= 0x80000000;
+			break;
+		case ReasonOfOutboundMessage::EmitEventExternal:
+		case ReasonOfOutboundMessage::RemoteCallInternal:
+			funcID &= 0x7FFFFFFFu;
+			break;
 	}
 	return funcID;
 }
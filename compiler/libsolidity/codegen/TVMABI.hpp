@@ -93,7 +93,15 @@ private:
 	static int minBits(bool hasCallback);
 public:
 	void decodePublicFunctionParameters(const std::vector<Type const*>& types, bool isResponsible, bool isInternal);
+	// decodes only the first `decodedQty` parameters, the rest ones are skipped but still checked
+	void decodePublicFunctionParameters(
+		const std::vector<Type const*>& types,
+		bool isResponsible,
+		bool isInternal,
+		int decodedQty
+	);
 	void decodeFunctionParameters(const std::vector<Type const*>& types, bool isResponsible);
+	void decodeFunctionParameters(const std::vector<Type const*>& types, bool isResponsible, int decodedQty);
 	void decodeData(int offset, int usedRefs, const std::vector<Type const*>& types);
 	void decodeParameters(
 		const std::vector<Type const*>& types,
@@ -107,6 +115,8 @@ private:
 	void loadNextSlice();
 	void loadNextSliceIfNeed(bool doLoadNextSlice);
 	void decodeParameter(Type const* type, DecodePosition* position);
+	// skips the parameter in the slice without pushing it on stack
+	void skipParameter(Type const* type, DecodePosition* position);
 	void decodeParameterQ(Type const* type, DecodePosition* position, int ind);
 private:
 	StackPusher *pusher{};
@@ -168,6 +178,8 @@ public:
 
 private:
 	std::string toStringForCalcFuncID(Type const * type);
+	uint32_t signatureHash(const CallableDeclaration *declaration, bool isLib);
+	static uint32_t applyReason(uint32_t funcID, const ReasonOfOutboundMessage &reason);
 
 private:
 	StackPusher *pusher{};
@@ -33,6 +33,16 @@ bool TVMAnalyzer::analyze(const SourceUnit &_sourceUnit)
 	return !m_errorReporter.hasErrors();
 }
 
+void TVMAnalyzer::analyzeContract(ContractDefinition const& _contract)
+{
+	visit(_contract);
+}
+
+void TVMAnalyzer::analyze(ASTNode const& _node)
+{
+	_node.accept(*this);
+}
+
 bool TVMAnalyzer::visit(MemberAccess const& _node) {
 	auto funType = to<FunctionType>(_node.annotation().type);
 	if (funType) {
@@ -219,6 +229,270 @@ bool ContactsUsageScanner::visit(const FunctionDefinition &fd) {
 	return true;
 }
 
+VariableUsageScanner::VariableUsageScanner(FunctionDefinition const& fd) {
+	fd.accept(*this);
+}
+
+bool VariableUsageScanner::visit(Identifier const& _identifier) {
+	if (auto vd = to<VariableDeclaration>(_identifier.annotation().referencedDeclaration)) {
+		m_usedVariables.insert(vd);
+	}
+	return true;
+}
+
+bool VariableUsageScanner::visit(FreeInlineAssembly const& /*_assembly*/) {
+	m_hasAssembly = true;
+	return true;
+}
+
+LoopInvariantScanner::LoopInvariantScanner(Statement const& loop) {
+	loop.accept(*this);
+}
+
+bool LoopInvariantScanner::visit(Identifier const& _identifier) {
+	auto vd = to<VariableDeclaration>(_identifier.annotation().referencedDeclaration);
+	if (vd && std::find(m_reads.begin(), m_reads.end(), vd) == m_reads.end()) {
+		m_reads.emplace_back(vd);
+	}
+	return true;
+}
+
+bool LoopInvariantScanner::visit(Assignment const& _assignment) {
+	if (!markWritten(_assignment.leftHandSide())) {
+		m_hasUnknownWrites = true;
+	}
+	return true;
+}
+
+bool LoopInvariantScanner::visit(UnaryOperation const& _unaryOperation) {
+	if (TokenTraits::isCountOp(_unaryOperation.getOperator()) || _unaryOperation.getOperator() == Token::Delete) {
+		if (!markWritten(_unaryOperation.subExpression())) {
+			m_hasUnknownWrites = true;
+		}
+	}
+	return true;
+}
+
+bool LoopInvariantScanner::visit(FunctionCall const& _functionCall) {
+	if (*_functionCall.annotation().kind != FunctionCallKind::FunctionCall) {
+		return true;
+	}
+	// methods like `push`, `pop`, `delMin` modify the object they are called on
+	if (auto memberAccess = to<MemberAccess>(&_functionCall.expression())) {
+		markWritten(memberAccess->expression());
+	}
+	auto funType = to<FunctionType>(_functionCall.expression().annotation().type);
+	if (funType == nullptr ||
+		isIn(funType->kind(), FunctionType::Kind::External, FunctionType::Kind::DelegateCall) ||
+		(funType->stateMutability() > StateMutability::View && funType->kind() != FunctionType::Kind::Event)
+	) {
+		// the callee may change state variables, or `await` may reload them
+		m_hasUnknownWrites = true;
+	}
+	return true;
+}
+
+bool LoopInvariantScanner::visit(FreeInlineAssembly const& /*_assembly*/) {
+	m_hasUnknownWrites = true;
+	m_hasAssembly = true;
+	return true;
+}
+
+std::vector<VariableDeclaration const*> LoopInvariantScanner::invariantStateVariables() const {
+	std::vector<VariableDeclaration const*> res;
+	if (!m_hasUnknownWrites) {
+		for (VariableDeclaration const* vd : m_reads) {
+			if (vd->isStateVariable() && !vd->isConstant() && m_written.count(vd) == 0) {
+				res.emplace_back(vd);
+			}
+		}
+	}
+	return res;
+}
+
+bool LoopInvariantScanner::isRead(VariableDeclaration const* vd) const {
+	return m_hasAssembly || std::find(m_reads.begin(), m_reads.end(), vd) != m_reads.end();
+}
+
+bool LoopInvariantScanner::isChanged(VariableDeclaration const* vd) const {
+	return
+		m_hasAssembly ||
+		m_written.count(vd) != 0 ||
+		(vd->isStateVariable() && !vd->isConstant() && m_hasUnknownWrites);
+}
+
+bool LoopInvariantScanner::markWritten(Expression const& lValue) {
+	if (auto tuple = to<TupleExpression>(&lValue)) {
+		bool ok = true;
+		for (ASTPointer<Expression> const& component : tuple->components()) {
+			if (component) {
+				ok &= markWritten(*component);
+			}
+		}
+		return ok;
+	}
+	if (auto identifier = to<Identifier>(&lValue)) {
+		if (auto vd = to<VariableDeclaration>(identifier->annotation().referencedDeclaration)) {
+			m_written.insert(vd);
+		}
+		return true;
+	}
+	if (auto indexAccess = to<IndexAccess>(&lValue)) {
+		return markWritten(indexAccess->baseExpression());
+	}
+	if (auto indexRangeAccess = to<IndexRangeAccess>(&lValue)) {
+		return markWritten(indexRangeAccess->baseExpression());
+	}
+	if (auto memberAccess = to<MemberAccess>(&lValue)) {
+		return markWritten(memberAccess->expression());
+	}
+	if (auto funCall = to<FunctionCall>(&lValue)) {
+		return markWritten(funCall->expression()); // e.g. `opt.get().field = value`
+	}
+	return false;
+}
+
+std::optional<CountedLoop> CountedLoop::match(ForStatement const& loop) {
+	auto init = to<VariableDeclarationStatement>(loop.initializationExpression());
+	auto cond = to<BinaryOperation>(loop.condition());
+	if (!init || init->declarations().size() != 1 || !init->declarations().at(0) || !init->initialValue() ||
+		!cond || !loop.loopExpression()
+	) {
+		return {};
+	}
+
+	CountedLoop res;
+	res.index = init->declarations().at(0).get();
+	res.start = init->initialValue();
+	res.bound = &cond->rightExpression();
+	auto indexType = to<IntegerType>(res.index->type());
+	if (!indexType) {
+		return {};
+	}
+
+	auto isIndex = [&](Expression const& e) {
+		auto id = to<Identifier>(&e);
+		return id && id->annotation().referencedDeclaration == res.index;
+	};
+
+	// i < bound or i <= bound
+	if (!isIndex(cond->leftExpression()) || !isIn(cond->getOperator(), Token::LessThan, Token::LessThanOrEqual) ||
+		!res.bound->annotation().type->isImplicitlyConvertibleTo(*indexType)
+	) {
+		return {};
+	}
+	res.inclusive = cond->getOperator() == Token::LessThanOrEqual;
+	std::optional<bigint> bound = ExprUtils::constValue(*res.bound);
+	// `i <= max` never stops without an overflow of `i`
+	if (res.inclusive && (!bound || *bound >= indexType->maxValue())) {
+		return {};
+	}
+
+	// ++i, i++ or i += 1
+	Expression const& step = loop.loopExpression()->expression();
+	if (auto op = to<UnaryOperation>(&step)) {
+		if (op->getOperator() != Token::Inc || !isIndex(op->subExpression())) {
+			return {};
+		}
+	} else if (auto assign = to<Assignment>(&step)) {
+		std::optional<bigint> one = ExprUtils::constValue(assign->rightHandSide());
+		if (assign->assignmentOperator() != Token::AssignAdd || !isIndex(assign->leftHandSide()) || one != bigint(1)) {
+			return {};
+		}
+	} else {
+		return {};
+	}
+
+	LoopInvariantScanner body{loop.body()};
+	if (body.isChanged(res.index)) {
+		return {};
+	}
+	if (!bound) {
+		// the bound is read once before the loop, so it must keep its value
+		Expression const* boundVar = res.bound;
+		if (auto member = to<MemberAccess>(boundVar); member && member->memberName() == "length") {
+			boundVar = &member->expression();
+		}
+		auto id = to<Identifier>(boundVar);
+		auto vd = id ? to<VariableDeclaration>(id->annotation().referencedDeclaration) : nullptr;
+		if (!vd || body.isChanged(vd)) {
+			return {};
+		}
+	}
+	res.indexIsRead = body.isRead(res.index);
+
+	std::optional<bigint> start = ExprUtils::constValue(*res.start);
+	if (start && bound) {
+		res.tripCount = *bound - *start + (res.inclusive ? 1 : 0);
+	}
+	// REPEAT throws a range check error if the count doesn't fit into int32, so the count is clamped
+	// to 2^31-1. A loop that runs so many iterations without `break` or `return` is out of gas anyway.
+	bigint maxCount = res.tripCount ? *res.tripCount : indexType->maxValue() - indexType->minValue();
+	res.mayExceedInt32 = maxCount >= bigint(1) << 31;
+	res.mayBeNegative = !res.tripCount && (!start || *start != indexType->minValue());
+	return res;
+}
+
+namespace {
+class NodeCounter: public ASTConstVisitor {
+public:
+	int qty{};
+protected:
+	bool visitNode(ASTNode const&) override {
+		++qty;
+		return true;
+	}
+};
+}
+
+int astNodeQty(ASTNode const& node) {
+	NodeCounter counter;
+	node.accept(counter);
+	return counter.qty;
+}
+
+ContinueScanner::ContinueScanner(Statement const& body) {
+	body.accept(*this);
+}
+
+bool ContinueScanner::visit(IfStatement const& _node) {
+	// Same choice as in TVMFunctionCompiler::visit(IfStatement). `else if` chains may be compiled
+	// as a search tree with a flag, so they are treated as flagged.
+	bool canUseJmp = _node.falseStatement() != nullptr ?
+		CFAnalyzer(_node.trueStatement()).doThatAlways() &&
+		CFAnalyzer(*_node.falseStatement()).doThatAlways() &&
+		!to<IfStatement>(_node.falseStatement()) :
+		CFAnalyzer(_node.trueStatement()).doThatAlways();
+	m_isFlagged.push_back(!canUseJmp);
+	if (!canUseJmp) {
+		++m_flaggedDepth;
+	}
+	return true;
+}
+
+void ContinueScanner::endVisit(IfStatement const&) {
+	if (m_isFlagged.back()) {
+		--m_flaggedDepth;
+	}
+	m_isFlagged.pop_back();
+}
+
+bool ContinueScanner::visit(TryStatement const&) {
+	++m_flaggedDepth;
+	return true;
+}
+
+void ContinueScanner::endVisit(TryStatement const&) {
+	--m_flaggedDepth;
+}
+
+void ContinueScanner::endVisit(Continue const&) {
+	++m_continueQty;
+	if (m_flaggedDepth > 0) {
+		m_allDirect = false;
+	}
+}
+
 bool withPrelocatedRetValues(const FunctionDefinition *f) {
 	LocationReturn locationReturn = ::notNeedsPushContWhenInlining(f->body());
 	if (!f->returnParameters().empty() && isIn(locationReturn, LocationReturn::noReturn, LocationReturn::Anywhere)) {
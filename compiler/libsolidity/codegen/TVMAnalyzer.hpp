@@ -39,6 +39,11 @@ public:
 	/// @returns true if all checks passed. Note even if all checks passed, errors() can still contain warnings
 	bool analyze(SourceUnit const& _sourceUnit);
 
+	/// Performs analysis on @a _contract without its sub-nodes, they may be analyzed separately.
+	void analyzeContract(ContractDefinition const& _contract);
+	/// Performs analysis on the given node and all of its sub-nodes.
+	void analyze(ASTNode const& _node);
+
 private:
 	bool visit(MemberAccess const& contract) override;
 	bool visit(ContractDefinition const& contract) override;
@@ -78,6 +83,69 @@ private:
 	std::set<FunctionDefinition const*> m_awaitFunctions;
 };
 
+// Collects variables that are referenced in a function, including its modifier invocations
+class VariableUsageScanner: public ASTConstVisitor
+{
+public:
+	explicit VariableUsageScanner(FunctionDefinition const& fd);
+	bool visit(Identifier const& _identifier) override;
+	bool visit(FreeInlineAssembly const& _assembly) override;
+
+	// assembly may access any stack slot, so all variables are treated as used there
+	bool isUsed(VariableDeclaration const* vd) const { return m_hasAssembly || m_usedVariables.count(vd) != 0; }
+
+private:
+	bool m_hasAssembly{};
+	std::set<VariableDeclaration const*> m_usedVariables;
+};
+
+// Collects state variables that are read in a loop but can't be changed while the loop runs
+class LoopInvariantScanner: public ASTConstVisitor
+{
+public:
+	explicit LoopInvariantScanner(Statement const& loop);
+	bool visit(Identifier const& _identifier) override;
+	bool visit(Assignment const& _assignment) override;
+	bool visit(UnaryOperation const& _unaryOperation) override;
+	bool visit(FunctionCall const& _functionCall) override;
+	bool visit(FreeInlineAssembly const& _assembly) override;
+
+	// ordered by the first read
+	std::vector<VariableDeclaration const*> invariantStateVariables() const;
+	// assembly may access any stack slot, so all variables are treated as used there
+	bool isRead(VariableDeclaration const* vd) const;
+	bool isChanged(VariableDeclaration const* vd) const;
+
+private:
+	// returns false if the written variable is unknown
+	bool markWritten(Expression const& lValue);
+
+private:
+	bool m_hasUnknownWrites{};
+	bool m_hasAssembly{};
+	std::vector<VariableDeclaration const*> m_reads;
+	std::set<VariableDeclaration const*> m_written;
+};
+
+// `for (T i = start; i < bound; ++i)` where neither `i` nor `bound` is changed in the body,
+// so the number of iterations is known before the loop starts.
+// `i++`, `i += 1` and `i <= bound` with a constant bound are accepted as well.
+struct CountedLoop {
+	VariableDeclaration const* index{};
+	Expression const* start{};
+	Expression const* bound{};
+	bool inclusive{}; // i <= bound
+	bool indexIsRead{}; // the body reads the index
+	std::optional<bigint> tripCount; // set if start and bound are constants
+	bool mayBeNegative{}; // bound - start may be below zero
+	bool mayExceedInt32{}; // bound - start may be above 2^31-1
+
+	static std::optional<CountedLoop> match(ForStatement const& loop);
+};
+
+// Number of AST nodes in the subtree, used to estimate the size of the generated code
+int astNodeQty(ASTNode const& node);
+
 template <typename T>
 static bool doesAlways(const Statement* st) {
 	auto rec = [] (const Statement* s) {
@@ -156,6 +224,33 @@ private:
 	bool m_alwaysContinue{};
 };
 
+// Checks whether every `continue` of a loop leaves the body with a plain RET, i.e. no `continue` is
+// inside an `if` or `try` statement that passes it up with a control flow flag.
+// Nested loops are skipped, their `continue` statements belong to them.
+class ContinueScanner: public ASTConstVisitor
+{
+public:
+	explicit ContinueScanner(Statement const& body);
+	bool allDirect() const { return m_allDirect; }
+	int continueQty() const { return m_continueQty; }
+
+protected:
+	bool visit(IfStatement const& _node) override;
+	void endVisit(IfStatement const& _node) override;
+	bool visit(TryStatement const& _node) override;
+	void endVisit(TryStatement const& _node) override;
+	bool visit(ForEachStatement const&) override { return false; }
+	bool visit(WhileStatement const&) override { return false; }
+	bool visit(ForStatement const&) override { return false; }
+	void endVisit(Continue const&) override;
+
+private:
+	std::vector<bool> m_isFlagged;
+	int m_flaggedDepth{};
+	int m_continueQty{};
+	bool m_allDirect{true};
+};
+
 } // end namespace solidity::frontend
 
 solidity::frontend::LocationReturn notNeedsPushContWhenInlining(solidity::frontend::Block const &_block);
@@ -19,6 +19,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 
 #include "TVM.hpp"
+#include "TVMABI.hpp"
 #include "TVMCommons.hpp"
 #include "TVMConstants.hpp"
 
@@ -227,14 +228,79 @@ vector<ContractDefinition const *> getContractsChain(ContractDefinition const *c
 
 std::vector<VariableDeclaration const *> notConstantStateVariables(ContractDefinition const* _contract) {
 	std::vector<VariableDeclaration const *> variableDeclarations;
-	std::vector<ContractDefinition const *> mainChain = getContractsChain(_contract);
-	for (ContractDefinition const * contract: mainChain) {
-		for (VariableDeclaration const *variable: contract->stateVariables()) {
-			if (!variable->isConstant()) {
-				variableDeclarations.push_back(variable);
-			}
+	for (VariableDeclaration const *variable: _contract->linearizedStateVariables()) {
+		if (!variable->isConstant()) {
+			variableDeclarations.push_back(variable);
+		}
+	}
+	return variableDeclarations;
+}
+
+namespace {
+// Orders state variables so that they take up fewer cells in c4. Cells are split by the same greedy
+// rule as in the encoder (see DecodePositionAbiV2), so the variables are grouped into cells with
+// the first fit decreasing heuristic and the groups are stored one after another. Each group fits
+// in a cell, so the greedy rule needs at most as many cells as there are groups.
+std::vector<VariableDeclaration const *> packStateVariables(std::vector<VariableDeclaration const *> const& vars) {
+	// The c4 header is not known here (it depends on pragmas and usage of await),
+	// so the largest one is assumed: pubkey, timestamp, constructor flag, await flag and await ref.
+	int const headerBits = 256 + 64 + 1 + 1;
+	int const headerRefs = 1;
+	auto cellQty = [&](std::vector<VariableDeclaration const *> const& order) {
+		std::vector<Type const*> types;
+		for (VariableDeclaration const* v : order)
+			types.push_back(v->type());
+		return DecodePositionAbiV2{headerBits, headerRefs, types}.countOfCreatedBuilders();
+	};
+
+	std::map<VariableDeclaration const*, ABITypeSize> sizes;
+	for (VariableDeclaration const* v : vars)
+		sizes.emplace(v, ABITypeSize{v->type()});
+	std::vector<VariableDeclaration const *> sorted = vars;
+	std::stable_sort(sorted.begin(), sorted.end(), [&](VariableDeclaration const* a, VariableDeclaration const* b) {
+		ABITypeSize const& sa = sizes.at(a);
+		ABITypeSize const& sb = sizes.at(b);
+		return std::tie(sa.maxBits, sa.maxRefs) > std::tie(sb.maxBits, sb.maxRefs);
+	});
+
+	struct Cell {
+		int bits{};
+		int refs{};
+		std::vector<VariableDeclaration const *> vars;
+	};
+	// a cell keeps one ref for the next cell
+	int const maxRefs = 3;
+	std::vector<Cell> cells{Cell{headerBits, headerRefs, {}}};
+	std::vector<VariableDeclaration const *> oversized;
+	for (VariableDeclaration const* v : sorted) {
+		ABITypeSize const& size = sizes.at(v);
+		if (size.maxBits > TvmConst::CellBitLength || size.maxRefs > maxRefs) {
+			oversized.push_back(v);
+			continue;
 		}
+		auto it = std::find_if(cells.begin(), cells.end(), [&](Cell const& c) {
+			return c.bits + size.maxBits <= TvmConst::CellBitLength && c.refs + size.maxRefs <= maxRefs;
+		});
+		if (it == cells.end())
+			it = cells.insert(cells.end(), Cell{});
+		it->bits += size.maxBits;
+		it->refs += size.maxRefs;
+		it->vars.push_back(v);
 	}
+
+	std::vector<VariableDeclaration const *> packed;
+	for (Cell const& c : cells)
+		packed.insert(packed.end(), c.vars.begin(), c.vars.end());
+	packed.insert(packed.end(), oversized.begin(), oversized.end());
+
+	return cellQty(packed) < cellQty(vars) ? packed : vars;
+}
+}
+
+std::vector<VariableDeclaration const *> storedStateVariables(ContractDefinition const* _contract) {
+	std::vector<VariableDeclaration const *> variableDeclarations = notConstantStateVariables(_contract);
+	if (GlobalParams::g_packStateVariables)
+		return packStateVariables(variableDeclarations);
 	return variableDeclarations;
 }
 
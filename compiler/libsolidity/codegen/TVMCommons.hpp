@@ -150,6 +150,9 @@ realDictKeyValue(Type const* type);
 
 std::vector<ContractDefinition const*> getContractsChain(ContractDefinition const* contract);
 std::vector<VariableDeclaration const *> notConstantStateVariables(ContractDefinition const* contract);
+// notConstantStateVariables() in the order they are stored in c4 and c7,
+// it differs from the declaration order only with --pack-state-variables
+std::vector<VariableDeclaration const *> storedStateVariables(ContractDefinition const* contract);
 
 std::vector<std::pair<FunctionDefinition const*, ContractDefinition const*>>
 getContractFunctionPairs(ContractDefinition const* contract);
@@ -301,10 +304,21 @@ public:
 		return m_isLoop;
 	}
 
+	// Code of the loop that runs after the body (e.g. `++i`). If it's set, `continue` inlines it
+	// and the body isn't wrapped into a separate continuation.
+	std::function<void()> const* continueTail() const {
+		return m_continueTail;
+	}
+
+	void setContinueTail(std::function<void()> const* continueTail) {
+		m_continueTail = continueTail;
+	}
+
 private:
 	int m_stackSize {-1};
 	bool m_hasAnalyzeFlag {false};
 	bool m_isLoop {false};
+	std::function<void()> const* m_continueTail {};
 };
 
 LocationReturn notNeedsPushContWhenInlining(Block const& _block);
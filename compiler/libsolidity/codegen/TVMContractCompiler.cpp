@@ -15,9 +15,11 @@
  */
 
 #include <fstream>
+#include <sstream>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/range/adaptor/map.hpp>
 
+#include <libsolidity/ast/CallGraph.h>
 #include <libsolidity/interface/Version.h>
 
 #include "PeepholeOptimizer.hpp"
@@ -35,6 +37,7 @@
 using namespace solidity::frontend;
 using namespace std;
 using namespace solidity::util;
+using namespace solidity::langutil;
 
 TVMConstructorCompiler::TVMConstructorCompiler(StackPusher &pusher) : m_pusher{pusher} {
 
@@ -252,6 +255,12 @@ TVMContractCompiler::generateContractCode(
 
 	fillInlineFunctions(ctx, contract);
 
+	// library and free functions are generated only if they can be called from the contract
+	std::optional<std::set<CallableDeclaration const*>> const reachable = reachableFunctions(contract);
+	auto isReachable = [&](FunctionDefinition const* function) {
+		return !reachable.has_value() || reachable->count(function) != 0;
+	};
+
 	// generate global constructor which inlines all contract constructors
 	if (!ctx.isStdlib()) {
 		StackPusher pusher{&ctx};
@@ -260,63 +269,61 @@ TVMContractCompiler::generateContractCode(
 		functions.push_back(f);
 	}
 
-	for (ContractDefinition const* c : contract->annotation().linearizedBaseContracts) {
-		for (FunctionDefinition const *_function : c->definedFunctions()) {
-			if (_function->isConstructor() ||
-				!_function->isImplemented() ||
-				_function->isInline()) {
-				continue;
-			}
+	for (FunctionDefinition const *_function : contract->linearizedDefinedFunctions()) {
+		if (_function->isConstructor() ||
+			!_function->isImplemented() ||
+			_function->isInline()) {
+			continue;
+		}
 
-			ctx.setCurrentFunction(_function);
+		ctx.setCurrentFunction(_function);
 
-			if (_function->isOnBounce()) {
-				if (!ctx.isOnBounceGenerated()) {
-					ctx.setIsOnBounce();
-					functions.push_back(TVMFunctionCompiler::generateOnBounce(ctx, _function));
-				}
-			} else if (_function->isReceive()) {
-				if (!ctx.isReceiveGenerated()) {
-					ctx.setIsReceiveGenerated();
-					functions.push_back(TVMFunctionCompiler::generateReceive(ctx, _function));
-				}
-			} else if (_function->isFallback()) {
-				if (!ctx.isFallBackGenerated()) {
-					ctx.setIsFallBackGenerated();
-					functions.push_back(TVMFunctionCompiler::generateFallback(ctx, _function));
-				}
-			} else if (_function->isOnTickTock()) {
-				functions.push_back(TVMFunctionCompiler::generateOnTickTock(ctx, _function));
-			} else if (isMacro(_function->name())) {
-				functions.push_back(TVMFunctionCompiler::generateMacro(ctx, _function));
-			} else if (_function->name() == "onCodeUpgrade") {
-				if (!ctx.isBaseFunction(_function))
-					functions.push_back(TVMFunctionCompiler::generateOnCodeUpgrade(ctx, _function));
-			} else {
-				std::string functionName = ctx.getFunctionInternalName(_function);
-				if (!ctx.isStdlib()) {
-					if (_function->isPublic()) {
-						bool isBaseMethod = _function != getContractFunctions(contract, _function->name()).back();
-						if (!isBaseMethod) {
-							functions.push_back(TVMFunctionCompiler::generatePublicFunction(ctx, _function));
-
-							StackPusher pusher{&ctx};
-							ChainDataEncoder encoder{&pusher}; // TODO delete pusher
-							uint32_t functionId = encoder.calculateFunctionIDWithReason(_function,
-																						ReasonOfOutboundMessage::RemoteCallInternal);
-							ctx.addPublicFunction(functionId, _function->name());
-						}
-					}
-					if (_function->visibility() <= Visibility::Public) {
-						functions.push_back(TVMFunctionCompiler::generatePrivateFunction(ctx, functionName, _function));
+		if (_function->isOnBounce()) {
+			if (!ctx.isOnBounceGenerated()) {
+				ctx.setIsOnBounce();
+				functions.push_back(TVMFunctionCompiler::generateOnBounce(ctx, _function));
+			}
+		} else if (_function->isReceive()) {
+			if (!ctx.isReceiveGenerated()) {
+				ctx.setIsReceiveGenerated();
+				functions.push_back(TVMFunctionCompiler::generateReceive(ctx, _function));
+			}
+		} else if (_function->isFallback()) {
+			if (!ctx.isFallBackGenerated()) {
+				ctx.setIsFallBackGenerated();
+				functions.push_back(TVMFunctionCompiler::generateFallback(ctx, _function));
+			}
+		} else if (_function->isOnTickTock()) {
+			functions.push_back(TVMFunctionCompiler::generateOnTickTock(ctx, _function));
+		} else if (isMacro(_function->name())) {
+			functions.push_back(TVMFunctionCompiler::generateMacro(ctx, _function));
+		} else if (_function->name() == "onCodeUpgrade") {
+			if (!ctx.isBaseFunction(_function))
+				functions.push_back(TVMFunctionCompiler::generateOnCodeUpgrade(ctx, _function));
+		} else {
+			std::string functionName = ctx.getFunctionInternalName(_function);
+			if (!ctx.isStdlib()) {
+				if (_function->isPublic()) {
+					bool isBaseMethod = _function != getContractFunctions(contract, _function->name()).back();
+					if (!isBaseMethod) {
+						functions.push_back(TVMFunctionCompiler::generatePublicFunction(ctx, _function));
+
+						StackPusher pusher{&ctx};
+						ChainDataEncoder encoder{&pusher}; // TODO delete pusher
+						uint32_t functionId = encoder.calculateFunctionIDWithReason(_function,
+																					ReasonOfOutboundMessage::RemoteCallInternal);
+						ctx.addPublicFunction(functionId, _function->name());
 					}
 				}
-				const std::string macroName = functionName + "_macro";
-				functions.push_back(TVMFunctionCompiler::generateMacro(ctx, _function, macroName));
+				if (_function->visibility() <= Visibility::Public) {
+					functions.push_back(TVMFunctionCompiler::generatePrivateFunction(ctx, functionName, _function));
+				}
 			}
-
-			ctx.setCurrentFunction(nullptr);
+			const std::string macroName = functionName + "_macro";
+			functions.push_back(TVMFunctionCompiler::generateMacro(ctx, _function, macroName));
 		}
+
+		ctx.setCurrentFunction(nullptr);
 	}
 
 	if (!ctx.isStdlib()) {
@@ -374,6 +381,11 @@ TVMContractCompiler::generateContractCode(
 									   "Modifiers for library functions are not supported yet.");
 						}
 
+						if (!isReachable(function)) {
+							ctx.setCurrentFunction(nullptr);
+							continue;
+						}
+
 						if (!function->parameters().empty()) {
 							{
 								const std::string name = TVMCompilerContext::getLibFunctionName(function, true);
@@ -405,6 +417,11 @@ TVMContractCompiler::generateContractCode(
 								   "Modifiers for free functions are not supported yet.");
 					}
 
+					if (!isReachable(function)) {
+						ctx.setCurrentFunction(nullptr);
+						continue;
+					}
+
 					std::string functionName = ctx.getFunctionInternalName(function);
 					functions.push_back(TVMFunctionCompiler::generatePrivateFunction(ctx, functionName, function));
 
@@ -454,41 +471,93 @@ TVMContractCompiler::generateContractCode(
 	LocSquasher sq;
 	c->accept(sq);
 
-	optimizeCode(c);
+	OptimizerBudget budget{GlobalParams::g_optimizerLimits};
+	optimizeCode(c, GlobalParams::g_optimizationLevel, &budget);
+	if (!budget.stoppedFunctions().empty()) {
+		std::string names;
+		for (std::string const& name : budget.stoppedFunctions()) {
+			names += names.empty() ? "" : ", ";
+			names += name;
+		}
+		GlobalParams::g_errorReporter->warning(
+			228_error,
+			contract->location(),
+			std::string{} + "Optimizer " + (budget.isTimeOut() ? "time limit" : "fuel") +
+			" is exhausted. Following functions are partially optimized: " + names + "."
+		);
+	}
 
 	return c;
 }
 
-void TVMContractCompiler::optimizeCode(Pointer<Contract>& c) {
-	DeleterCallX dc;
-	c->accept(dc);
+void TVMContractCompiler::optimizeCode(Pointer<Contract>& c, unsigned level, OptimizerBudget* budget) {
+	if (level >= 1) {
+		DeleterCallX dc;
+		c->accept(dc);
+	}
 
 	LogCircuitExpander lce;
 	c->accept(lce);
+	if (level == 0)
+		return;
 
-	StackOptimizer opt;
+	StackOptimizer opt{budget};
 	c->accept(opt);
 
-	PeepholeOptimizer peepHole{false, false};
+	PeepholeOptimizer peepHole{false, false, budget};
 	c->accept(peepHole);
 
-	opt = StackOptimizer{};
-	c->accept(opt);
+	if (level >= 2) {
+		opt = StackOptimizer{budget};
+		c->accept(opt);
 
-	peepHole = PeepholeOptimizer{false, false};
-	c->accept(peepHole);
+		peepHole = PeepholeOptimizer{false, false, budget};
+		c->accept(peepHole);
 
-	peepHole = PeepholeOptimizer{true, false};
-	c->accept(peepHole);
+		peepHole = PeepholeOptimizer{true, false, budget};
+		c->accept(peepHole);
 
-	peepHole = PeepholeOptimizer{true, true};
-	c->accept(peepHole);
+		peepHole = PeepholeOptimizer{true, true, budget};
+		c->accept(peepHole);
+	}
+
+	if (level >= 3) {
+		// repeat the last round while it changes the code
+		std::string prev = toString(c);
+		for (int iter = 0; iter < TvmConst::IterStackOptQty; ++iter) {
+			opt = StackOptimizer{budget};
+			c->accept(opt);
+
+			peepHole = PeepholeOptimizer{true, true, budget};
+			c->accept(peepHole);
+
+			std::string cur = toString(c);
+			if (cur == prev)
+				break;
+			prev = std::move(cur);
+		}
+	}
+
+	TailCallOptimizer tco;
+	c->accept(tco);
+
+	ColdBranchOutliner cbo{GlobalParams::g_branchProfile};
+	c->accept(cbo);
 
 	LocSquasher sq = LocSquasher{};
 	c->accept(sq);
 
-	SizeOptimizer so{};
-	so.optimize(c);
+	if (level >= 2) {
+		SizeOptimizer so{};
+		so.optimize(c);
+	}
+}
+
+std::string TVMContractCompiler::toString(Pointer<Contract> const& c) {
+	std::ostringstream out;
+	Printer p{out};
+	c->accept(p);
+	return out.str();
 }
 
 void TVMContractCompiler::fillInlineFunctions(TVMCompilerContext &ctx, ContractDefinition const *contract) {
@@ -518,3 +587,21 @@ void TVMContractCompiler::fillInlineFunctions(TVMCompilerContext &ctx, ContractD
 	}
 }
 
+std::optional<std::set<CallableDeclaration const*>>
+TVMContractCompiler::reachableFunctions(ContractDefinition const* contract) {
+	ContractDefinitionAnnotation const& annotation = contract->annotation();
+	if (!annotation.creationCallGraph.set() || !annotation.deployedCallGraph.set()) {
+		return std::nullopt;
+	}
+
+	// Call graphs contain a key for every reachable function and modifier
+	std::set<CallableDeclaration const*> reachable;
+	for (std::shared_ptr<CallGraph const> const& graph : {*annotation.creationCallGraph, *annotation.deployedCallGraph}) {
+		for (CallGraph::Node const& node : graph->edges | boost::adaptors::map_keys) {
+			if (auto callable = std::get_if<CallableDeclaration const*>(&node)) {
+				reachable.insert(*callable);
+			}
+		}
+	}
+	return reachable;
+}
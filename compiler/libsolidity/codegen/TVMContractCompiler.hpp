@@ -63,9 +63,14 @@ public:
 		std::vector<std::shared_ptr<SourceUnit>> _sourceUnits,
 		PragmaDirectiveHelper const& pragmaHelper
 	);
-	static void optimizeCode(Pointer<Contract>& c);
+	// level is described in OptimiserSettings::tvmOptimizationLevel,
+	// budget may be nullptr, then the optimizers are not limited
+	static void optimizeCode(Pointer<Contract>& c, unsigned level, OptimizerBudget* budget = nullptr);
 private:
+	static std::string toString(Pointer<Contract> const& c);
 	static void fillInlineFunctions(TVMCompilerContext& ctx, ContractDefinition const* contract);
+	// returns nullopt if call graphs are not built, i.e. reachability is unknown
+	static std::optional<std::set<CallableDeclaration const*>> reachableFunctions(ContractDefinition const* contract);
 };
 
 }	// end solidity::frontend
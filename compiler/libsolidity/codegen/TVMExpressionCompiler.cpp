@@ -138,6 +138,13 @@ void TVMExpressionCompiler::visit2(TupleExpression const &_tupleExpression) {
 		int n = components.size();
 		if (*_tupleExpression.annotation().isPure) {
 			const int stackSize = m_pusher.stackSize();
+			if (Pointer<PushCellOrSlice> dict = constArrayDict(_tupleExpression)) {
+				m_pusher << "PUSHINT " + toString(n);
+				m_pusher.pushConstCell(dict);
+				m_pusher << "TUPLE 2";
+				solAssert(stackSize + 1 == m_pusher.stackSize(), "");
+				return;
+			}
 			SourceReference sr = SourceReferenceExtractor::extract(*GlobalParams::g_charStreamProvider, &_tupleExpression.location());
 			const std::string computeName = "inline_array_line_" +
 					toString(sr.position.line) + "_column_" + toString(sr.position.column) + "_ast_id_" +
@@ -159,6 +166,21 @@ void TVMExpressionCompiler::visit2(TupleExpression const &_tupleExpression) {
 	}
 }
 
+Pointer<PushCellOrSlice> TVMExpressionCompiler::constArrayDict(TupleExpression const& _tupleExpression) {
+	Type const* baseType = to<ArrayType>(_tupleExpression.annotation().type)->baseType();
+	std::vector<bigint> values;
+	for (ASTPointer<Expression> const& expr : _tupleExpression.components()) {
+		if (std::optional<bool> b = ExprUtils::constBool(*expr)) {
+			values.emplace_back(*b ? -1 : 0); // STI 1
+		} else if (std::optional<bigint> value = ExprUtils::constValue(*expr)) {
+			values.emplace_back(*value);
+		} else {
+			return nullptr;
+		}
+	}
+	return ConstDictBuilder::buildArray(baseType, values);
+}
+
 void TVMExpressionCompiler::visitHonest(TupleExpression const& _tupleExpression, bool onlyDict) {
 	const int stackSize = m_pusher.stackSize();
 	vector<ASTPointer<Expression>> const& components = _tupleExpression.components();
@@ -39,6 +39,7 @@ protected:
 	void visitStringLiteralAbiV2(Literal const& _node);
 	void visit2(Literal const& _node);
 	void visit2(TupleExpression const& _tupleExpression);
+	static Pointer<PushCellOrSlice> constArrayDict(TupleExpression const& _tupleExpression);
 public:
 	void visitHonest(TupleExpression const& _tupleExpression, bool onlyDict);
 protected:
@@ -1441,10 +1441,16 @@ void FunctionCallCompiler::sliceMethods(MemberAccess const &_node) {
 				paramQty = functionDefinition->parameters().size() + (isResponsible ? 1 : 0);
 			}
 		} else if (isIn(memberName, "loadStateVars", "decodeStateVars")) {
-			std::vector<Type const*> stateVarTypes;
+			// pubkey, timestamp and constructor flag
 			auto retTuple = to<TupleType>(m_retType);
-			for (Type const* type : retTuple->components()) {
-				stateVarTypes.push_back(type);
+			std::vector<Type const*> stateVarTypes(retTuple->components().begin(), retTuple->components().begin() + 3);
+			// the state variables are returned in the declaration order, but decoded in the c4 order
+			auto tt = dynamic_cast<TypeType const*>(m_arguments.at(0)->annotation().type);
+			ContractDefinition const* contract = &to<ContractType>(tt->actualType())->contractDefinition();
+			std::vector<VariableDeclaration const*> const declared = notConstantStateVariables(contract);
+			std::vector<VariableDeclaration const*> const stored = storedStateVariables(contract);
+			for (VariableDeclaration const* v : stored) {
+				stateVarTypes.push_back(v->type());
 			}
 
 			// lvalue.. slice
@@ -1452,6 +1458,15 @@ void FunctionCallCompiler::sliceMethods(MemberAccess const &_node) {
 			decoder.decodeData(0, 0, stateVarTypes);
 			// lvalue.. stateVars...
 
+			if (declared != stored) {
+				const int n = stored.size();
+				for (int i = 0; i < n; ++i) {
+					const int pos = std::find(stored.begin(), stored.end(), declared.at(i)) - stored.begin();
+					m_pusher.pushS(n - 1 - pos + i);
+				}
+				m_pusher.dropUnder(n, n);
+			}
+
 			paramQty = stateVarTypes.size();
 		} else {
 			solUnimplemented("");
@@ -3320,13 +3335,48 @@ bool FunctionCallCompiler::checkSolidityUnits() {
 				pushArgAndConvert(0);
 				m_pusher._throw("THROWIFNOT 100");
 			} else if (m_arguments.size() == 2 || m_arguments.size() == 3) {
-				if (m_arguments.size() == 3)
+				// A pure exception argument that is costly to build (e.g. a formatted string or
+				// an encoded struct) is built only if the condition fails. A constant or a single
+				// push is left before the condition, so THROWARGIFNOT can be used.
+				auto isSinglePush = [](Expression const* arg) {
+					while (auto conv = to<FunctionCall>(arg)) {
+						if (*conv->annotation().kind != FunctionCallKind::TypeConversion ||
+							conv->arguments().size() != 1
+						) {
+							break;
+						}
+						arg = conv->arguments().at(0).get();
+					}
+					return ExprUtils::constValue(*arg).has_value() || to<Literal>(arg) || to<Identifier>(arg);
+				};
+				const bool isColdArg = m_arguments.size() == 3 &&
+					*m_arguments[1]->annotation().isPure &&
+					*m_arguments[2]->annotation().isPure &&
+					!isSinglePush(m_arguments[2].get());
+				if (m_arguments.size() == 3 && !isColdArg)
 					pushArgAndConvert(2);
 				const auto &exceptionCode = ExprUtils::constValue(*m_arguments[1].get());
 				if (exceptionCode.has_value() && exceptionCode.value() <= 1) {
 					cast_error(*m_arguments[1].get(), "Error code must be at least two");
 				}
-				if (exceptionCode.has_value() && exceptionCode.value() < 2048) {
+				if (isColdArg) {
+					pushArgAndConvert(0);
+					m_pusher.fixStack(-1); // drop condition
+					m_pusher.startContinuation();
+					pushArgAndConvert(2);
+					if (exceptionCode.has_value() && exceptionCode.value() < 2048) {
+						m_pusher._throw("THROWARG " + toString(exceptionCode.value()));
+					} else {
+						pushArgAndConvert(1);
+						if (!exceptionCode.has_value()) {
+							m_pusher.pushInt(2);
+							m_pusher << "MAX";
+						}
+						m_pusher._throw("THROWARGANY");
+					}
+					m_pusher.endContinuation();
+					m_pusher.ifNotJmp();
+				} else if (exceptionCode.has_value() && exceptionCode.value() < 2048) {
 					pushArgAndConvert(0);
 					if (m_arguments.size() == 3)
 						m_pusher._throw("THROWARGIFNOT " + toString(exceptionCode.value()));
@@ -3816,6 +3866,17 @@ void FunctionCallCompiler::creatArrayWithDefaultValue() {
 
 	if (*m_functionCall.annotation().isPure) {
 		pushArgs();
+		// every element is a cell of the dictionary, so only short arrays are built in the code
+		const int maxConstArrayLength = 256;
+		if (num.has_value() && num.value() <= maxConstArrayLength) {
+			auto arrayType = to<ArrayType>(m_functionCall.annotation().type);
+			std::vector<bigint> values(static_cast<size_t>(num.value()), 0);
+			if (Pointer<PushCellOrSlice> dict = ConstDictBuilder::buildArray(arrayType->baseType(), values)) {
+				m_pusher.pushConstCell(dict);
+				m_pusher << "TUPLE 2";
+				return;
+			}
+		}
 		SourceReference sr = SourceReferenceExtractor::extract(*GlobalParams::g_charStreamProvider, &m_functionCall.location());
 		const std::string computeName = "new_array_line_" +
 										toString(sr.position.line) + "_column_" + toString(sr.position.column) + "_ast_id_" +
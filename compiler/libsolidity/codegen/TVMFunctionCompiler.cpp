@@ -15,7 +15,6 @@
  */
 
 #include <tuple>
-#include <boost/algorithm/string/replace.hpp>
 
 #include <liblangutil/SourceReferenceExtractor.h>
 
@@ -158,10 +157,20 @@ TVMFunctionCompiler::generateC4ToC7(TVMCompilerContext& ctx) {
 		pusher << "LDI 1       ; await flag";
 		pusher.dropUnder(1, 1);
 	}
+	c4SliceToC7(pusher);
+
+	Pointer<CodeBlock> block = pusher.getBlock();
+	auto f = createNode<Function>(0, 0, "c4_to_c7", Function::FunctionType::Macro, block);
+	return f;
+}
+
+// stack: pubkey [timestamp] slice
+// where slice is the rest of c4 after the constructor and await flags
+void TVMFunctionCompiler::c4SliceToC7(StackPusher& pusher) {
 	if (!pusher.ctx().notConstantStateVariables().empty()) {
 		pusher.getStack().change(+1); // slice
 		// slice on stack
-		std::vector<Type const *> stateVarTypes = pusher.ctx().notConstantStateVariableTypes();
+		std::vector<Type const *> stateVarTypes = pusher.ctx().storedStateVariableTypes();
 		const int ss = pusher.stackSize();
 		ChainDataDecoder decoder{&pusher};
 		decoder.decodeData(pusher.ctx().getOffsetC4(),
@@ -192,10 +201,6 @@ TVMFunctionCompiler::generateC4ToC7(TVMCompilerContext& ctx) {
 
 	pusher.fixStack(+1); // fix stack
 	pusher.setGlob(TvmConst::C7::TvmPubkey);
-
-	Pointer<CodeBlock> block = pusher.getBlock();
-	auto f = createNode<Function>(0, 0, "c4_to_c7", Function::FunctionType::Macro, block);
-	return f;
 }
 
 Pointer<Function>
@@ -226,10 +231,12 @@ TVMFunctionCompiler::generateC4ToC7WithInitMemory(TVMCompilerContext& ctx) {
 			++varQty;
 		}
 	}
-	int shift = 0;
-	for (VariableDeclaration const* v : pusher.ctx().notConstantStateVariables()) {
+	std::map<VariableDeclaration const*, int> staticIndexes;
+	for (auto const& [v, index] : pusher.ctx().getStaticVariables())
+		staticIndexes.emplace(v, index);
+	for (VariableDeclaration const* v : pusher.ctx().storedStateVariables()) {
 		if (v->isStatic()) {
-			pusher.pushInt(TvmConst::C4::PersistenceMembersStartIndex + shift++); // dict vars... index dict
+			pusher.pushInt(staticIndexes.at(v)); // dict vars... index dict
 			pusher.pushS(1 + varQty); // dict vars... index dict
 			pusher.getDict(getKeyTypeOfC4(), *v->type(), GetDictOperation::GetFromMapping);
 		} else {
@@ -241,7 +248,7 @@ TVMFunctionCompiler::generateC4ToC7WithInitMemory(TVMCompilerContext& ctx) {
 		pusher.tuple(varQty);
 		pusher.popC7();
 	} else {
-		auto x = pusher.ctx().notConstantStateVariables(); // move
+		auto x = pusher.ctx().storedStateVariables(); // move
 		for (VariableDeclaration const* v : x | boost::adaptors::reversed) {
 			pusher.setGlob(v);
 		}
@@ -258,6 +265,7 @@ TVMFunctionCompiler::generateC4ToC7WithInitMemory(TVMCompilerContext& ctx) {
 	pusher << "PUSHINT 0 ; timestamp";
 	pusher.setGlob(TvmConst::C7::ReplayProtTime);
 
+	// initial values may depend on each other, so they are computed in the declaration order
 	for (VariableDeclaration const *variable: pusher.ctx().notConstantStateVariables()) {
 		if (auto value = variable->value().get()) {
 			funCompiler.acceptExpr(value);
@@ -366,7 +374,16 @@ void TVMFunctionCompiler::decodeFunctionParamsAndInitVars(bool isResponsible) {
 	// decode function params
 	// stack: arguments-in-slice
 	vector<Type const*> types = getParams(m_function->parameters()).first;
-	ChainDataDecoder{&m_pusher}.decodeFunctionParameters(types, isResponsible);
+	// trailing parameters that are never read in the function are skipped instead of decoding
+	VariableUsageScanner usage{*m_function};
+	int decodedQty = static_cast<int>(types.size());
+	while (decodedQty > 0 && !usage.isUsed(m_function->parameters().at(decodedQty - 1).get())) {
+		--decodedQty;
+	}
+	ChainDataDecoder{&m_pusher}.decodeFunctionParameters(types, isResponsible, decodedQty);
+	for (int i = decodedQty; i < static_cast<int>(types.size()); ++i) {
+		m_pusher.pushNull();
+	}
 	// stack: transaction_id arguments...
 	m_pusher.getStack().change(-static_cast<int>(m_function->parameters().size()));
 	for (const ASTPointer<VariableDeclaration>& variable: m_function->parameters()) {
@@ -451,7 +468,17 @@ TVMFunctionCompiler::generateGetter(StackPusher &pusher, VariableDeclaration con
 	pusher.fixStack(+2); // stack: functionId msgBody
 	pusher.drop(); // drop function id
 	pusher << "ENDS";
-	pusher.pushMacroCallInCallRef(0, 0, "c4_to_c7");
+	if (pusher.ctx().usage().hasAwaitCall()) {
+		// c4 is already decoded by check_resume if the getter is called by an internal message
+		pusher.was_c4_to_c7_called();
+		pusher.fixStack(-1); // fix stack
+		pusher.startContinuation();
+		pusher.pushMacro(0, 0, "c4_to_c7");
+		pusher.endContinuationFromRef();
+		pusher._if();
+	} else {
+		pusher.pushMacroCallInCallRef(0, 0, "c4_to_c7");
+	}
 	pusher.getGlob(vd);
 
 	// check ext msg
@@ -949,6 +976,11 @@ bool TVMFunctionCompiler::visit(TryStatement const& _tryState) {
 }
 
 bool TVMFunctionCompiler::visit(IfStatement const &_ifStatement) {
+	if (std::optional<EqualityChain> chain = findEqualityChain(_ifStatement)) {
+		visitEqualityChain(_ifStatement, *chain);
+		return false;
+	}
+
 	const int saveStackSize = m_pusher.stackSize();
 
 	// header
@@ -998,6 +1030,152 @@ bool TVMFunctionCompiler::visit(IfStatement const &_ifStatement) {
 	return false;
 }
 
+// Matches `if (x == c0) {...} else if (x == c1) {...} ... [else {...}]` where `x` is the same
+// integer or enum variable in every test and all `c` are distinct constants.
+std::optional<TVMFunctionCompiler::EqualityChain>
+TVMFunctionCompiler::findEqualityChain(IfStatement const& _ifStatement) {
+	// below this size a linear chain of EQUAL tests is not worse than a search tree
+	const int minCaseQty = 6;
+
+	auto caseValue = [](Expression const& e) -> std::optional<bigint> {
+		if (auto memberAccess = to<MemberAccess>(&e)) {
+			if (auto typeType = to<TypeType>(memberAccess->expression().annotation().type)) {
+				if (auto enumType = to<EnumType>(typeType->actualType())) {
+					return enumType->memberValue(memberAccess->memberName());
+				}
+			}
+		}
+		if (!*e.annotation().isPure) {
+			return {};
+		}
+		return ExprUtils::constValue(e);
+	};
+	auto variableOf = [](Expression const& e) -> VariableDeclaration const* {
+		auto ident = to<Identifier>(&e);
+		if (ident == nullptr) {
+			return nullptr;
+		}
+		auto vd = to<VariableDeclaration>(ident->annotation().referencedDeclaration);
+		if (vd == nullptr || vd->isConstant()) {
+			return nullptr;
+		}
+		Type::Category cat = vd->type()->category();
+		if (cat != Type::Category::Integer && cat != Type::Category::Enum) {
+			return nullptr;
+		}
+		return vd;
+	};
+	// the default branch is duplicated in each leaf of the search tree, so it must be tiny
+	auto isSmall = [](Statement const* st) {
+		if (auto block = to<Block>(st)) {
+			if (block->statements().empty()) {
+				return true;
+			}
+			if (block->statements().size() != 1) {
+				return false;
+			}
+			st = block->statements().at(0).get();
+		}
+		return to<ExpressionStatement>(st) || to<Return>(st) || to<Break>(st) || to<Continue>(st);
+	};
+
+	EqualityChain chain;
+	VariableDeclaration const* variable{};
+	std::set<bigint> values;
+	Statement const* st = &_ifStatement;
+	while (auto ifStatement = to<IfStatement>(st)) {
+		auto binOp = to<BinaryOperation>(&ifStatement->condition());
+		if (binOp == nullptr || binOp->getOperator() != Token::Equal) {
+			return {};
+		}
+		Expression const* subject = &binOp->leftExpression();
+		std::optional<bigint> value = caseValue(binOp->rightExpression());
+		if (!value) {
+			subject = &binOp->rightExpression();
+			value = caseValue(binOp->leftExpression());
+		}
+		VariableDeclaration const* vd = variableOf(*subject);
+		if (!value || vd == nullptr || (variable != nullptr && variable != vd) || !values.insert(*value).second) {
+			return {};
+		}
+		variable = vd;
+		if (chain.subject == nullptr) {
+			chain.subject = subject;
+		}
+		chain.cases.emplace_back(*value, &ifStatement->trueStatement());
+		st = ifStatement->falseStatement();
+	}
+	if (static_cast<int>(chain.cases.size()) < minCaseQty || (st != nullptr && !isSmall(st))) {
+		return {};
+	}
+	chain.defaultStatement = st;
+	std::sort(chain.cases.begin(), chain.cases.end(), [](auto const& a, auto const& b){
+		return a.first < b.first;
+	});
+	return chain;
+}
+
+// Lowers an equality chain to a balanced binary search over the sorted case values, like
+// buildPublicFunctionSelector does for function ids. Branches are called (not jumped to) so
+// return/break/continue are handled by the flag of the whole chain.
+void TVMFunctionCompiler::visitEqualityChain(IfStatement const& _ifStatement, EqualityChain const& chain) {
+	const int saveStackSize = m_pusher.stackSize();
+
+	CFAnalyzer ci(_ifStatement);
+	ControlFlowInfo info = beforeTryOrIfCheck(ci);
+	m_controlFlowInfo.push_back(info);
+
+	visitEqualityCases(chain, 0, chain.cases.size());
+
+	afterTryOrIfCheck(info);
+	m_pusher.ensureSize(saveStackSize, "");
+}
+
+void TVMFunctionCompiler::visitEqualityCases(EqualityChain const& chain, int left, int right) {
+	const int leafSize = 3;
+
+	auto pushCondition = [&](bigint const& value, std::string const& cmp) {
+		acceptExpr(chain.subject);
+		m_pusher.pushInt(value);
+		m_pusher << cmp;
+		m_pusher.fixStack(-1); // drop condition
+	};
+
+	if (right - left > leafSize) {
+		int mid = (left + right) / 2;
+		pushCondition(chain.cases.at(mid - 1).first, "LEQ");
+		m_pusher.startContinuation();
+		visitEqualityCases(chain, left, mid);
+		endContinuation2(true);
+		m_pusher.startContinuation();
+		visitEqualityCases(chain, mid, right);
+		endContinuation2(true);
+		m_pusher.ifElse();
+		return;
+	}
+
+	if (left == right) {
+		if (chain.defaultStatement != nullptr) {
+			chain.defaultStatement->accept(*this);
+		}
+		return;
+	}
+
+	auto const& [value, body] = chain.cases.at(left);
+	pushCondition(value, "EQUAL");
+	m_pusher.startContinuation();
+	body->accept(*this);
+	endContinuation2(true);
+	if (left + 1 == right && chain.defaultStatement == nullptr) {
+		m_pusher._if();
+	} else {
+		m_pusher.startContinuation();
+		visitEqualityCases(chain, left + 1, right);
+		endContinuation2(true);
+		m_pusher.ifElse();
+	}
+}
+
 void TVMFunctionCompiler::doWhile(WhileStatement const &_whileStatement) {
 	int saveStackSize = m_pusher.stackSize();
 
@@ -1007,10 +1185,21 @@ void TVMFunctionCompiler::doWhile(WhileStatement const &_whileStatement) {
 //	ControlFlowInfo info;
 //	std::tie(ci, info) = pushControlFlowFlag(_whileStatement.body());
 
+	// `continue` either runs the condition itself or leaves the wrapped body
+	std::function<void()> pushCondition = [&]() {
+		acceptExpr(&_whileStatement.condition(), true);
+		m_pusher << "NOT";
+	};
+	bool const inlineCondition = ci->canContinue() &&
+		canInlineContinueTail(_whileStatement.body(), astNodeQty(_whileStatement.condition()) + 1);
+	if (inlineCondition) {
+		m_controlFlowInfo.back().setContinueTail(&pushCondition);
+	}
+
 	// body
 	m_pusher.startContinuation();
 	int ss = m_pusher.stackSize();
-	if (ci->canReturn() || ci->canBreak() || ci->canContinue()) {
+	if (ci->canContinue() && !inlineCondition) {
 		m_pusher.startContinuation();
 		_whileStatement.body().accept(*this);
 		m_pusher.drop(m_pusher.stackSize() - ss);
@@ -1021,8 +1210,7 @@ void TVMFunctionCompiler::doWhile(WhileStatement const &_whileStatement) {
 	}
 
 	// condition
-	acceptExpr(&_whileStatement.condition(), true);
-	m_pusher << "NOT";
+	pushCondition();
 	m_pusher.fixStack(-1); // drop condition
 	m_pusher.endContinuation();
 
@@ -1101,10 +1289,12 @@ void TVMFunctionCompiler::afterTryOrIfCheck(ControlFlowInfo const& info) {
 }
 
 bool TVMFunctionCompiler::visit(WhileStatement const &_whileStatement) {
+	std::vector<VariableDeclaration const*> invariants = pushLoopInvariants(_whileStatement);
 	int saveStackSizeForWhile = m_pusher.stackSize();
 
 	if (_whileStatement.loopType() == WhileStatement::LoopType::DO_WHILE) {
 		doWhile(_whileStatement);
+		dropLoopInvariants(invariants);
 		return false;
 	}
 
@@ -1143,6 +1333,7 @@ bool TVMFunctionCompiler::visit(WhileStatement const &_whileStatement) {
 	afterLoopCheck(ci, 0, info.hasAnalyzeFlag());
 
 	m_pusher.ensureSize(saveStackSizeForWhile, "");
+	dropLoopInvariants(invariants);
 
 	return false;
 }
@@ -1168,6 +1359,7 @@ bool TVMFunctionCompiler::visit(ForEachStatement const& _forStatement) {
 	// private key (not visible in solidity code)
 	// [return flag] - optional. If have return/break/continue.
 
+	std::vector<VariableDeclaration const*> invariants = pushLoopInvariants(_forStatement);
 	const int saveStackSize = m_pusher.stackSize();
 	TVMExpressionCompiler ec{m_pusher};
 	ec.acceptExpr(_forStatement.rangeExpression(), true); // stack: dict
@@ -1316,11 +1508,16 @@ bool TVMFunctionCompiler::visit(ForEachStatement const& _forStatement) {
 			solUnimplemented("");
 		}
 	};
-	visitBodyOfForLoop(ci, pushStartBody, _forStatement.body(), pushLoopExpression);
+	// finding the next key of a mapping is too long to be copied to every `continue`
+	const int loopExpressionNodeQty =
+		!arrayType ? std::numeric_limits<int>::max() :
+		arrayType->isByteArrayOrString() ? 0 : 3;
+	visitBodyOfForLoop(ci, pushStartBody, _forStatement.body(), pushLoopExpression, loopExpressionNodeQty);
 
 	// bottom
 	afterLoopCheck(ci, loopVarQty, info.hasAnalyzeFlag());
 	m_pusher.ensureSize(saveStackSize, "for");
+	dropLoopInvariants(invariants);
 
 	return false;
 }
@@ -1340,12 +1537,59 @@ std::pair<std::unique_ptr<CFAnalyzer>, ControlFlowInfo> TVMFunctionCompiler::pus
 	return {std::move(ci), info};
 }
 
+// `continue` may run the code that follows the loop body (loopExpression, the condition of do-while)
+// and exit the body with RET. Then the body isn't wrapped into PUSHCONT {...} CALLX,
+// which is paid on every iteration.
+bool TVMFunctionCompiler::canInlineContinueTail(Statement const& body, int tailNodeQty) {
+	const int maxInlinedNodeQty = 16;
+	ContinueScanner scanner{body};
+	return scanner.allDirect() &&
+		tailNodeQty <= maxInlinedNodeQty &&
+		scanner.continueQty() * tailNodeQty <= maxInlinedNodeQty;
+}
+
+// State variables that are read in the loop and can't be changed there are read once before the loop.
+// Then the reads in the loop are stack reads instead of GETGLOB.
+std::vector<VariableDeclaration const*> TVMFunctionCompiler::pushLoopInvariants(Statement const& loop) {
+	// every hoisted value makes the locals deeper on the stack
+	const int maxInvariantQty = 3;
+	std::vector<VariableDeclaration const*> invariants;
+	for (VariableDeclaration const* vd : LoopInvariantScanner{loop}.invariantStateVariables()) {
+		if (static_cast<int>(invariants.size()) == maxInvariantQty) {
+			break;
+		}
+		if (m_pusher.getStack().isParam(vd)) {
+			continue; // it's already hoisted by an outer loop
+		}
+		m_pusher.getGlob(vd);
+		m_pusher.getStack().add(vd, false);
+		invariants.emplace_back(vd);
+	}
+	return invariants;
+}
+
+void TVMFunctionCompiler::dropLoopInvariants(std::vector<VariableDeclaration const*> const& invariants) {
+	m_pusher.drop(invariants.size());
+	for (VariableDeclaration const* vd : invariants) {
+		m_pusher.getStack().forget(vd);
+	}
+}
+
 void TVMFunctionCompiler::visitBodyOfForLoop(
 	const std::unique_ptr<CFAnalyzer>& ci,
 	const std::function<void()>& pushStartBody,
 	Statement const& body,
-	const std::function<void()>& loopExpression
+	const std::function<void()>& loopExpression,
+	int loopExpressionNodeQty,
+	bool isRepeat
 ) {
+	// `continue` runs loopExpression itself if it's short, otherwise it leaves the wrapped body
+	bool const inlineLoopExpression = ci->canContinue() && loopExpression &&
+		canInlineContinueTail(body, loopExpressionNodeQty);
+	if (inlineLoopExpression) {
+		m_controlFlowInfo.back().setContinueTail(&loopExpression);
+	}
+
 	// body and loopExpression
 	m_pusher.startContinuation();
 	if (pushStartBody) {
@@ -1353,7 +1597,7 @@ void TVMFunctionCompiler::visitBodyOfForLoop(
 	}
 
 	// take loop body
-	if (ci->canContinue()) { // TODO and have loopExpression
+	if (ci->canContinue() && loopExpression && !inlineLoopExpression) {
 		int ss = m_pusher.stackSize();
 		m_pusher.startContinuation();
 		body.accept(*this);
@@ -1369,16 +1613,21 @@ void TVMFunctionCompiler::visitBodyOfForLoop(
 		loopExpression();
 	}
 	m_pusher.endContinuation();
-	m_pusher._while(ci->canBreak() || ci->canReturn());
+	if (isRepeat) {
+		m_pusher.repeat(ci->canBreak() || ci->canReturn());
+	} else {
+		m_pusher._while(ci->canBreak() || ci->canReturn());
+	}
 	m_controlFlowInfo.pop_back();
 }
 
 bool TVMFunctionCompiler::visit(ForStatement const &_forStatement) {
 
-	// if in loop body there is at least one 'return', 'break' or `continue`:
+	// if in loop body there is a `continue` that can't run loopExpression itself
+	// (it's inside an `if` with a flag or loopExpression is long):
 	//
 	// decl loop var - optional
-	// return, break or continue flag  - optional
+	// return flag  - optional
 	// PUSHCONT {
 	//     condition
 	// }
@@ -1387,7 +1636,6 @@ bool TVMFunctionCompiler::visit(ForStatement const &_forStatement) {
 	//        body
 	//     }
 	//     CALLX
-	//     check return flag
 	//     loopExpression
 	// }
 
@@ -1402,7 +1650,15 @@ bool TVMFunctionCompiler::visit(ForStatement const &_forStatement) {
 	//     loopExpression
 	// }
 
+	std::vector<VariableDeclaration const*> invariants = pushLoopInvariants(_forStatement);
 	int saveStackSize = m_pusher.stackSize();
+	if (std::optional<CountedLoop> loop = CountedLoop::match(_forStatement)) {
+		visitCountedLoop(_forStatement, *loop);
+		m_pusher.ensureSize(saveStackSize, "for");
+		dropLoopInvariants(invariants);
+		return false;
+	}
+
 	// init
 	bool haveDeclLoopVar = false;
 	if (_forStatement.initializationExpression() != nullptr) {
@@ -1430,15 +1686,104 @@ bool TVMFunctionCompiler::visit(ForStatement const &_forStatement) {
 			_forStatement.loopExpression()->accept(*this);
 		};
 	}
-	visitBodyOfForLoop(ci, {}, _forStatement.body(), pushLoopExpression);
+	const int loopExpressionNodeQty = _forStatement.loopExpression() ? astNodeQty(*_forStatement.loopExpression()) : 0;
+	visitBodyOfForLoop(ci, {}, _forStatement.body(), pushLoopExpression, loopExpressionNodeQty);
 
 	// bottom
 	afterLoopCheck(ci, haveDeclLoopVar, info.hasAnalyzeFlag());
 	m_pusher.ensureSize(saveStackSize, "for");
+	dropLoopInvariants(invariants);
 
 	return false;
 }
 
+// The number of iterations is computed once and the loop runs with REPEAT:
+//
+// decl loop var - only if the body reads it
+// return, break or continue flag  - optional
+// bound - start, clamped to [0, 2^31-1] if it may be outside
+// PUSHCONT {
+//     body
+//     loopExpression - only if the body reads the loop var
+// }
+// REPEAT
+//
+// Loops with a few iterations known at compile time and a small body are unrolled.
+void TVMFunctionCompiler::visitCountedLoop(ForStatement const& _forStatement, CountedLoop const& loop) {
+	const int maxUnrolledIterQty = 8;
+	const int maxUnrolledNodeQty = 64;
+	const int saveStackSize = m_pusher.stackSize();
+
+	if (loop.tripCount && *loop.tripCount <= 0) {
+		return; // start and bound are constants, so there is nothing to compute
+	}
+
+	CFAnalyzer flow{_forStatement.body()};
+	if (loop.tripCount &&
+		!flow.canBreak() && !flow.canContinue() && !flow.canReturn() &&
+		*loop.tripCount <= maxUnrolledIterQty &&
+		*loop.tripCount * astNodeQty(_forStatement.body()) <= maxUnrolledNodeQty
+	) {
+		const int iterQty = static_cast<int>(*loop.tripCount);
+		if (loop.indexIsRead) {
+			_forStatement.initializationExpression()->accept(*this);
+		}
+		for (int iter = 0; iter < iterQty; ++iter) {
+			int ss = m_pusher.stackSize();
+			_forStatement.body().accept(*this);
+			m_pusher.drop(m_pusher.stackSize() - ss);
+			if (loop.indexIsRead && iter + 1 < iterQty) {
+				_forStatement.loopExpression()->accept(*this);
+			}
+		}
+		m_pusher.drop(m_pusher.stackSize() - saveStackSize);
+		return;
+	}
+
+	if (loop.indexIsRead) {
+		_forStatement.initializationExpression()->accept(*this);
+		solAssert(m_pusher.stackSize() == saveStackSize + 1, "");
+	}
+
+	auto [ci, info] = pushControlFlowFlag(_forStatement.body());
+
+	// the iteration count
+	if (loop.indexIsRead) {
+		acceptExpr(loop.bound);
+		m_pusher.pushS(m_pusher.stackSize() - saveStackSize - 1);
+		m_pusher << "SUB";
+	} else if (ExprUtils::constValue(*loop.start) == bigint(0)) {
+		acceptExpr(loop.bound);
+	} else {
+		acceptExpr(loop.start);
+		acceptExpr(loop.bound);
+		m_pusher << "SUBR";
+	}
+	if (loop.inclusive) {
+		m_pusher << "INC";
+	}
+	if (loop.mayBeNegative) {
+		m_pusher.pushInt(0);
+		m_pusher << "MAX";
+	}
+	if (loop.mayExceedInt32) {
+		m_pusher.pushInt((bigint(1) << 31) - 1);
+		m_pusher << "MIN";
+	}
+	m_pusher.fixStack(-1); // fix stack, REPEAT takes the count
+
+	std::function<void()> pushLoopExpression;
+	if (loop.indexIsRead) {
+		pushLoopExpression = [&]() {
+			_forStatement.loopExpression()->accept(*this);
+		};
+	}
+	visitBodyOfForLoop(ci, {}, _forStatement.body(), pushLoopExpression,
+		astNodeQty(*_forStatement.loopExpression()), true);
+
+	afterLoopCheck(ci, loop.indexIsRead ? 1 : 0, info.hasAnalyzeFlag());
+}
+
 bool TVMFunctionCompiler::visit(Return const& _return) {
 	if (!_return.names().empty()) {
 		m_pusher.getGlob(TvmConst::C7::ReturnParams);
@@ -1528,14 +1873,21 @@ bool TVMFunctionCompiler::visit(Break const&) {
 
 bool TVMFunctionCompiler::visit(Continue const&) {
 	bool hasAnalyzer = lastAnalyzerBeforeLoop();
-	const int sizeDelta = m_pusher.stackSize() - lastLoop().value().stackSize();
+	const ControlFlowInfo loop = lastLoop().value();
+	const int sizeDelta = m_pusher.stackSize() - loop.stackSize();
 	m_pusher.startContinuation();
 
 	if (hasAnalyzer) {
-		m_pusher.drop(sizeDelta + (lastLoop().value().hasAnalyzeFlag() ? 1 : 0));
+		solAssert(loop.continueTail() == nullptr, "");
+		m_pusher.drop(sizeDelta + (loop.hasAnalyzeFlag() ? 1 : 0));
 		m_pusher.pushInt(TvmConst::CONTINUE_FLAG);
 	} else {
 		m_pusher.drop(sizeDelta);
+		if (std::function<void()> const* tail = loop.continueTail()) {
+			const int ss = m_pusher.stackSize();
+			(*tail)();
+			m_pusher.fixStack(ss - m_pusher.stackSize()); // fix stack, the loop takes the tail's values
+		}
 	}
 
 	m_pusher.ret();
@@ -1828,44 +2180,61 @@ TVMFunctionCompiler::generateMainInternal(TVMCompilerContext& ctx, ContractDefin
 }
 
 Pointer<Function> TVMFunctionCompiler::generateCheckResume(TVMCompilerContext& ctx) {
+	// c4 is parsed once: the header is loaded here and if there is no suspended continuation
+	// the rest of the slice is decoded to c7 (so c4_to_c7 isn't called later)
 	StackPusher pusher{&ctx};
-	// TODO: unite check resume and c4_to_c7 for not to parse c4 2 times
-	std::string code = R"(PUSHROOT
-CTOS
-PUSHINT offset
-LDSLICEX  ; beg_slice end_slice
-LDI 1
-SWAP
-PUSHCONT {
-	LDREFRTOS   ; beg_slice end_slice ref_slice
-	XCHG S2     ; ref_slice end beg
-	NEWC
-	STSLICE
-	STZERO
-	STSLICE
-	ENDC
-	POPROOT
-	LDMSGADDR
-	ROTREV
-	SDEQ
-	THROWIFNOT TvmConst::RuntimeException::WrongAwaitAddress
-	LDCONT
-	DROP
-	NIP
-	CALLREF {
-		CALL $c4_to_c7$
-	}
-	CALLX
-}
-PUSHCONT {
-	DROP2
-}
-IFELSE
-)";
-	boost::replace_all(code, "TvmConst::RuntimeException::WrongAwaitAddress", toString(TvmConst::RuntimeException::WrongAwaitAddress));
-	boost::replace_all(code, "offset", toString(256 + (pusher.ctx().storeTimestampInC4() ? 64 : 0) + 1));
-	vector<string> lines = split(code);
-	pusher.push(createNode<HardCode>(lines, 0, 0, false));
+	const bool hasTime = pusher.ctx().storeTimestampInC4();
+	const int headerQty = hasTime ? 2 : 1; // pubkey [timestamp]
+	std::vector<std::string> lines = {
+		"PUSHROOT",
+		"CTOS",
+		"LDU 256      ; pubkey c4",
+	};
+	if (hasTime) {
+		lines.emplace_back("LDU 64       ; pubkey timestamp c4");
+	}
+	std::vector<std::string> const awaitLines = {
+		"LDU 1        ; ctor flag",
+		"NIP",
+		"LDI 1        ; await flag",
+		"SWAP",
+		"PUSHCONT {",
+		// bounced src pubkey [timestamp] slice
+		"	LDREFRTOS   ; pubkey [timestamp] slice ref_slice",
+		"	NEWC",
+		"	PUSH S" + toString(headerQty + 2),
+		"	STUR 256",
+	};
+	lines.insert(lines.end(), awaitLines.begin(), awaitLines.end());
+	if (hasTime) {
+		lines.emplace_back("	PUSH S3");
+		lines.emplace_back("	STUR 64");
+	}
+	std::vector<std::string> const resumeLines = {
+		"	STONE       ; ctor flag",
+		"	STZERO      ; await flag",
+		"	PUSH S2",
+		"	STSLICER",
+		"	ENDC",
+		"	POPROOT",
+		"	LDMSGADDR   ; bounced src pubkey [timestamp] slice addr ref_slice",
+		"	SWAP",
+		"	PUSH S" + toString(headerQty + 3),
+		"	SDEQ",
+		"	THROWIFNOT " + toString(TvmConst::RuntimeException::WrongAwaitAddress),
+		"	LDCONT",
+		"	DROP",
+		"	BLKDROP2 " + toString(headerQty + 3) + ", 1",
+		"	CALLREF {",
+		"		CALL $c4_to_c7$",
+		"	}",
+		"	CALLX",
+		"}",
+		"IF",
+	};
+	lines.insert(lines.end(), resumeLines.begin(), resumeLines.end());
+	pusher.push(createNode<HardCode>(lines, 0, headerQty + 1, false));
+	c4SliceToC7(pusher);
 	return createNode<Function>(0, 0, "check_resume", Function::FunctionType::Macro, pusher.getBlock());
 }
 
@@ -97,16 +97,30 @@ private:
 	bool visit(ExpressionStatement const& _expressionStatement) override;
     bool visit(TryStatement const& _block) override;
 	bool visit(IfStatement const& _ifStatement) override;
+	struct EqualityChain {
+		Expression const* subject{};
+		std::vector<std::pair<bigint, Statement const*>> cases; // sorted by value
+		Statement const* defaultStatement{};
+	};
+	static std::optional<EqualityChain> findEqualityChain(IfStatement const& _ifStatement);
+	void visitEqualityChain(IfStatement const& _ifStatement, EqualityChain const& chain);
+	void visitEqualityCases(EqualityChain const& chain, int left, int right);
 	bool visit(WhileStatement const& _whileStatement) override;
 	bool visit(ForEachStatement const& _forStatement) override;
 	std::pair<std::unique_ptr<CFAnalyzer>, ControlFlowInfo> pushControlFlowFlag(Statement const& body);
+	std::vector<VariableDeclaration const*> pushLoopInvariants(Statement const& loop);
+	void dropLoopInvariants(std::vector<VariableDeclaration const*> const& invariants);
 	void visitBodyOfForLoop(
 		const std::unique_ptr<CFAnalyzer>&	 ci,
 		const std::function<void()>& pushStartBody,
 		Statement const& body,
-		const std::function<void()>& loopExpression
+		const std::function<void()>& loopExpression,
+		int loopExpressionNodeQty,
+		bool isRepeat = false
 	);
+	static bool canInlineContinueTail(Statement const& body, int tailNodeQty);
 	bool visit(ForStatement const& _forStatement) override;
+	void visitCountedLoop(ForStatement const& _forStatement, CountedLoop const& loop);
 	bool visit(Return const& _return) override;
 	bool visit(Break const&) override;
 	bool visit(Continue const&) override;
@@ -129,6 +143,8 @@ private:
 	void updC4IfItNeeds();
 	void pushReceiveOrFallback();
 
+	static void c4SliceToC7(StackPusher& pusher);
+
 	void buildPublicFunctionSelector(const std::vector<std::pair<uint32_t, std::string>>& functions, int left, int right);
     void pushLocation(const ASTNode& node, bool reset = false);
 
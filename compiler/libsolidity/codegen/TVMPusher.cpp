@@ -63,7 +63,7 @@ void StackPusher::pushLog() {
 
 // TODO move to function compiler
 Pointer<Function> StackPusher::generateC7ToT4Macro(bool forAwait) {
-	const std::vector<Type const *>& memberTypes = m_ctx->notConstantStateVariableTypes();
+	const std::vector<Type const *>& memberTypes = m_ctx->storedStateVariableTypes();
 	const int stateVarQty = memberTypes.size();
 	if (ctx().tooMuchStateVariables()) {
 		const int saveStack = stackSize();
@@ -622,8 +622,8 @@ void StackPusher::declRetFlag() {
 
 Pointer<AsymGen>
 StackPusher::makeAsym(const string& cmd) {
-	static std::set<string> asymOpcodes;
-	if (asymOpcodes.empty()) {
+	static std::set<string> const asymOpcodes = []() {
+		std::set<string> asymOpcodes;
 		for (std::string type : {"", "I", "U"}) {
 			for (std::string suf : {"", "REF"}) {
 				for (std::string op : {"MIN", "MAX"}) {
@@ -666,7 +666,8 @@ StackPusher::makeAsym(const string& cmd) {
 		asymOpcodes.insert("PLDSLICEXQ");
 		asymOpcodes.insert("SDATASIZEQ");
 		asymOpcodes.insert("SPLITQ");
-	}
+		return asymOpcodes;
+	}();
 
 	istringstream iss(cmd);
 	string baseCmd;
@@ -984,7 +985,7 @@ void StackPusher::tuple(int qty) {
 }
 
 void StackPusher::resetAllStateVars() {
-	std::vector<VariableDeclaration const *> const stateVariables = ctx().notConstantStateVariables();
+	std::vector<VariableDeclaration const *> const stateVariables = ctx().storedStateVariables();
 	if (m_ctx->tooMuchStateVariables()) {
 		pushC7();
 		*this << "FALSE";
@@ -2077,6 +2078,11 @@ void StackPusher::computeConstCell(std::string const& expName) {
 	pushCellOrSlice(createNode<PushCellOrSlice>(PushCellOrSlice::Type::PUSHREF_COMPUTE, expName, nullptr));
 }
 
+void StackPusher::pushConstCell(Pointer<PushCellOrSlice> const& cell) {
+	solAssert(cell->type() == PushCellOrSlice::Type::PUSHREF, "");
+	pushCellOrSlice(cell);
+}
+
 void StackPusher::computeConstSlice(std::string const& expName) {
 	pushCellOrSlice(createNode<PushCellOrSlice>(PushCellOrSlice::Type::PUSHREFSLICE_COMPUTE, expName, nullptr));
 }
@@ -2455,6 +2461,10 @@ void TVMStack::add(Declaration const *name, bool doAllocation) {
 	m_stackSize.at(m_size - 1) = name;
 }
 
+void TVMStack::forget(Declaration const *name) {
+	std::replace(m_stackSize.begin(), m_stackSize.end(), name, static_cast<Declaration const*>(nullptr));
+}
+
 int TVMStack::getOffset(Declaration const *name) const {
 	solAssert(isParam(name), "");
 	int stackSize = getStackSize(name);
@@ -2493,11 +2503,9 @@ void TVMStack::takeLast(int n) {
 }
 
 InherHelper::InherHelper(const ContractDefinition *contract) {
-	for (ContractDefinition const* c : contract->annotation().linearizedBaseContracts) {
-		for (FunctionDefinition const *_function : c->definedFunctions()) {
-			const std::set<CallableDeclaration const*>& b = _function->annotation().baseFunctions;
-			m_baseFunctions.insert(b.begin(), b.end());
-		}
+	for (FunctionDefinition const *_function : contract->linearizedDefinedFunctions()) {
+		const std::set<CallableDeclaration const*>& b = _function->annotation().baseFunctions;
+		m_baseFunctions.insert(b.begin(), b.end());
 	}
 }
 
@@ -2510,7 +2518,7 @@ void TVMCompilerContext::initMembers(ContractDefinition const *contract) {
 	m_contract = contract;
 
 	ignoreIntOverflow = m_pragmaHelper.hasIgnoreIntOverflow();
-	for (VariableDeclaration const *variable: notConstantStateVariables()) {
+	for (VariableDeclaration const *variable: storedStateVariables()) {
 		m_stateVarIndex[variable] = TvmConst::C7::FirstIndexForVariables + m_stateVarIndex.size();
 	}
 }
@@ -2531,13 +2539,17 @@ std::vector<VariableDeclaration const *> TVMCompilerContext::notConstantStateVar
 	return ::notConstantStateVariables(getContract());
 }
 
+std::vector<VariableDeclaration const *> TVMCompilerContext::storedStateVariables() const {
+	return ::storedStateVariables(getContract());
+}
+
 bool TVMCompilerContext::tooMuchStateVariables() const {
 	return notConstantStateVariables().size() >= TvmConst::C7::FirstIndexForVariables + 6;
 }
 
-std::vector<Type const *> TVMCompilerContext::notConstantStateVariableTypes() const {
+std::vector<Type const *> TVMCompilerContext::storedStateVariableTypes() const {
 	std::vector<Type const *> types;
-	for (VariableDeclaration const * var : notConstantStateVariables()) {
+	for (VariableDeclaration const * var : storedStateVariables()) {
 		types.emplace_back(var->type());
 	}
 	return types;
@@ -2603,12 +2615,10 @@ bool TVMCompilerContext::ignoreIntegerOverflow() const {
 
 FunctionDefinition const *TVMCompilerContext::afterSignatureCheck() const {
 	FunctionDefinition const *res = {};
-	for (ContractDefinition const* c : m_contract->annotation().linearizedBaseContracts) {
-		for (FunctionDefinition const *f: c->definedFunctions()) {
-			if (f->name() == "afterSignatureCheck") {
-				solAssert(res == nullptr, "");
-				res = f;
-			}
+	for (FunctionDefinition const *f: m_contract->linearizedDefinedFunctions()) {
+		if (f->name() == "afterSignatureCheck") {
+			solAssert(res == nullptr, "");
+			res = f;
 		}
 	}
 	return res;
@@ -35,6 +35,7 @@ public:
 	void change(int take, int ret);
 	bool isParam(Declaration const* name) const;
 	void add(Declaration const* name, bool doAllocation);
+	void forget(Declaration const* name);
 	int getOffset(Declaration const* name) const;
 	int getOffset(int stackPos) const;
 	int getStackSize(Declaration const* name) const;
@@ -60,8 +61,10 @@ public:
 	void initMembers(ContractDefinition const* contract);
 	int getStateVarIndex(VariableDeclaration const *variable) const;
 	std::vector<VariableDeclaration const *> notConstantStateVariables() const;
+	// order of state variables in c4 and c7
+	std::vector<VariableDeclaration const *> storedStateVariables() const;
 	bool tooMuchStateVariables() const;
-	std::vector<Type const *> notConstantStateVariableTypes() const;
+	std::vector<Type const *> storedStateVariableTypes() const;
 	PragmaDirectiveHelper const& pragmaHelper() const;
 	bool isStdlib() const;
 	std::string getFunctionInternalName(FunctionDefinition const* _function, bool calledByPoint = true) const;
@@ -263,6 +266,7 @@ public:
 	void pushCallOrCallRef(const std::string& functionName, FunctionType const* ft, const std::optional<std::pair<int, int>>& deltaStack = std::nullopt);
 	void pushMacro(int take, int ret, const std::string& functionName);
 	void computeConstCell(std::string const& expName);
+	void pushConstCell(Pointer<PushCellOrSlice> const& cell);
 	void computeConstSlice(std::string const& expName);
 	void drop(int cnt = 1);
 	void blockSwap(int down, int up);
@@ -37,6 +37,18 @@ TVMTypeChecker::TVMTypeChecker(langutil::ErrorReporter& _errorReporter) :
 
 }
 
+void TVMTypeChecker::checkContract(ContractDefinition const& _contract) {
+	visit(_contract);
+	endVisit(_contract);
+}
+
+void TVMTypeChecker::check(ASTNode const& _node, ContractDefinition const* _contract) {
+	contractDefinition = _contract;
+	_node.accept(*this);
+	contractDefinition = nullptr;
+	m_inherHelper = nullptr;
+}
+
 void TVMTypeChecker::checkOverrideAndOverload() {
 	std::set<CallableDeclaration const*> overridedFunctions;
 	std::set<CallableDeclaration const*> functions;
@@ -159,7 +171,7 @@ void TVMTypeChecker::check_onCodeUpgrade(FunctionDefinition const& f) {
 }
 
 bool TVMTypeChecker::visit(TryStatement const& _tryStatement) {
-	if (*GlobalParams::g_tvmVersion == TVMVersion::ton()) {
+	if (GlobalParams::g_tvmVersion == TVMVersion::ton()) {
 		m_errorReporter.typeError(228_error, _tryStatement.location(),
 								  "\"try-catch\"" + isNotSupportedVM);
 	}
@@ -346,19 +358,19 @@ void TVMTypeChecker::checkSupport(FunctionCall const& _functionCall) {
 		auto functionType = to<FunctionType>(expressionType);
 		switch (functionType->kind()) {
 		case FunctionType::Kind::GasLeft:
-			if (*GlobalParams::g_tvmVersion == TVMVersion::ton()) {
+			if (GlobalParams::g_tvmVersion == TVMVersion::ton()) {
 				m_errorReporter.typeError(228_error, _functionCall.location(),
 										  "\"gasleft()\"" + isNotSupportedVM);
 			}
 			break;
 		case FunctionType::Kind::TVMInitCodeHash:
-			if (*GlobalParams::g_tvmVersion == TVMVersion::ton()) {
+			if (GlobalParams::g_tvmVersion == TVMVersion::ton()) {
 				m_errorReporter.typeError(228_error, _functionCall.location(),
 										  "\"tvm.initCodeHash()\"" + isNotSupportedVM);
 			}
 			break;
 		case FunctionType::Kind::TVMCode:
-			if (*GlobalParams::g_tvmVersion == TVMVersion::ton()) {
+			if (GlobalParams::g_tvmVersion == TVMVersion::ton()) {
 				m_errorReporter.typeError(228_error, _functionCall.location(),
 										  "\"tvm.code()\"" + isNotSupportedVM);
 			}
@@ -372,7 +384,7 @@ void TVMTypeChecker::checkSupport(FunctionCall const& _functionCall) {
 		break;
 	}
 
-	if (_functionCall.isAwait() && *GlobalParams::g_tvmVersion == TVMVersion::ton()) {
+	if (_functionCall.isAwait() && GlobalParams::g_tvmVersion == TVMVersion::ton()) {
 		m_errorReporter.typeError(228_error, _functionCall.location(),
 								  "\"*.await\"" + isNotSupportedVM);
 	}
@@ -391,6 +403,8 @@ bool TVMTypeChecker::visit(FunctionCall const& _functionCall) {
 		if (functionType->hasDeclaration()) {
 			auto fd = to<FunctionDefinition>(&functionType->declaration());
 			if (fd && fd->name() == "onCodeUpgrade") {
+				if (!m_inherHelper)
+					m_inherHelper = std::make_unique<InherHelper>(contractDefinition);
 				if (m_inherHelper->isBaseFunction(fd)) {
 					m_errorReporter.typeError(
 						228_error, _functionCall.location(),
@@ -431,7 +445,7 @@ bool TVMTypeChecker::visit(FunctionCall const& _functionCall) {
 
 bool TVMTypeChecker::visit(PragmaDirective const& _pragma) {
 	if (!_pragma.literals().empty()) {
-		if (_pragma.literals().at(0) == "copyleft" && *GlobalParams::g_tvmVersion == TVMVersion::ton()) {
+		if (_pragma.literals().at(0) == "copyleft" && GlobalParams::g_tvmVersion == TVMVersion::ton()) {
 			m_errorReporter.typeError(228_error, _pragma.location(),
 									  "\"pragma copyleft ...\"" + isNotSupportedVM);
 		}
@@ -452,7 +466,7 @@ bool TVMTypeChecker::visit(MemberAccess const& _memberAccess) {
 										R"("tx.timestamp" is deprecated. Use "tx.logicaltime".)");
 			}
 			if (member == "storageFee") {
-				if (*GlobalParams::g_tvmVersion == TVMVersion::ton()) {
+				if (GlobalParams::g_tvmVersion == TVMVersion::ton()) {
 					m_errorReporter.typeError(228_error, _memberAccess.location(),
 											  "\"tx.storageFee\"" + isNotSupportedVM);
 				}
@@ -460,7 +474,7 @@ bool TVMTypeChecker::visit(MemberAccess const& _memberAccess) {
 			break;
 		}
 		case MagicType::Kind::Gosh: {
-			if (*GlobalParams::g_tvmVersion != TVMVersion::gosh()) {
+			if (GlobalParams::g_tvmVersion != TVMVersion::gosh()) {
 				m_errorReporter.typeError(228_error, _memberAccess.location(),
 										  "\"gosh." + member + "\"" + isNotSupportedVM);
 			}
@@ -480,8 +494,6 @@ bool TVMTypeChecker::visit(MemberAccess const& _memberAccess) {
 bool TVMTypeChecker::visit(ContractDefinition const& cd) {
 	contractDefinition = &cd;
 
-	m_inherHelper = std::make_unique<InherHelper>(&cd);
-
 	checkOverrideAndOverload();
 
 	return true;
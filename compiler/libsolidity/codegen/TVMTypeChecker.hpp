@@ -21,6 +21,12 @@ class TVMTypeChecker : public ASTConstVisitor {
 public:
 	explicit TVMTypeChecker(langutil::ErrorReporter& _errorReporter);
 
+	/// Checks @a _contract without its sub-nodes, they may be checked separately by check().
+	void checkContract(ContractDefinition const& _contract);
+	/// Checks @a _node and its sub-nodes, @a _contract is the contract that defines the node
+	/// or nullptr for the nodes at file level.
+	void check(ASTNode const& _node, ContractDefinition const* _contract);
+
 private:
 	void checkOverrideAndOverload();
 	void check_onCodeUpgrade(FunctionDefinition const& f);
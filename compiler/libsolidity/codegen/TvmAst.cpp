@@ -146,7 +146,7 @@ AsymGen::AsymGen(std::string opcode) :
 	m_opcode(std::move(opcode))
 {
 	if (boost::starts_with(m_opcode, "ZERO"))
-		solAssert(*GlobalParams::g_tvmVersion != langutil::TVMVersion::ton(), "");
+		solAssert(GlobalParams::g_tvmVersion != langutil::TVMVersion::ton(), "");
 }
 
 void HardCode::accept(TvmAstVisitor& _visitor) {
@@ -258,35 +258,38 @@ int TvmException::take() const {
 void PushCellOrSlice::accept(TvmAstVisitor& _visitor) {
 	if (_visitor.visit(*this))
 	{
-		if (m_child) {
-			m_child->accept(_visitor);
+		for (Pointer<PushCellOrSlice> const& ref : m_refs) {
+			ref->accept(_visitor);
 		}
 	}
 }
 
 bool PushCellOrSlice::operator==(TvmAstNode const& _node) const {
 	auto p = to<PushCellOrSlice>(&_node);
-	if (p && std::tie(m_type, m_blob) == std::tie(p->m_type, p->m_blob)) {
-		if ((m_child == nullptr) ^ (p->m_child == nullptr)) {
-			return false;
-		}
-		if (m_child == nullptr) {
-			// p->m_child == nullptr also
-			return true;
+	if (p && std::tie(m_type, m_blob) == std::tie(p->m_type, p->m_blob) && m_refs.size() == p->m_refs.size()) {
+		for (size_t i = 0; i < m_refs.size(); ++i) {
+			if (!(*m_refs.at(i) == *p->m_refs.at(i))) {
+				return false;
+			}
 		}
-		return *m_child.get() == *p->m_child.get();
+		return true;
 	}
 	return false;
 }
 
 bool PushCellOrSlice::operator<(TvmAstNode const& _node) const {
 	auto p = to<PushCellOrSlice>(&_node);
-	if ((m_child == nullptr) ^ (p->m_child == nullptr)) {
-		return m_child < p->m_child;
-	}
-	if (m_child == nullptr)
+	if (std::tie(m_type, m_blob) != std::tie(p->m_type, p->m_blob))
 		return std::tie(m_type, m_blob) < std::tie(p->m_type, p->m_blob);
-	return std::tie(m_type, m_blob, *m_child) < std::tie(p->m_type, p->m_blob, *p->m_child);
+	if (m_refs.size() != p->m_refs.size())
+		return m_refs.size() < p->m_refs.size();
+	for (size_t i = 0; i < m_refs.size(); ++i) {
+		if (*m_refs.at(i) < *p->m_refs.at(i))
+			return true;
+		if (*p->m_refs.at(i) < *m_refs.at(i))
+			return false;
+	}
+	return false;
 }
 
 std::string PushCellOrSlice::chainBlob() const {
@@ -294,6 +297,7 @@ std::string PushCellOrSlice::chainBlob() const {
 	PushCellOrSlice const* p = this;
 	while (p != nullptr) {
 		solAssert(p->blob().at(0) == 'x');
+		solAssert(p->refs().size() <= 1);
 		s += p->blob().substr(1);
 		p = p->child().get();
 	}
@@ -470,7 +474,7 @@ Pointer<GenOpcode> gen(const std::string& cmd) {
 		iss >> op >> param;
 	}
 
-	if (*GlobalParams::g_tvmVersion == langutil::TVMVersion::ton())
+	if (GlobalParams::g_tvmVersion == langutil::TVMVersion::ton())
 		solAssert(!isIn(op, "COPYLEFT", "INITCODEHASH", "MYCODE", "LDCONT", "STCONT"), "");
 
 	auto f = [&](const std::string& pattert) {
@@ -992,6 +996,38 @@ bool isPureGen01(TvmAstNode const& node) {
 	return gen && gen->isPure() && gen->take() == 0 && gen->ret() == 1;
 }
 
+bool hasRetOrJmp(TvmAstNode const* _node) {
+	if (auto opaque = to<Opaque>(_node)) {
+		for (Pointer<TvmAstNode> const& i : opaque->block()->instructions()) {
+			if (hasRetOrJmp(i.get())) {
+				return true;
+			}
+		}
+	}
+	if (auto cb = to<CodeBlock>(_node)) {
+		for (Pointer<TvmAstNode> const& i : cb->instructions()) {
+			if (hasRetOrJmp(i.get())) {
+				return true;
+			}
+		}
+	}
+	if (to<ReturnOrBreakOrCont>(_node)) {
+		return true;
+	}
+	if (to<TvmReturn>(_node)) {
+		return true;
+	}
+	if (auto sub = to<SubProgram>(_node)) {
+		if (sub->isJmp())
+			return true;
+	}
+	if (auto isElse = to<TvmIfElse>(_node)) {
+		if (isElse->withJmp())
+			return true;
+	}
+	return false;
+}
+
 bool isSWAP(Pointer<TvmAstNode> const& node) {
 	return isBLKSWAP(node) && isBLKSWAP(node).value() == std::make_pair(1, 1);
 }
@@ -267,8 +267,17 @@ namespace solidity::frontend
 		PushCellOrSlice(Type type, std::string blob, Pointer<PushCellOrSlice> child) :
 			Gen{true}, // we don't execute data
 			m_type{type},
+			m_blob{std::move(blob)}
+		{
+			if (child) {
+				m_refs.emplace_back(std::move(child));
+			}
+		}
+		PushCellOrSlice(Type type, std::string blob, std::vector<Pointer<PushCellOrSlice>> refs) :
+			Gen{true},
+			m_type{type},
 			m_blob{std::move(blob)},
-			m_child{std::move(child)}
+			m_refs{std::move(refs)}
 		{
 		}
 		void accept(TvmAstVisitor& _visitor) override;
@@ -279,12 +288,14 @@ namespace solidity::frontend
 		Type type() const  { return m_type; }
 		std::string const &blob() const { return m_blob; }
 		std::string chainBlob() const;
-		Pointer<PushCellOrSlice> child() const { return m_child; }
+		// the first reference of the cell, the only one for chains of cells
+		Pointer<PushCellOrSlice> child() const { return m_refs.empty() ? nullptr : m_refs.front(); }
+		std::vector<Pointer<PushCellOrSlice>> const& refs() const { return m_refs; }
 		void updToRef();
 	private:
 		Type m_type;
 		std::string m_blob;
-		Pointer<PushCellOrSlice> m_child;
+		std::vector<Pointer<PushCellOrSlice>> m_refs;
 	};
 
 	class CodeBlock : public TvmAstNode {
@@ -530,6 +541,7 @@ namespace solidity::frontend
 	Pointer<TvmIfElse> flipIfElse(TvmIfElse const& node);
 
 	bool isPureGen01(TvmAstNode const& node);
+	bool hasRetOrJmp(TvmAstNode const* _node);
 	bool isSWAP(Pointer<TvmAstNode> const& node);
 	std::optional<std::pair<int, int>> isBLKSWAP(Pointer<TvmAstNode> const& node);
 	std::optional<int> isDrop(Pointer<TvmAstNode> const& node);
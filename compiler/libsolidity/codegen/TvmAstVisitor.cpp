@@ -17,6 +17,8 @@
 #include <ostream>
 #include <memory>
 
+#include <boost/algorithm/string/trim.hpp>
+
 #include <libsolidity/codegen/TvmAstVisitor.hpp>
 #include <liblangutil/Exceptions.h>
 #include "TVMCommons.hpp"
@@ -182,8 +184,8 @@ bool Printer::visit(PushCellOrSlice &_node) {
 		tabs();
 		m_out << ".blob " << _node.blob() << std::endl;
 	}
-	if (_node.child()) {
-		_node.child()->accept(*this);
+	for (Pointer<PushCellOrSlice> const& ref : _node.refs()) {
+		ref->accept(*this);
 	}
 	--m_tab;
 
@@ -741,30 +743,33 @@ void Printer::tabs() {
 }
 
 void Printer::printPushInt(std::string const& str, std::string const& comment) {
-	static std::map<bigint, int> power2;
-	static std::map<bigint, int> power2Dec;
-	static std::map<bigint, int> power2Neg;
-	if (power2.empty()) {
+	static std::map<bigint, int> const power2 = [](){
+		std::map<bigint, int> res;
 		bigint p2 = 128;
 		for (int p = 7; p <= 256; ++p) {
-			power2[p2] = p;
+			res[p2] = p;
 			p2 *= 2;
 		}
-	}
-	if (power2Dec.empty()) {
+		return res;
+	}();
+	static std::map<bigint, int> const power2Dec = [](){
+		std::map<bigint, int> res;
 		bigint p2 = 256;
 		for (int p = 8; p <= 256; ++p) {
-			power2Dec[p2 - 1] = p;
+			res[p2 - 1] = p;
 			p2 *= 2;
 		}
-	}
-	if (power2Neg.empty()) {
+		return res;
+	}();
+	static std::map<bigint, int> const power2Neg = [](){
+		std::map<bigint, int> res;
 		bigint p2 = 256;
 		for (int p = 8; p <= 256; ++p) {
-			power2Neg[-p2] = p;
+			res[-p2] = p;
 			p2 *= 2;
 		}
-	}
+		return res;
+	}();
 
 	bool didPrint = false;
 	if (str.at(0) != '$') {
@@ -873,6 +878,459 @@ bool DeleterCallX::visit(Function &_node) {
 	return false;
 }
 
+namespace {
+// Finds the places where macros are inlined and whether such a place is the end of a continuation
+class InlinePlaces : public TvmAstVisitor {
+public:
+	struct Place {
+		std::string macro;
+		std::string container; // the macro whose body ends with this place, empty if it's a continuation
+		bool atEnd{};
+	};
+
+	bool visit(Function &_node) override {
+		bool const isMacro = isIn(_node.type(), Function::FunctionType::Macro, Function::FunctionType::MacroGetter);
+		m_macroBody = isMacro ? _node.block().get() : nullptr;
+		m_macro = isMacro ? _node.name() : "";
+		return true;
+	}
+
+	// the code of these blocks is a part of the enclosing code, not a separate continuation
+	bool visit(Opaque &_node) override {
+		m_inlineBlocks.insert(_node.block().get());
+		return true;
+	}
+
+	bool visit(ReturnOrBreakOrCont &_node) override {
+		m_inlineBlocks.insert(_node.body().get());
+		return true;
+	}
+
+	bool visit(HardCode &_node) override {
+		for (std::string const& line : _node.code()) {
+			if (auto pos = line.find(".inline __"); pos != std::string::npos) {
+				places.push_back({boost::algorithm::trim_copy(line.substr(pos + std::string{".inline __"}.size())), "", false});
+			}
+		}
+		return false;
+	}
+
+	bool visit(CodeBlock &_node) override {
+		std::vector<Pointer<TvmAstNode>> const& inst = _node.instructions();
+		int last = static_cast<int>(inst.size()) - 1;
+		while (last >= 0 && isLoc(inst.at(last)))
+			--last;
+		bool const isMacroBody = &_node == m_macroBody;
+		bool const isInline = m_inlineBlocks.count(&_node) != 0;
+		for (int i = 0; i < static_cast<int>(inst.size()); ++i) {
+			auto gen = to<GenOpcode>(inst.at(i).get());
+			if (gen && gen->opcode() == ".inline" && boost::starts_with(gen->arg(), "__")) {
+				places.push_back({
+					gen->arg().substr(2),
+					isMacroBody ? m_macro : "",
+					i == last && (isMacroBody || !isInline)
+				});
+			}
+		}
+		return true;
+	}
+
+	std::vector<Place> places;
+private:
+	CodeBlock const* m_macroBody{};
+	std::string m_macro;
+	std::set<CodeBlock const*> m_inlineBlocks;
+};
+}
+
+bool TailCallOptimizer::visit(Contract &_node) {
+	for (Pointer<Function> const& f : _node.functions()) {
+		switch (f->type()) {
+			case Function::FunctionType::PrivateFunction:
+			case Function::FunctionType::PrivateFunctionWithObj:
+				m_tailMacros.insert(f->name() + "_macro");
+				break;
+			default:
+				break;
+		}
+	}
+
+	// A macro of a private function is rewritten only if every place it's inlined at is the end
+	// of a continuation, directly or through the end of another such macro
+	InlinePlaces finder;
+	for (Pointer<Function> const& f : _node.functions()) {
+		f->accept(finder);
+	}
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (InlinePlaces::Place const& place : finder.places) {
+			bool const isTail = place.atEnd && (place.container.empty() || m_tailMacros.count(place.container) != 0);
+			if (!isTail && m_tailMacros.erase(place.macro) != 0) {
+				changed = true;
+			}
+		}
+	}
+	return true;
+}
+
+bool TailCallOptimizer::visit(Function &_node) {
+	switch (_node.type()) {
+		case Function::FunctionType::PrivateFunction:
+		case Function::FunctionType::PrivateFunctionWithObj:
+			break;
+		case Function::FunctionType::Macro:
+			if (m_tailMacros.count(_node.name()) == 0)
+				return false;
+			if (selfRecursionToLoop(_node))
+				return false;
+			break;
+		default:
+			return false;
+	}
+
+	Pointer<CodeBlock> const& block = _node.block();
+	std::vector<Pointer<TvmAstNode>> inst = block->instructions();
+	auto prevNotLoc = [&](int i) {
+		--i;
+		while (i >= 0 && isLoc(inst.at(i)))
+			--i;
+		return i;
+	};
+
+	int const last = prevNotLoc(inst.size());
+	if (last < 0)
+		return false;
+	if (Pointer<TvmAstNode> jmp = toJump(inst.at(last))) {
+		inst.at(last) = jmp;
+		block->upd(inst);
+		return false;
+	}
+
+	// CALL; BLKDROP2 n, m  =>  BLKDROP2 n, take; JMP
+	// A called function uses only its arguments, so the values under them can be dropped before the call.
+	std::optional<std::pair<int, int>> const drop = dropUnder(inst.at(last));
+	int const call = prevNotLoc(last);
+	if (!drop || call < 0 || !isFunctionCall(inst.at(call)))
+		return false;
+	auto gen = to<Gen>(inst.at(call).get());
+	if (gen->ret() != drop->second)
+		return false;
+	Pointer<TvmAstNode> jmp = toJump(inst.at(call));
+	inst.erase(inst.begin() + last);
+	inst.at(call) = jmp;
+	inst.insert(inst.begin() + call, makeBLKDROP2(drop->first, gen->take()));
+	block->upd(inst);
+	return false;
+}
+
+// body
+// PUSHINT $f$
+// PUSH c3
+// EXECUTE
+// BLKDROP2 n, ret - optional
+// =>
+// PUSHCONT { TRUE }
+// PUSHCONT {
+//     body - returns from the function leave the loop with RETALT
+//     BLKDROP2 n, take - optional
+// }
+// AGAINBRK
+bool TailCallOptimizer::selfRecursionToLoop(Function &_node) {
+	std::vector<Pointer<TvmAstNode>> const& inst = _node.block()->instructions();
+	auto prevNotLoc = [&](int i) {
+		--i;
+		while (i >= 0 && isLoc(inst.at(i)))
+			--i;
+		return i;
+	};
+
+	int const last = prevNotLoc(inst.size());
+	if (last < 0)
+		return false;
+	int dropped = 0;
+	int call = last;
+	if (std::optional<std::pair<int, int>> const drop = dropUnder(inst.at(last))) {
+		if (drop->second != _node.ret())
+			return false;
+		dropped = drop->first;
+		call = prevNotLoc(last);
+	}
+	int const c3 = call < 0 ? -1 : prevNotLoc(call);
+	int const id = c3 < 0 ? -1 : prevNotLoc(c3);
+	if (id < 0)
+		return false;
+
+	std::string const name = _node.name().substr(0, _node.name().size() - std::string{"_macro"}.size());
+	auto execute = to<GenOpcode>(inst.at(call).get());
+	auto pushC3 = to<Glob>(inst.at(c3).get());
+	auto pushId = to<GenOpcode>(inst.at(id).get());
+	if (!execute || execute->fullOpcode() != "EXECUTE" ||
+		execute->take() != _node.take() + 2 || execute->ret() != _node.ret() ||
+		!pushC3 || pushC3->opcode() != Glob::Opcode::PUSH_C3 ||
+		!pushId || pushId->opcode() != "PUSHINT" || pushId->arg() != "$" + name + "$"
+	)
+		return false;
+
+	// Before the call the stack holds `dropped` locals and the new arguments,
+	// so the next iteration starts with the same layout as the function
+	std::optional<std::vector<Pointer<TvmAstNode>>> body = exitLoopOnReturn({inst.begin(), inst.begin() + id}, false);
+	if (!body)
+		return false;
+	if (dropped > 0)
+		body->emplace_back(makeBLKDROP2(dropped, _node.take()));
+
+	auto condition = createNode<CodeBlock>(CodeBlock::Type::PUSHCONT, std::vector<Pointer<TvmAstNode>>{gen("TRUE")});
+	auto loop = createNode<While>(true, true, condition, createNode<CodeBlock>(CodeBlock::Type::PUSHCONT, *body));
+	_node.block()->upd({loop});
+	return true;
+}
+
+// Copies the code of the function and replaces the returns from the function with RETALT.
+// Code inside called continuations and loops returns to the function, so it's kept as is.
+// Returns nullopt if the code may leave the function in an unknown way (e.g. a jump or TRY).
+std::optional<std::vector<Pointer<TvmAstNode>>> TailCallOptimizer::exitLoopOnReturn(
+	std::vector<Pointer<TvmAstNode>> const& inst,
+	bool isFunctionEnd
+) {
+	auto hasRetOrJmpOpcode = [](std::string const& opcode) {
+		return boost::starts_with(opcode, ".inline") ||
+			opcode.find("RET") != std::string::npos ||
+			opcode.find("JMP") != std::string::npos;
+	};
+
+	std::vector<Pointer<TvmAstNode>> res;
+	for (Pointer<TvmAstNode> const& node : inst) {
+		if (auto ret = to<TvmReturn>(node.get())) {
+			if (ret->withAlt())
+				return {};
+			res.emplace_back(createNode<TvmReturn>(ret->withIf(), ret->withNot(), true));
+		} else if (auto gen = to<GenOpcode>(node.get())) {
+			if (hasRetOrJmpOpcode(gen->opcode()))
+				return {};
+			res.emplace_back(node);
+		} else if (auto asym = to<AsymGen>(node.get())) {
+			if (hasRetOrJmpOpcode(asym->opcode()))
+				return {};
+			res.emplace_back(node);
+		} else if (auto hardCode = to<HardCode>(node.get())) {
+			for (std::string const& line : hardCode->code()) {
+				if (hasRetOrJmpOpcode(line))
+					return {};
+			}
+			res.emplace_back(node);
+		} else if (auto sub = to<SubProgram>(node.get())) {
+			if (sub->isJmp())
+				return {};
+			res.emplace_back(node);
+		} else if (auto opaque = to<Opaque>(node.get())) {
+			std::optional<std::vector<Pointer<TvmAstNode>>> block = exitLoopOnReturn(opaque->block()->instructions(), false);
+			if (!block)
+				return {};
+			res.emplace_back(createNode<Opaque>(
+				createNode<CodeBlock>(opaque->block()->type(), *block), opaque->take(), opaque->ret(), opaque->isPure()
+			));
+		} else if (auto retOrBreak = to<ReturnOrBreakOrCont>(node.get())) {
+			std::optional<std::vector<Pointer<TvmAstNode>>> block = exitLoopOnReturn(retOrBreak->body()->instructions(), false);
+			if (!block)
+				return {};
+			res.emplace_back(createNode<ReturnOrBreakOrCont>(
+				retOrBreak->take(), createNode<CodeBlock>(retOrBreak->body()->type(), *block)
+			));
+		} else if (auto ifElse = to<TvmIfElse>(node.get())) {
+			if (!ifElse->withJmp()) {
+				res.emplace_back(node);
+				continue;
+			}
+			if (ifElse->falseBody() != nullptr)
+				return {};
+			// the end of the jumped-to branch is the end of the function
+			std::optional<std::vector<Pointer<TvmAstNode>>> block = exitLoopOnReturn(ifElse->trueBody()->instructions(), true);
+			if (!block)
+				return {};
+			res.emplace_back(createNode<TvmIfElse>(
+				ifElse->withNot(), true, createNode<CodeBlock>(ifElse->trueBody()->type(), *block), nullptr, ifElse->ret()
+			));
+		} else if (to<TryCatch>(node.get()) || to<Function>(node.get()) || to<Contract>(node.get())) {
+			return {};
+		} else {
+			// loops, pushed continuations, stack and other plain opcodes
+			res.emplace_back(node);
+		}
+	}
+	if (isFunctionEnd && !endsWithExit(res)) {
+		res.emplace_back(makeRETALT());
+	}
+	return res;
+}
+
+bool TailCallOptimizer::endsWithExit(std::vector<Pointer<TvmAstNode>> const& inst) {
+	int last = static_cast<int>(inst.size()) - 1;
+	while (last >= 0 && isLoc(inst.at(last)))
+		--last;
+	if (last < 0)
+		return false;
+	if (auto ret = to<TvmReturn>(inst.at(last).get()))
+		return !ret->withIf();
+	if (auto exception = to<TvmException>(inst.at(last).get()))
+		return !exception->withIf();
+	if (auto retOrBreak = to<ReturnOrBreakOrCont>(inst.at(last).get()))
+		return endsWithExit(retOrBreak->body()->instructions());
+	return false;
+}
+
+std::optional<std::pair<int, int>> TailCallOptimizer::dropUnder(Pointer<TvmAstNode> const& node) {
+	auto stack = to<Stack>(node.get());
+	if (!stack)
+		return {};
+	switch (stack->opcode()) {
+		case Stack::Opcode::DROP:
+			return {{stack->i(), 0}};
+		case Stack::Opcode::POP_S:
+			if (stack->i() == 1)
+				return {{1, 1}};
+			return {};
+		case Stack::Opcode::BLKDROP2:
+			return {{stack->i(), stack->j()}};
+		default:
+			return {};
+	}
+}
+
+bool TailCallOptimizer::isFunctionCall(Pointer<TvmAstNode> const& node) {
+	if (auto sub = to<SubProgram>(node.get())) {
+		// CALLREF { .inline __f_macro }
+		std::vector<Pointer<TvmAstNode>> const& inst = sub->block()->instructions();
+		if (qtyWithoutLoc(inst) != 1)
+			return false;
+		for (Pointer<TvmAstNode> const& op : inst) {
+			if (auto gen = to<GenOpcode>(op.get()))
+				return boost::starts_with(gen->opcode(), ".inline");
+		}
+		return false;
+	}
+	auto gen = to<GenOpcode>(node.get());
+	return gen && gen->fullOpcode() == "EXECUTE";
+}
+
+Pointer<TvmAstNode> TailCallOptimizer::toJump(Pointer<TvmAstNode> const& node) {
+	if (auto sub = to<SubProgram>(node.get()); sub && !sub->isJmp()) {
+		return createNode<SubProgram>(sub->take(), sub->ret(), true, sub->block(), sub->isPure());
+	}
+	// recursive call via c3
+	if (auto gen = to<GenOpcode>(node.get()); gen && gen->fullOpcode() == "EXECUTE") {
+		return createNode<GenOpcode>("JMPX", gen->take(), gen->ret());
+	}
+	return nullptr;
+}
+
+bool ColdBranchOutliner::visit(CodeBlock &_node) {
+	if (m_profile == nullptr) {
+		return true;
+	}
+	std::optional<uint64_t> current;
+	for (Pointer<TvmAstNode> const& op : _node.instructions()) {
+		if (auto loc = to<Loc>(op.get())) {
+			if (std::optional<uint64_t> c = m_profile->count(loc->file(), loc->line())) {
+				current = c;
+			}
+		} else if (auto ifElse = to<TvmIfElse>(op.get()); ifElse && current) {
+			m_countBefore[ifElse] = *current;
+		}
+	}
+	return true;
+}
+
+bool ColdBranchOutliner::visit(TvmIfElse &_node) {
+	if (m_profile != nullptr && layoutByProfile(_node)) {
+		return true;
+	}
+	if (_node.falseBody() == nullptr) {
+		if (isCold(_node.trueBody())) {
+			_node.trueBody()->updType(CodeBlock::Type::PUSHREFCONT);
+		}
+	} else if (!_node.withNot()) {
+		// outline only one arm, otherwise both paths pay for loading a cell
+		bool const isTrueCold = isCold(_node.trueBody());
+		bool const isFalseCold = isCold(_node.falseBody());
+		if (isTrueCold && !isFalseCold) {
+			_node.trueBody()->updType(CodeBlock::Type::PUSHREFCONT);
+		} else if (!isTrueCold && isFalseCold) {
+			_node.falseBody()->updType(CodeBlock::Type::PUSHREFCONT);
+		}
+	}
+	return true;
+}
+
+// returns false if the profile has no data for the branches
+bool ColdBranchOutliner::layoutByProfile(TvmIfElse &_node) {
+	std::optional<uint64_t> const trueCount = count(_node.trueBody());
+	if (!trueCount) {
+		return false;
+	}
+	if (_node.falseBody() == nullptr) {
+		auto it = m_countBefore.find(&_node);
+		if (it == m_countBefore.end()) {
+			return false;
+		}
+		if (isRare(*trueCount, it->second) && canOutline(_node.trueBody())) {
+			_node.trueBody()->updType(CodeBlock::Type::PUSHREFCONT);
+		}
+		return true;
+	}
+	std::optional<uint64_t> const falseCount = count(_node.falseBody());
+	if (!falseCount) {
+		return false;
+	}
+	if (!_node.withNot()) {
+		if (isRare(*trueCount, *falseCount) && canOutline(_node.trueBody())) {
+			_node.trueBody()->updType(CodeBlock::Type::PUSHREFCONT);
+		} else if (isRare(*falseCount, *trueCount) && canOutline(_node.falseBody())) {
+			_node.falseBody()->updType(CodeBlock::Type::PUSHREFCONT);
+		}
+	}
+	return true;
+}
+
+// execution count of the first line of the block that is in the profile
+std::optional<uint64_t> ColdBranchOutliner::count(Pointer<CodeBlock> const& block) const {
+	for (Pointer<TvmAstNode> const& op : block->instructions()) {
+		if (auto loc = to<Loc>(op.get())) {
+			if (std::optional<uint64_t> c = m_profile->count(loc->file(), loc->line())) {
+				return c;
+			}
+		}
+	}
+	return {};
+}
+
+bool ColdBranchOutliner::isRare(uint64_t count, uint64_t reference) {
+	// a branch taken at most once per 8 executions is cold
+	const uint64_t coldRatio = 8;
+	return count == 0 || count <= reference / coldRatio;
+}
+
+bool ColdBranchOutliner::canOutline(Pointer<CodeBlock> const& block) {
+	// Tiny blocks are cheaper inline than behind a reference
+	const int minColdSize = 3;
+	return block->type() == CodeBlock::Type::PUSHCONT && qtyWithoutLoc(block->instructions()) >= minColdSize;
+}
+
+bool ColdBranchOutliner::isCold(Pointer<CodeBlock> const& block) {
+	if (!canOutline(block)) {
+		return false;
+	}
+	std::vector<Pointer<TvmAstNode>> const& inst = block->instructions();
+	for (auto it = inst.rbegin(); it != inst.rend(); ++it) {
+		if (to<Loc>(it->get())) {
+			continue;
+		}
+		auto _throw = to<TvmException>(it->get());
+		return _throw && !_throw->withIf();
+	}
+	return false;
+}
+
 void LogCircuitExpander::endVisit(CodeBlock &_node) {
 	std::vector<Pointer<TvmAstNode>> block;
 	for (Pointer<TvmAstNode> const& opcode : _node.instructions()) {
@@ -16,12 +16,16 @@
 
 #pragma once
 
+#include <map>
 #include <optional>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 #include <boost/noncopyable.hpp>
 
+#include <libsolidity/codegen/BranchProfile.hpp>
 #include <libsolidity/codegen/TvmAst.hpp>
 
 namespace solidity::frontend
@@ -110,6 +114,50 @@ public:
 	bool visit(Function &_node) override;
 };
 
+// Moves cold branches behind a reference, so that the hot path stays compact and the branch cell
+// is loaded only if it is taken. Without a profile the cold branches are the ones that always end
+// with an exception. With a profile they are the ones that are executed rarely compared to the code
+// around them, and a frequently executed branch stays inline even if it ends with an exception.
+class ColdBranchOutliner : public TvmAstVisitor {
+public:
+	explicit ColdBranchOutliner(BranchProfile const* _profile = nullptr) : m_profile{_profile} {}
+	bool visit(CodeBlock &_node) override;
+	bool visit(TvmIfElse &_node) override;
+private:
+	bool layoutByProfile(TvmIfElse &_node);
+	std::optional<uint64_t> count(Pointer<CodeBlock> const& block) const;
+	static bool isRare(uint64_t count, uint64_t reference);
+	static bool canOutline(Pointer<CodeBlock> const& block);
+	static bool isCold(Pointer<CodeBlock> const& block);
+private:
+	BranchProfile const* m_profile{};
+	// execution count of the code just before the `if`
+	std::map<TvmIfElse const*, uint64_t> m_countBefore;
+};
+
+// Replaces a call in tail position of a private function by a jump: the callee returns straight
+// to the caller's continuation, so tail calls don't nest continuations.
+// A recursive call in tail position is replaced by a loop over the function body (AGAINBRK),
+// so the arguments are rebound on the stack instead of dispatching through c3 on every level.
+class TailCallOptimizer : public TvmAstVisitor {
+public:
+	bool visit(Contract &_node) override;
+	bool visit(Function &_node) override;
+private:
+	bool selfRecursionToLoop(Function &_node);
+	static std::optional<std::vector<Pointer<TvmAstNode>>> exitLoopOnReturn(
+		std::vector<Pointer<TvmAstNode>> const& inst,
+		bool isFunctionEnd
+	);
+	static bool endsWithExit(std::vector<Pointer<TvmAstNode>> const& inst);
+	static std::optional<std::pair<int, int>> dropUnder(Pointer<TvmAstNode> const& node);
+	static bool isFunctionCall(Pointer<TvmAstNode> const& node);
+	static Pointer<TvmAstNode> toJump(Pointer<TvmAstNode> const& node);
+	// Macros of private functions whose bodies are inlined only at the end of a continuation,
+	// so a return from the body returns from the function
+	std::set<std::string> m_tailMacros;
+};
+
 class LogCircuitExpander : public TvmAstVisitor {
 public:
 	void endVisit(CodeBlock &_node) override;
@@ -64,6 +64,7 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <json/json.h>
 
@@ -71,6 +72,9 @@
 
 #include <range/v3/view/concat.hpp>
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <utility>
 #include <map>
 #include <limits>
@@ -93,22 +97,28 @@ using solidity::util::toHex;
 
 using solidity::util::h256;
 
-static int g_compilerStackCounts = 0;
+static thread_local int g_compilerStackCounts = 0;
 
 using namespace solidity::langutil;
 
 #include <stdlib.h>
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+	m_sourceNameScope{std::in_place},
 	m_readFile{std::move(_readFile)},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
+	// Because TypeProvider and GlobalParams are per thread singletons, we must ensure that
+	// no more than one entity is actually using them at a time in a thread.
 	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
 	GlobalParams::g_errorReporter = &m_errorReporter;
 	GlobalParams::g_charStreamProvider = this;
+	GlobalParams::g_tvmVersion = m_tvmVersion;
+	GlobalParams::g_branchProfile = nullptr;
+	GlobalParams::g_optimizerLimits = {};
+	GlobalParams::g_optimizationLevel = OptimiserSettings{}.tvmOptimizationLevel;
+	GlobalParams::g_packStateVariables = false;
 }
 
 CompilerStack::~CompilerStack()
@@ -124,7 +134,7 @@ void CompilerStack::createAndAssignCallGraphs()
 		if (!source->ast)
 			continue;
 
-		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+		for (ContractDefinition const* contract: source->ast->contracts())
 		{
 			ContractDefinitionAnnotation& annotation =
 				m_contracts.at(contract->fullyQualifiedName()).contract->annotation();
@@ -159,7 +169,7 @@ void CompilerStack::findAndReportCyclicContractDependencies()
 		if (!source->ast)
 			continue;
 
-		for (ContractDefinition const* contractDefinition: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+		for (ContractDefinition const* contractDefinition: source->ast->contracts())
 		{
 			util::CycleDetector<ContractDefinition> cycleDetector{[&](
 				ContractDefinition const& _contract,
@@ -237,6 +247,15 @@ void CompilerStack::setTVMVersion(langutil::TVMVersion _version)
 	GlobalParams::g_tvmVersion = m_tvmVersion;
 }
 
+void CompilerStack::setBranchProfile(std::shared_ptr<BranchProfile const> _profile)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set branch profile before compiling.");
+	m_branchProfile = std::move(_profile);
+
+	GlobalParams::g_branchProfile = m_branchProfile.get();
+}
+
 void CompilerStack::setLibraries(std::map<std::string, util::h160> const& _libraries)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -256,6 +275,13 @@ void CompilerStack::setOptimiserSettings(OptimiserSettings _settings)
 	if (m_stackState >= ParsedAndImported)
 		solThrow(CompilerError, "Must set optimiser settings before parsing.");
 	m_optimiserSettings = std::move(_settings);
+	GlobalParams::g_optimizerLimits = {
+		m_optimiserSettings.tvmFunctionFuel,
+		m_optimiserSettings.tvmContractFuel,
+		m_optimiserSettings.tvmTimeLimit
+	};
+	GlobalParams::g_optimizationLevel = m_optimiserSettings.tvmOptimizationLevel;
+	GlobalParams::g_packStateVariables = m_optimiserSettings.tvmPackStateVariables;
 }
 
 void CompilerStack::setRevertStringBehaviour(RevertStrings _revertStrings)
@@ -294,7 +320,7 @@ void CompilerStack::reset(bool _keepSettings)
 		m_generateIR = false;
 		m_generateEwasm = false;
 		m_revertStrings = RevertStrings::Default;
-		m_optimiserSettings = OptimiserSettings::minimal();
+		setOptimiserSettings(OptimiserSettings::minimal());
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
@@ -304,6 +330,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_contracts.clear();
 	m_errorReporter.clear();
 	TypeProvider::reset();
+	m_sourceNameScope.emplace();
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -332,13 +359,15 @@ bool CompilerStack::parse()
 	{
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
+		source.ast.reset();
+		source.arena = make_unique<ASTArena>();
+		source.ast = parser.parse(*source.charStream, source.arena.get());
 		if (!source.ast)
 			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
 			source.ast->annotation().path = path;
-			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+			for (auto const& import: source.ast->imports())
 			{
 				solAssert(!import->path().empty(), "Import path cannot be empty.");
 
@@ -398,6 +427,134 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 	storeContractDefinitions();
 }
 
+namespace
+{
+
+/// A part of the TVM analysis that is checked separately: a contract without its sub-nodes,
+/// or a node together with the contract that defines it (nullptr at file level).
+struct AnalysisItem
+{
+	ASTNode const* node{};
+	ContractDefinition const* contract{};
+	bool contractOnly{};
+};
+
+/// Splits the source units into the contracts and the nodes of the contracts and files, so that
+/// a single big file is checked in parallel as well. The items are in the order of a visitor.
+vector<AnalysisItem> analysisItems(vector<SourceUnit const*> const& _sourceUnits)
+{
+	vector<AnalysisItem> items;
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		for (ASTPointer<ASTNode> const& node: sourceUnit->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+			{
+				items.push_back({contract, contract, true});
+				for (ASTPointer<InheritanceSpecifier> const& base: contract->baseContracts())
+					items.push_back({base.get(), contract, false});
+				for (ASTPointer<ASTNode> const& subNode: contract->subNodes())
+					items.push_back({subNode.get(), contract, false});
+			}
+			else
+				items.push_back({node.get(), nullptr, false});
+	return items;
+}
+
+/// Creates the annotations that don't exist yet.
+class AnnotationCreator: public ASTConstVisitor
+{
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		_node.annotation();
+		return true;
+	}
+};
+
+/// Initializes the lazily computed parts of the AST, so that the threads of checkInParallel
+/// only read them.
+void prepareForParallelChecks(vector<SourceUnit const*> const& _sourceUnits)
+{
+	AnnotationCreator annotationCreator;
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+	{
+		sourceUnit->accept(annotationCreator);
+		sourceUnit->imports();
+		sourceUnit->usingForDirectives();
+		for (ContractDefinition const* contract: sourceUnit->contracts())
+		{
+			contract->definedInterfaceEvents();
+			contract->definedFunctions("");
+			contract->usingForDirectives();
+			contract->definedStructs();
+			contract->definedEnums();
+			contract->stateVariables();
+			contract->functionModifiers();
+			contract->definedFunctions();
+			contract->events();
+			contract->declarations();
+			contract->linearizedDefinedFunctions();
+			contract->linearizedStateVariables();
+		}
+	}
+}
+
+/// Runs @a _check for all items on the threads of the shared pool and on the calling thread,
+/// with the settings and the types of the calling thread. Every item gets its own error list,
+/// the lists are appended to @a _errorReporter in the order of @a _items, so the reported
+/// errors do not depend on scheduling. As in a sequential run, the errors after the first
+/// exception are dropped and the exception is rethrown.
+/// @returns false if any of the checks reported an error.
+bool checkInParallel(
+	vector<AnalysisItem> const& _items,
+	ErrorReporter& _errorReporter,
+	function<void(AnalysisItem const&, ErrorReporter&)> const& _check
+)
+{
+	vector<ErrorList> errors(_items.size());
+	vector<exception_ptr> exceptions(_items.size());
+	atomic<size_t> next{0};
+	GlobalParams::Values const params = GlobalParams::values();
+	TypeProvider& types = TypeProvider::instance();
+	auto worker = [&]() {
+		GlobalParams::Scope paramsScope{params};
+		TypeProvider::Scope typesScope{types};
+		for (size_t i = next++; i < _items.size(); i = next++)
+		{
+			ErrorReporter errorReporter(errors[i]);
+			GlobalParams::g_errorReporter = &errorReporter;
+			try
+			{
+				_check(_items[i], errorReporter);
+			}
+			catch (...)
+			{
+				exceptions[i] = current_exception();
+			}
+		}
+	};
+
+	util::ThreadPool& pool = util::ThreadPool::shared();
+	vector<future<void>> helpers;
+	for (size_t i = 1; i < min(pool.size() + 1, _items.size()); ++i)
+		helpers.emplace_back(pool.run(worker));
+	worker();
+	for (future<void>& helper: helpers)
+		helper.get();
+
+	bool noErrors = true;
+	for (size_t i = 0; i < _items.size(); ++i)
+	{
+		_errorReporter.append(errors[i]);
+		if (Error::containsErrors(errors[i]))
+			noErrors = false;
+		if (exceptions[i])
+			rethrow_exception(exceptions[i]);
+	}
+	return noErrors;
+}
+
+}
+
 bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
@@ -556,23 +713,41 @@ bool CompilerStack::analyze()
 				noErrors = false;
 		}
 
+		// The TVM specific checks only read the AST and the types, and are independent for
+		// every contract and function, so they run concurrently. ControlFlowAnalyzer,
+		// StaticAnalyzer and ViewPureChecker still run sequentially, as they keep state
+		// across contracts and source units.
+		vector<AnalysisItem> items;
+		if (noErrors)
+		{
+			vector<SourceUnit const*> sourceUnits;
+			for (Source const* source: m_sourceOrder)
+				if (source->ast)
+					sourceUnits.push_back(source->ast.get());
+			prepareForParallelChecks(sourceUnits);
+			items = analysisItems(sourceUnits);
+		}
+
 		if (noErrors) {
 			//Checks for TVM specific issues.
-			TVMAnalyzer tvmAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !tvmAnalyzer.analyze(*source->ast))
-					noErrors = false;
+			noErrors = checkInParallel(items, m_errorReporter, [](AnalysisItem const& _item, ErrorReporter& _errorReporter) {
+				TVMAnalyzer analyzer(_errorReporter);
+				if (_item.contractOnly)
+					analyzer.analyzeContract(*_item.contract);
+				else
+					analyzer.analyze(*_item.node);
+			});
 		}
 
 		if (noErrors)
 		{
-			for (Source const* source: m_sourceOrder) {
-				TVMTypeChecker checker(m_errorReporter);
-				source->ast->accept(checker);
-				if (m_errorReporter.hasErrors()) {
-					noErrors = false;
-				}
-			}
+			noErrors = checkInParallel(items, m_errorReporter, [](AnalysisItem const& _item, ErrorReporter& _errorReporter) {
+				TVMTypeChecker checker(_errorReporter);
+				if (_item.contractOnly)
+					checker.checkContract(*_item.contract);
+				else
+					checker.check(*_item.node, _item.contract);
+			});
 		}
 	}
 	catch (FatalError const&)
@@ -1045,6 +1220,30 @@ SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 	return *source(_sourceName).ast;
 }
 
+set<string> CompilerStack::importClosure(string const& _sourceName) const
+{
+	if (m_stackState < ParsedAndImported)
+		solThrow(CompilerError, "Imports not yet loaded.");
+
+	set<string> closure{_sourceName};
+	vector<string> toVisit{_sourceName};
+	while (!toVisit.empty())
+	{
+		string name = std::move(toVisit.back());
+		toVisit.pop_back();
+		if (!source(name).ast)
+			continue;
+		for (ImportDirective const* import: source(name).ast->imports())
+			if (import->annotation().absolutePath.set())
+			{
+				string const& path = *import->annotation().absolutePath;
+				if (m_sources.count(path) && closure.insert(path).second)
+					toVisit.push_back(path);
+			}
+	}
+	return closure;
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1170,7 +1369,7 @@ void CompilerStack::storeContractDefinitions()
 		if (pair.second.ast)
 			for (
 				ContractDefinition const* contract:
-				ASTNode::filteredNodes<ContractDefinition>(pair.second.ast->nodes())
+				pair.second.ast->contracts()
 			)
 			{
 				string fullyQualifiedName = *pair.second.ast->annotation().path + ":" + contract->name();
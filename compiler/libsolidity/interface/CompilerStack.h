@@ -25,6 +25,7 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/ast/ASTArena.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -48,6 +49,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -68,6 +70,7 @@ class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class BranchProfile;
 class Natspec;
 class DeclarationContainer;
 class PragmaDirective;
@@ -166,6 +169,10 @@ public:
 
 	void setTVMVersion(langutil::TVMVersion _version = langutil::TVMVersion{});
 
+	/// Sets the execution profile used to lay out branches in the generated code.
+	/// Must be set before compiling.
+	void setBranchProfile(std::shared_ptr<BranchProfile const> _profile);
+
 	/// Sets the requested contract names by source.
 	/// If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled.
@@ -200,6 +207,10 @@ public:
 		m_inputFile = inputFile;
 	}
 
+	std::string const& inputFile() const {
+		return m_inputFile;
+	}
+
 	void printFunctionIds() {
 		m_doPrintFunctionIds = true;
 	}
@@ -267,6 +278,10 @@ public:
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// @returns the names of the given source and of all sources it imports, directly or indirectly.
+	/// Import paths are taken after applying the remappings.
+	std::set<std::string> importClosure(std::string const& _sourceName) const;
+
 	/// @returns the parsed contract with the supplied name. Throws an exception if the contract
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
@@ -353,11 +368,15 @@ private:
 	struct Source
 	{
 		std::shared_ptr<langutil::CharStream> charStream;
+		/// Memory of the parsed AST nodes and their annotations.
+		/// Declared before `ast`, so the nodes are destroyed first.
+		/// Code that replaces `arena` has to release `ast` before.
+		std::unique_ptr<ASTArena> arena;
 		std::shared_ptr<SourceUnit> ast;
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
-		void reset() { *this = Source(); }
+		void reset() { ast.reset(); arena.reset(); *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
 		std::string const& ipfsUrl() const;
@@ -452,6 +471,9 @@ private:
 	std::vector<PragmaDirective const *> getPragmaDirectives(Source const* source) const;
 	std::vector<std::shared_ptr<SourceUnit>> getSourceUnits() const;
 
+	/// Declared first so that the source names outlive everything that refers to them.
+	/// Renewed in reset(), which lets the names of the previous sources go.
+	std::optional<langutil::SourceNameScope> m_sourceNameScope;
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
@@ -495,6 +517,7 @@ private:
 	bool m_doPrintFunctionIds = false;
     bool m_doPrivateFunctionIds = false;
 	solidity::langutil::TVMVersion m_tvmVersion;
+	std::shared_ptr<BranchProfile const> m_branchProfile;
 };
 
 }
@@ -61,6 +61,7 @@ FileReader::FileReader(
 
 void FileReader::setBasePath(boost::filesystem::path const& _path)
 {
+	clearFileSystemCache();
 	if (_path.empty())
 	{
 		// Empty base path is a special case that does not make sense when include paths are used.
@@ -75,28 +76,36 @@ void FileReader::addIncludePath(boost::filesystem::path const& _path)
 {
 	solAssert(!m_basePath.empty(), "");
 	solAssert(!_path.empty(), "");
+	clearFileSystemCache();
 	m_includePaths.push_back(normalizeCLIPathForVFS(_path));
 }
 
 void FileReader::allowDirectory(boost::filesystem::path _path)
 {
 	solAssert(!_path.empty(), "");
+	clearFileSystemCache();
 	m_allowedDirectories.insert(std::move(_path));
 }
 
 void FileReader::addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source)
 {
-	m_sourceCodes[cliPathToSourceUnitName(_path)] = std::move(_source);
+	clearFileSystemCache();
+	string sourceUnitName = cliPathToSourceUnitName(_path);
+	m_sourceCodes[sourceUnitName] = std::move(_source);
+	m_sourcePaths[sourceUnitName] = normalizeCLIPathForVFS(_path, SymlinkResolution::Enabled);
 }
 
 void FileReader::setStdin(SourceCode _source)
 {
+	clearFileSystemCache();
 	m_sourceCodes["<stdin>"] = std::move(_source);
 }
 
 void FileReader::setSourceUnits(StringMap _sources)
 {
 	m_sourceCodes = std::move(_sources);
+	m_sourcePaths.clear();
+	clearFileSystemCache();
 }
 
 ReadCallback::Result FileReader::readFile(string const& _kind, string const& _sourceUnitName)
@@ -115,8 +124,15 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 
 		for (auto const& prefix: prefixes)
 		{
-			boost::filesystem::path canonicalPath = normalizeCLIPathForVFS(prefix / strippedSourceUnitName, SymlinkResolution::Enabled);
-			if (boost::filesystem::exists(canonicalPath))
+			boost::filesystem::path path = prefix / strippedSourceUnitName;
+			// Imports from one directory share the lookup of that directory. If it's missing,
+			// the file is missing too and resolving symlinks in the path can be skipped.
+			// Not applicable to .. segments, weakly_canonical() collapses them lexically
+			// once it reaches a missing directory.
+			if (path.has_parent_path() && !hasDotDotSegments(path) && !cachedExists(path.parent_path()))
+				continue;
+			boost::filesystem::path canonicalPath = normalizeCLIPathForVFS(path, SymlinkResolution::Enabled);
+			if (cachedExists(canonicalPath))
 				candidates.push_back(std::move(canonicalPath));
 		}
 
@@ -145,8 +161,8 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 			m_includePaths;
 
 		bool isAllowed = false;
-		for (boost::filesystem::path const& allowedDir: allowedPaths)
-			if (isPathPrefix(normalizeCLIPathForVFS(allowedDir, SymlinkResolution::Enabled), candidates[0]))
+		for (boost::filesystem::path const& allowedDir: normalizedAllowedPaths())
+			if (isPathPrefix(allowedDir, candidates[0]))
 			{
 				isAllowed = true;
 				break;
@@ -167,6 +183,7 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		auto contents = readFileAsString(candidates[0]);
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
+		m_sourcePaths[_sourceUnitName] = candidates[0];
 		return ReadCallback::Result{true, contents};
 	}
 	catch (util::Exception const& _exception)
@@ -183,6 +200,36 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 	}
 }
 
+bool FileReader::cachedExists(boost::filesystem::path const& _path)
+{
+	auto [it, inserted] = m_existingPaths.emplace(_path, false);
+	if (inserted)
+		it->second = boost::filesystem::exists(_path);
+	return it->second;
+}
+
+vector<boost::filesystem::path> const& FileReader::normalizedAllowedPaths()
+{
+	if (!m_normalizedAllowedPaths.has_value())
+	{
+		FileSystemPathSet allowedPaths =
+			m_allowedDirectories +
+			decltype(allowedPaths){m_basePath.empty() ? "." : m_basePath} +
+			m_includePaths;
+
+		m_normalizedAllowedPaths.emplace();
+		for (boost::filesystem::path const& allowedDir: allowedPaths)
+			m_normalizedAllowedPaths->push_back(normalizeCLIPathForVFS(allowedDir, SymlinkResolution::Enabled));
+	}
+	return *m_normalizedAllowedPaths;
+}
+
+void FileReader::clearFileSystemCache()
+{
+	m_existingPaths.clear();
+	m_normalizedAllowedPaths.reset();
+}
+
 string FileReader::cliPathToSourceUnitName(boost::filesystem::path const& _cliPath) const
 {
 	vector<boost::filesystem::path> prefixes = {m_basePath.empty() ? normalizeCLIPathForVFS(".") : m_basePath};
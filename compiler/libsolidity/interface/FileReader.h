@@ -23,6 +23,7 @@
 #include <boost/filesystem.hpp>
 
 #include <map>
+#include <optional>
 #include <set>
 
 namespace solidity::frontend
@@ -64,19 +65,29 @@ public:
 	/// @returns all sources by their internal source unit names.
 	StringMap const& sourceUnits() const noexcept { return m_sourceCodes; }
 
+	/// @returns the file system paths of the sources that were read from disk by their source unit names.
+	PathMap const& sourcePaths() const noexcept { return m_sourcePaths; }
+
 	/// Resets all sources to the given map of source unit name to source codes.
 	/// Does not enforce @a allowedDirectories().
 	void setSourceUnits(StringMap _sources);
 
 	/// Adds the source code under a source unit name created by normalizing the file path
-	/// or changes an existing source.
+	/// or changes an existing source. Starts a new compilation, see @a clearFileSystemCache().
 	/// Does not enforce @a allowedDirectories().
 	void addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source);
 
 	/// Adds the source code under the source unit name of @a <stdin>.
+	/// Starts a new compilation, see @a clearFileSystemCache().
 	/// Does not enforce @a allowedDirectories().
 	void setStdin(SourceCode _source);
 
+	/// Drops the results of file system lookups, including the paths that were not found.
+	/// Called when the search paths change or sources are added, so the lookups are shared only
+	/// within one compilation. A reader that is kept across compilations without adding sources
+	/// must call it before each compilation.
+	void clearFileSystemCache();
+
 	/// Receives a @p _sourceUnitName that refers to a source unit in compiler's virtual filesystem
 	/// and attempts to interpret it as a path and read the corresponding file from disk.
 	/// The read will only succeed if the canonical path of the file is within one of the @a allowedDirectories().
@@ -155,6 +166,12 @@ private:
 	/// @returns true if the path contains any .. segments.
 	static bool hasDotDotSegments(boost::filesystem::path const& _path);
 
+	/// Same as boost::filesystem::exists() but asks the file system only once per path
+	/// until the cache is cleared.
+	bool cachedExists(boost::filesystem::path const& _path);
+	/// @returns base path, include paths and allowed directories normalized with symlinks resolved.
+	std::vector<boost::filesystem::path> const& normalizedAllowedPaths();
+
 	/// Base path, used for resolving relative paths in imports.
 	boost::filesystem::path m_basePath;
 
@@ -166,6 +183,15 @@ private:
 
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
+
+	/// map of input files to the normalized paths they were read from
+	PathMap m_sourcePaths;
+
+	/// results of boost::filesystem::exists() for the paths looked up while resolving imports
+	std::map<boost::filesystem::path, bool> m_existingPaths;
+
+	/// normalized allowed directories, computed on the first read
+	std::optional<std::vector<boost::filesystem::path>> m_normalizedAllowedPaths;
 };
 
 }
@@ -36,6 +36,28 @@ void ImportRemapper::setRemappings(vector<Remapping> _remappings)
 	for (auto const& remapping: _remappings)
 		solAssert(!remapping.prefix.empty(), "");
 	m_remappings = std::move(_remappings);
+
+	m_sanitizedRemappings.clear();
+	m_prefixTree = {PrefixNode{}};
+	for (size_t index = 0; index < m_remappings.size(); ++index)
+	{
+		Remapping const& remapping = m_remappings[index];
+		m_sanitizedRemappings.push_back({
+			util::sanitizePath(remapping.context),
+			util::sanitizePath(remapping.prefix),
+			util::sanitizePath(remapping.target)
+		});
+
+		size_t node = 0;
+		for (char c: m_sanitizedRemappings.back().prefix)
+		{
+			auto [child, inserted] = m_prefixTree[node].children.emplace(c, m_prefixTree.size());
+			if (inserted)
+				m_prefixTree.emplace_back();
+			node = child->second;
+		}
+		m_prefixTree[node].remappings.push_back(index);
+	}
 }
 
 SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _context) const
@@ -52,28 +74,42 @@ SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _con
 	size_t longestContext = 0;
 	string bestMatchTarget;
 
-	for (auto const& redir: m_remappings)
+	// Walk down the prefix tree along the path. The prefixes are visited from the shortest one and
+	// remappings with the same prefix in the order they were given, so on equal context and prefix
+	// the last remapping wins.
+	auto matchRemappingsAt = [&](size_t _node, size_t _prefixLength)
 	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+		for (size_t index: m_prefixTree[_node].remappings)
+		{
+			Remapping const& redir = m_sanitizedRemappings[index];
+
+			// Skip if current context is closer
+			if (redir.context.length() < longestContext)
+				continue;
+			// Skip if redir.context is not a prefix of _context
+			if (!isPrefixOf(redir.context, _context))
+				continue;
+			// Skip if we already have a closer prefix match.
+			if (_prefixLength < longestPrefix && redir.context.length() == longestContext)
+				continue;
+
+			longestContext = redir.context.length();
+			longestPrefix = _prefixLength;
+			bestMatchTarget = redir.target;
+		}
+	};
+
+	size_t node = 0;
+	matchRemappingsAt(node, 0);
+	for (size_t i = 0; i < _path.length(); ++i)
+	{
+		auto child = m_prefixTree[node].children.find(_path[i]);
+		if (child == m_prefixTree[node].children.end())
+			break;
+		node = child->second;
+		matchRemappingsAt(node, i + 1);
 	}
+
 	string path = bestMatchTarget;
 	path.append(_path.begin() + static_cast<string::difference_type>(longestPrefix), _path.end());
 	return path;
@@ -118,7 +118,12 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			tvmFunctionFuel == _other.tvmFunctionFuel &&
+			tvmContractFuel == _other.tvmContractFuel &&
+			tvmTimeLimit == _other.tvmTimeLimit &&
+			tvmOptimizationLevel == _other.tvmOptimizationLevel &&
+			tvmPackStateVariables == _other.tvmPackStateVariables;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -149,6 +154,21 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Upper bounds on the work of the TVM stack and peephole optimizers, 0 means no limit.
+	/// When a bound is reached the optimizers stop and the rest of the code stays less optimized.
+	/// Number of rewrites in one function and in one contract.
+	size_t tvmFunctionFuel = 0;
+	size_t tvmContractFuel = 0;
+	/// Time for optimizing one contract in milliseconds.
+	size_t tvmTimeLimit = 0;
+	/// Level of the TVM optimizers: 0 runs only the passes the code generation relies on,
+	/// 1 runs one round of the stack and peephole optimizers, 2 runs the full pipeline
+	/// and 3 repeats its rounds while they still change the code.
+	unsigned tvmOptimizationLevel = 2;
+	static constexpr unsigned maxTvmOptimizationLevel = 3;
+	/// Reorder state variables so that they are stored in fewer cells of c4.
+	/// The storage layout is published in the "fields" section of the ABI.
+	bool tvmPackStateVariables = false;
 };
 
 }
@@ -85,11 +85,11 @@ Json::Value formatFatalError(string const& _type, string const& _message)
 
 Json::Value formatSourceLocation(SourceLocation const* location)
 {
-	if (!location || !location->sourceName)
+	if (!location || !location->sourceName())
 		return Json::nullValue;
 
 	Json::Value sourceLocation{Json::objectValue};
-	sourceLocation["file"] = *location->sourceName;
+	sourceLocation["file"] = *location->sourceName();
 	sourceLocation["start"] = location->start;
 	sourceLocation["end"] = location->end;
 	return sourceLocation;
@@ -378,7 +378,7 @@ std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _inp
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "runs", "level", "packStateVariables", "functionFuel", "contractFuel", "timeLimit"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
@@ -499,6 +499,36 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("level"))
+	{
+		if (!_jsonInput["level"].isUInt() || _jsonInput["level"].asUInt() > OptimiserSettings::maxTvmOptimizationLevel)
+			return formatFatalError(
+				"JSONError",
+				"The \"level\" setting must be an unsigned number not greater than " +
+				to_string(OptimiserSettings::maxTvmOptimizationLevel) + "."
+			);
+		settings.tvmOptimizationLevel = _jsonInput["level"].asUInt();
+	}
+
+	if (_jsonInput.isMember("packStateVariables"))
+	{
+		if (!_jsonInput["packStateVariables"].isBool())
+			return formatFatalError("JSONError", "The \"packStateVariables\" setting must be a Boolean.");
+		settings.tvmPackStateVariables = _jsonInput["packStateVariables"].asBool();
+	}
+
+	for (auto const& [name, limit]: {
+		std::pair<string, size_t*>{"functionFuel", &settings.tvmFunctionFuel},
+		{"contractFuel", &settings.tvmContractFuel},
+		{"timeLimit", &settings.tvmTimeLimit}
+	})
+		if (_jsonInput.isMember(name))
+		{
+			if (!_jsonInput[name].isUInt64())
+				return formatFatalError("JSONError", "The \"" + name + "\" setting must be an unsigned number.");
+			*limit = _jsonInput[name].asUInt64();
+		}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
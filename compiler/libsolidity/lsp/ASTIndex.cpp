@@ -0,0 +1,175 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/ASTIndex.h>
+#include <libsolidity/lsp/Utils.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <algorithm>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+namespace
+{
+
+class IndexBuilder: public ASTConstVisitor
+{
+public:
+	using Interval = tuple<int, int, ASTNode const*>;
+	using References = map<Declaration const*, vector<ASTIndex::Reference>>;
+
+	IndexBuilder(vector<Interval>& _intervals, References& _references):
+		m_intervals(_intervals),
+		m_references(_references)
+	{}
+
+	void endVisit(Identifier const& _node) override
+	{
+		add(_node.annotation().referencedDeclaration, _node.name(), _node.location());
+	}
+
+	void endVisit(IdentifierPath const& _node) override
+	{
+		vector<Declaration const*> const& declarations = _node.annotation().pathDeclarations;
+		solAssert(declarations.size() == _node.path().size());
+		for (size_t i = 0; i < _node.path().size(); i++)
+			add(declarations[i], _node.path()[i], _node.pathLocations()[i]);
+	}
+
+	void endVisit(MemberAccess const& _node) override
+	{
+		add(_node.annotation().referencedDeclaration, _node.memberName(), _node.memberLocation());
+	}
+
+	void endVisit(ImportDirective const& _node) override
+	{
+		for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
+			if (symbolAlias.alias)
+				add(symbolAlias.symbol->annotation().referencedDeclaration, *symbolAlias.alias, symbolAlias.location);
+	}
+
+	void endVisit(FunctionCall const& _node) override
+	{
+		if (_node.names().empty())
+			return;
+		CallableDeclaration const* callable = extractCallableDeclaration(_node);
+		if (!callable)
+			return;
+		for (size_t i = 0; i < _node.names().size(); i++)
+			for (ASTPointer<VariableDeclaration> const& parameter: callable->parameters())
+				if (parameter && parameter->name() == *_node.names()[i])
+					add(parameter.get(), *_node.names()[i], _node.nameLocations()[i]);
+	}
+
+protected:
+	bool visitNode(ASTNode const& _node) override
+	{
+		// Nodes without text can not contain any offset, neither can their children.
+		if (!_node.location().hasText())
+			return false;
+		m_intervals.emplace_back(_node.location().start, _node.location().end, &_node);
+		return true;
+	}
+
+private:
+	void add(Declaration const* _declaration, string const& _name, SourceLocation const& _location)
+	{
+		if (_declaration && _location.isValid())
+			m_references[_declaration].push_back({&_name, _location});
+	}
+
+	vector<Interval>& m_intervals;
+	References& m_references;
+};
+
+}
+
+void ASTIndex::build(CompilerStack const& _compilerStack)
+{
+	clear();
+	for (string const& sourceUnitName: _compilerStack.sourceNames())
+		indexSourceUnit(sourceUnitName, _compilerStack.ast(sourceUnitName));
+}
+
+void ASTIndex::clear()
+{
+	m_intervals.clear();
+	m_references.clear();
+}
+
+void ASTIndex::indexSourceUnit(string const& _sourceUnitName, SourceUnit const& _sourceUnit)
+{
+	vector<IndexBuilder::Interval> nodes;
+	IndexBuilder builder(nodes, m_references);
+	_sourceUnit.accept(builder);
+
+	// Outer nodes first for equal starts, the visiting order breaks remaining ties
+	// so that a child with the same range as its parent comes after it.
+	stable_sort(nodes.begin(), nodes.end(), [](auto const& _a, auto const& _b) {
+		if (get<0>(_a) != get<0>(_b))
+			return get<0>(_a) < get<0>(_b);
+		return get<1>(_a) > get<1>(_b);
+	});
+
+	vector<Interval>& intervals = m_intervals[_sourceUnitName];
+	intervals.reserve(nodes.size());
+	vector<int> enclosing;
+	for (auto const& [start, end, node]: nodes)
+	{
+		while (!enclosing.empty() && intervals[static_cast<size_t>(enclosing.back())].end < end)
+			enclosing.pop_back();
+		intervals.push_back({start, end, node, enclosing.empty() ? -1 : enclosing.back()});
+		enclosing.push_back(static_cast<int>(intervals.size()) - 1);
+	}
+}
+
+ASTNode const* ASTIndex::innermostNode(string const& _sourceUnitName, int _offsetInFile) const
+{
+	auto it = m_intervals.find(_sourceUnitName);
+	if (it == m_intervals.end())
+		return nullptr;
+	vector<Interval> const& intervals = it->second;
+
+	// In the AST the parent location always covers the whole child location, so the
+	// innermost match is the last interval starting at or before the offset,
+	// or the nearest of its ancestors that still contains the offset.
+	auto next = upper_bound(intervals.begin(), intervals.end(), _offsetInFile, [](int _offset, Interval const& _interval) {
+		return _offset < _interval.start;
+	});
+	int index = static_cast<int>(next - intervals.begin()) - 1;
+	while (index >= 0)
+	{
+		Interval const& interval = intervals[static_cast<size_t>(index)];
+		if (_offsetInFile < interval.end)
+			return interval.node;
+		index = interval.parent;
+	}
+	return nullptr;
+}
+
+vector<ASTIndex::Reference> const& ASTIndex::references(Declaration const& _declaration) const
+{
+	static vector<Reference> const empty;
+	auto it = m_references.find(&_declaration);
+	return it == m_references.end() ? empty : it->second;
+}
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+class CompilerStack;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Position and reference index over the analysed source units, built once per compilation.
+ *
+ * For every source unit the nodes are kept sorted by their location, so the innermost node
+ * covering an offset is found by a binary search instead of a walk over the whole AST.
+ * In addition every reference to a declaration (identifiers, identifier paths, member accesses,
+ * import aliases and named call arguments) is recorded under the referenced declaration.
+ */
+class ASTIndex
+{
+public:
+	struct Reference
+	{
+		/// Name as written at the reference site, can differ from the declaration name for aliases.
+		std::string const* name = nullptr;
+		langutil::SourceLocation location;
+	};
+
+	/// Rebuilds the index from all source units of @a _compilerStack.
+	/// The compiler stack has to be at least in the analysed state.
+	void build(frontend::CompilerStack const& _compilerStack);
+	void clear();
+
+	/// @returns the innermost AST node of the source unit that covers the given offset or nullptr if not found.
+	frontend::ASTNode const* innermostNode(std::string const& _sourceUnitName, int _offsetInFile) const;
+
+	/// @returns all references to @a _declaration in the indexed source units.
+	std::vector<Reference> const& references(frontend::Declaration const& _declaration) const;
+
+private:
+	struct Interval
+	{
+		int start;
+		int end;
+		frontend::ASTNode const* node;
+		/// Index of the innermost interval covering this one, -1 for the root.
+		int parent;
+	};
+
+	void indexSourceUnit(std::string const& _sourceUnitName, frontend::SourceUnit const& _sourceUnit);
+
+	std::map<std::string, std::vector<Interval>> m_intervals;
+	std::map<frontend::Declaration const*, std::vector<Reference>> m_references;
+};
+
+}
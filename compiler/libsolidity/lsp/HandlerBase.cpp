@@ -36,8 +36,8 @@ Json::Value HandlerBase::toRange(SourceLocation const& _location) const
 	if (!_location.hasText())
 		return toJsonRange({}, {});
 
-	solAssert(_location.sourceName, "");
-	langutil::CharStream const& stream = charStreamProvider().charStream(*_location.sourceName);
+	solAssert(_location.sourceName(), "");
+	langutil::CharStream const& stream = charStreamProvider().charStream(*_location.sourceName());
 	LineColumn start = stream.translatePositionToLineColumn(_location.start);
 	LineColumn end = stream.translatePositionToLineColumn(_location.end);
 	return toJsonRange(start, end);
@@ -45,9 +45,9 @@ Json::Value HandlerBase::toRange(SourceLocation const& _location) const
 
 Json::Value HandlerBase::toJson(SourceLocation const& _location) const
 {
-	solAssert(_location.sourceName);
+	solAssert(_location.sourceName());
 	Json::Value item = Json::objectValue;
-	item["uri"] = fileRepository().sourceUnitNameToUri(*_location.sourceName);
+	item["uri"] = fileRepository().sourceUnitNameToUri(*_location.sourceName());
 	item["range"] = toRange(_location);
 	return item;
 }
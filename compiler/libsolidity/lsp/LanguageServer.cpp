@@ -150,10 +150,9 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/semanticTokens/full", bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
 		{"workspace/didChangeConfiguration", bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
-	m_fileRepository("/" /* basePath */, {} /* no search paths */) //,
-	//m_compilerStack{m_fileRepository.candidateGetter(), m_fileRepository.reader()}
+	m_fileRepository("/" /* basePath */, {} /* no search paths */),
+	m_compilerStack{m_fileRepository.reader()}
 {
-	solUnimplemented("TODO, SOLVE THIS ^^");
 }
 
 Json::Value LanguageServer::toRange(SourceLocation const& _location)
@@ -264,10 +263,13 @@ void LanguageServer::compile()
 
 	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
 
+	// the index points into the ASTs that reset() destroys
+	m_astIndex.clear();
 	m_compilerStack.reset(false);
 	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	solUnimplemented("TODO Uncomment this");
-//	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	m_compilerStack.parseAndAnalyze(CompilerStack::State::AnalysisPerformed);
+	if (m_compilerStack.state() >= CompilerStack::AnalysisPerformed)
+		m_astIndex.build(m_compilerStack);
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
@@ -285,7 +287,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (shared_ptr<Error const> const& error: m_compilerStack.errors())
 	{
 		SourceLocation const* location = error->sourceLocation();
-		if (!location || !location->sourceName)
+		if (!location || !location->sourceName())
 			// LSP only has diagnostics applied to individual files.
 			continue;
 
@@ -308,7 +310,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 				jsonDiag["relatedInformation"].append(jsonRelated);
 			}
 
-		diagnosticsBySourceUnit[*location->sourceName].append(jsonDiag);
+		diagnosticsBySourceUnit[*location->sourceName()].append(jsonDiag);
 	}
 
 	if (m_client.traceValue() != TraceValue::Off)
@@ -559,7 +561,7 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 	if (optional<int> sourcePos =
 		m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos))
-		return locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName));
+		return m_astIndex.innermostNode(_sourceUnitName, *sourcePos);
 	else
 		return nullptr;
 }
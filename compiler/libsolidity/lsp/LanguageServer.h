@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolidity/lsp/ASTIndex.h>
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -79,6 +80,7 @@ public:
 	Transport& client() noexcept { return m_client; }
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	ASTIndex const& astIndex() const noexcept { return m_astIndex; }
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
@@ -124,6 +126,8 @@ private:
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
 	frontend::CompilerStack m_compilerStack;
+	/// Position and reference index of the last successful analysis.
+	ASTIndex m_astIndex;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
@@ -16,6 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 #include <libsolidity/lsp/RenameSymbol.h>
+#include <libsolidity/lsp/ASTIndex.h>
 #include <libsolidity/lsp/Utils.h>
 
 #include <fmt/format.h>
@@ -29,23 +30,6 @@ using namespace solidity::langutil;
 using namespace solidity::lsp;
 using namespace std;
 
-namespace
-{
-
-CallableDeclaration const* extractCallableDeclaration(FunctionCall const& _functionCall)
-{
-	if (
-		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
-		functionType && functionType->hasDeclaration()
-	)
-		if (auto const* functionDefinition = dynamic_cast<FunctionDefinition const*>(&functionType->declaration()))
-			return functionDefinition;
-
-	return nullptr;
-}
-
-}
-
 void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 {
 	auto const&& [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
@@ -56,7 +40,6 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 
 	m_symbolName = {};
 	m_declarationToRename = nullptr;
-	m_sourceUnits = { &m_server.compilerStack().ast(sourceUnitName) };
 	m_locations.clear();
 
 	optional<int> cursorBytePosition = charStreamProvider()
@@ -66,28 +49,17 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 
 	extractNameAndDeclaration(*sourceNode, *cursorBytePosition);
 
-	// Find all source units using this symbol
-	for (auto const& [name, content]: fileRepository().sourceUnits())
-	{
-		auto const& sourceUnit = m_server.compilerStack().ast(name);
-		for (auto const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true, util::convertContainer<set<SourceUnit const*>>(m_sourceUnits)))
-			if (*referencedSourceUnit->location().sourceName == sourceUnitName)
-			{
-				m_sourceUnits.insert(&sourceUnit);
-				break;
-			}
-	}
-
-	// Origin source unit should always be checked
-	m_sourceUnits.insert(&m_declarationToRename->sourceUnit());
+	// The declaration itself, unless it is referenced through an alias
+	if (m_declarationToRename->name() == m_symbolName && m_declarationToRename->nameLocation().isValid())
+		m_locations.emplace_back(m_declarationToRename->nameLocation());
 
-	Visitor visitor(*this);
-
-	for (auto const* sourceUnit: m_sourceUnits)
-		sourceUnit->accept(visitor);
+	for (ASTIndex::Reference const& reference: m_server.astIndex().references(*m_declarationToRename))
+		if (*reference.name == m_symbolName)
+			m_locations.emplace_back(reference.location);
 
 	// Apply changes in reverse order (will iterate in reverse)
 	sort(m_locations.begin(), m_locations.end());
+	m_locations.erase(unique(m_locations.begin(), m_locations.end()), m_locations.end());
 
 	Json::Value reply = Json::objectValue;
 	reply["changes"] = Json::objectValue;
@@ -99,8 +71,8 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 		solAssert(i->isValid());
 
 		// Replace in our file repository
-		string const uri = fileRepository().sourceUnitNameToUri(*i->sourceName);
-		string buffer = fileRepository().sourceUnits().at(*i->sourceName);
+		string const uri = fileRepository().sourceUnitNameToUri(*i->sourceName());
+		string buffer = fileRepository().sourceUnits().at(*i->sourceName());
 		buffer.replace((size_t)i->start, (size_t)(i->end - i->start), newName);
 		fileRepository().setSourceByUri(uri, std::move(buffer));
 
@@ -110,7 +82,7 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 
 		// Record changes for the client
 		edits.append(edit);
-		if (i + 1 == m_locations.rend() || (i + 1)->sourceName != i->sourceName)
+		if (i + 1 == m_locations.rend() || (i + 1)->sourceId != i->sourceId)
 		{
 			reply["changes"][uri] = edits;
 			edits = Json::arrayValue;
@@ -170,21 +142,6 @@ void RenameSymbol::extractNameAndDeclaration(ImportDirective const& _importDirec
 		}
 }
 
-void RenameSymbol::Visitor::endVisit(ImportDirective const& _node)
-{
-	// Handles SourceUnit aliases
-	if (handleGenericDeclaration(_node))
-		return;
-
-	for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
-		if (
-			symbolAlias.alias != nullptr &&
-			*symbolAlias.alias == m_outer.m_symbolName &&
-			symbolAlias.symbol->annotation().referencedDeclaration == m_outer.m_declarationToRename
-		)
-			m_outer.m_locations.emplace_back(symbolAlias.location);
-}
-
 void RenameSymbol::extractNameAndDeclaration(FunctionCall const& _functionCall, int _cursorBytePosition)
 {
 	if (auto const* functionDefinition = extractCallableDeclaration(_functionCall))
@@ -202,44 +159,6 @@ void RenameSymbol::extractNameAndDeclaration(FunctionCall const& _functionCall,
 			}
 }
 
-void RenameSymbol::Visitor::endVisit(FunctionCall const& _node)
-{
-	SourceLocation nameLocationInFunctionCall;
-
-	for (size_t i = 0; i < _node.names().size(); i++)
-		if (_node.names()[i] && *_node.names()[i] == m_outer.m_symbolName)
-			nameLocationInFunctionCall = _node.nameLocations()[i];
-
-	if (!nameLocationInFunctionCall.isValid())
-		return;
-
-	if (auto const* functionDefinition = extractCallableDeclaration(_node))
-		for (size_t j = 0; j < functionDefinition->parameters().size(); j++)
-			if (
-				functionDefinition->parameters()[j] &&
-				*functionDefinition->parameters()[j] == *m_outer.m_declarationToRename
-			)
-				m_outer.m_locations.emplace_back(nameLocationInFunctionCall);
-}
-
-void RenameSymbol::Visitor::endVisit(MemberAccess const& _node)
-{
-	if (
-		m_outer.m_symbolName == _node.memberName() &&
-		*m_outer.m_declarationToRename == *_node.annotation().referencedDeclaration
-	)
-		m_outer.m_locations.emplace_back(_node.memberLocation());
-}
-
-void RenameSymbol::Visitor::endVisit(Identifier const& _node)
-{
-	if (
-		m_outer.m_symbolName == _node.name() &&
-		*m_outer.m_declarationToRename == *_node.annotation().referencedDeclaration
-	)
-		m_outer.m_locations.emplace_back(_node.location());
-}
-
 void RenameSymbol::extractNameAndDeclaration(IdentifierPath const& _identifierPath, int _cursorBytePosition)
 {
 	// iterate through the elements of the path to find the one the cursor is on
@@ -259,24 +178,6 @@ void RenameSymbol::extractNameAndDeclaration(IdentifierPath const& _identifierPa
 	}
 }
 
-void RenameSymbol::Visitor::endVisit(IdentifierPath const& _node)
-{
-	std::vector<Declaration const*>& declarations = _node.annotation().pathDeclarations;
-	solAssert(declarations.size() == _node.path().size());
-
-	for (size_t i = 0; i < _node.path().size(); i++)
-		if (
-			_node.path()[i] == m_outer.m_symbolName &&
-			declarations[i] == m_outer.m_declarationToRename
-		)
-			m_outer.m_locations.emplace_back(_node.pathLocations()[i]);
-}
-
 void RenameSymbol::extractNameAndDeclaration(InlineAssembly const& , int )
 {
 }
-
-void RenameSymbol::Visitor::endVisit(InlineAssembly const&)
-{
-
-}
@@ -84,6 +84,18 @@ optional<SourceLocation> declarationLocation(Declaration const* _declaration)
 	return nullopt;
 }
 
+CallableDeclaration const* extractCallableDeclaration(FunctionCall const& _functionCall)
+{
+	if (
+		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+		functionType && functionType->hasDeclaration()
+	)
+		if (auto const* functionDefinition = dynamic_cast<FunctionDefinition const*>(&functionType->declaration()))
+			return functionDefinition;
+
+	return nullptr;
+}
+
 optional<SourceLocation> parsePosition(
 	FileRepository const& _fileRepository,
 	string const& _sourceUnitName,
@@ -110,7 +122,7 @@ optional<SourceLocation> parseRange(FileRepository const& _fileRepository, strin
 	optional<SourceLocation> end = parsePosition(_fileRepository, _sourceUnitName, _range["end"]);
 	if (!start || !end)
 		return nullopt;
-	solAssert(*start->sourceName == *end->sourceName);
+	solAssert(start->sourceId == end->sourceId);
 	start->end = end->end;
 	return start;
 }
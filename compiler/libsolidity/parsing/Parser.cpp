@@ -53,7 +53,7 @@ public:
 		m_parser(_parser), m_location{
 			_parser.currentLocation().start,
 			-1,
-			_parser.currentLocation().sourceName
+			_parser.currentLocation().sourceId
 		}
 	{}
 	ASTNodeFactory(Parser& _parser, ASTPointer<ASTNode> const& _childNode):
@@ -68,9 +68,20 @@ public:
 	template <class NodeType, typename... Args>
 	ASTPointer<NodeType> createNode(Args&& ... _args)
 	{
-		solAssert(m_location.sourceName, "");
+		solAssert(m_location.sourceName(), "");
 		if (m_location.end < 0)
 			markEndPosition();
+		if (m_parser.m_arena)
+		{
+			auto node = allocate_shared<NodeType>(
+				ASTArenaAllocator<NodeType>{m_parser.m_arena},
+				m_parser.nextID(),
+				m_location,
+				std::forward<Args>(_args)...
+			);
+			node->createAnnotationIn(*m_parser.m_arena);
+			return node;
+		}
 		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
 	}
 
@@ -81,9 +92,11 @@ private:
 	SourceLocation m_location;
 };
 
-ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
+ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream, ASTArena* _arena)
 {
 	solAssert(!m_insideModifier, "");
+	m_arena = _arena;
+	ScopeGuard resetArena([&]{ m_arena = nullptr; });
 	try
 	{
 		m_recursionDepth = 0;
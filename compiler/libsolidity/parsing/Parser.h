@@ -24,6 +24,7 @@
 #pragma once
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
@@ -47,7 +48,9 @@ public:
 		m_evmVersion(_evmVersion)
 	{}
 
-	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
+	/// If @a _arena is given, the nodes and their annotations are allocated from it.
+	/// The arena must outlive all the returned nodes.
+	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream, ASTArena* _arena = nullptr);
 
 private:
 	class ASTNodeFactory;
@@ -236,6 +239,8 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Arena of the source unit that is being parsed, if any.
+	ASTArena* m_arena = nullptr;
 	
 	bool m_insideFunctionDefenition = false;
 };
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threadCount)
+{
+	for (size_t i = 0; i < _threadCount; ++i)
+		m_threads.emplace_back([this]{ work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> guard(m_mutex);
+		m_stopping = true;
+	}
+	m_hasTasks.notify_all();
+	for (thread& t: m_threads)
+		t.join();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool{max(thread::hardware_concurrency(), 1u) - 1};
+	return pool;
+}
+
+future<void> ThreadPool::run(function<void()> _task)
+{
+	packaged_task<void()> task{std::move(_task)};
+	future<void> result = task.get_future();
+	if (m_threads.empty())
+	{
+		task();
+		return result;
+	}
+	{
+		lock_guard<mutex> guard(m_mutex);
+		m_tasks.emplace_back(std::move(task));
+	}
+	m_hasTasks.notify_one();
+	return result;
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		packaged_task<void()> task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_hasTasks.wait(lock, [this]{ return m_stopping || !m_tasks.empty(); });
+			if (m_tasks.empty())
+				return;
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Threads that are started once and run the tasks posted to them.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+class ThreadPool
+{
+public:
+	explicit ThreadPool(size_t _threadCount);
+	/// Waits for the posted tasks and stops the threads.
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Pool of the process with a thread per hardware core except one, which is left to the
+	/// thread that posts the tasks and waits for them.
+	static ThreadPool& shared();
+
+	size_t size() const { return m_threads.size(); }
+
+	/// Runs @a _task on one of the threads, the tasks start in the order they were posted.
+	/// A pool without threads runs it right away on the calling thread.
+	/// @returns the future that gets the exception thrown by the task, if any.
+	std::future<void> run(std::function<void()> _task);
+
+private:
+	void work();
+
+	std::mutex m_mutex;
+	std::condition_variable m_hasTasks;
+	std::deque<std::packaged_task<void()>> m_tasks;
+	bool m_stopping = false;
+	std::vector<std::thread> m_threads;
+};
+
+}
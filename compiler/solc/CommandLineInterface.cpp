@@ -37,6 +37,8 @@
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/codegen/BranchProfile.hpp>
+#include <libsolidity/codegen/TVM.hpp>
 #include <libsolidity/lsp/LanguageServer.h>
 #include <libsolidity/lsp/Transport.h>
 
@@ -404,7 +406,10 @@ void CommandLineInterface::processInput()
 	case InputMode::Compiler:
 	case InputMode::CompilerWithASTImport:
 		compile();
-		outputCompilationResults();
+		if (m_options.input.changedFiles)
+			printContractsToRebuild();
+		else
+			outputCompilationResults();
 	}
 }
 
@@ -492,6 +497,20 @@ void CommandLineInterface::compile()
 			m_compiler->setParserErrorRecovery(m_options.input.errorRecovery);
 		}
 
+		if (m_options.input.changedFiles)
+		{
+			// Only the import graph is needed to find the affected contracts.
+			bool successful = m_compiler->parseAndAnalyze(CompilerStack::State::ParsedAndImported);
+			for (auto const& error: m_compiler->errors())
+			{
+				m_hasOutput = true;
+				formatter.printErrorInformation(*error);
+			}
+			if (!successful)
+				solThrow(CommandLineExecutionError, "");
+			return;
+		}
+
 		if (m_options.tvmParams.mainContract.has_value())
 			m_compiler->setMainContract(m_options.tvmParams.mainContract.value());
 		if (m_options.tvmParams.fileNamePrefix.has_value())
@@ -506,6 +525,16 @@ void CommandLineInterface::compile()
 			m_compiler->printPrivateFunctionIds();
 		m_compiler->setOutputFolder(m_options.output.dir.string());
 		m_compiler->setTVMVersion(m_options.tvmParams.tvmVersion);
+		if (m_options.tvmParams.branchProfile.has_value())
+		{
+			boost::filesystem::path const& profilePath = m_options.tvmParams.branchProfile.value();
+			if (!boost::filesystem::is_regular_file(profilePath))
+				solThrow(CommandLineValidationError, '"' + profilePath.string() + "\" is not a valid file.");
+			optional<BranchProfile> profile = BranchProfile::fromString(readFileAsString(profilePath));
+			if (!profile)
+				solThrow(CommandLineValidationError, "Invalid branch profile \"" + profilePath.string() + "\". Expected lines \"<file>:<line> <count>\".");
+			m_compiler->setBranchProfile(make_shared<BranchProfile const>(std::move(*profile)));
+		}
 
 		bool successful = true;
 		bool didCompileSomething = false;
@@ -600,6 +629,9 @@ void CommandLineInterface::outputCompilationResults()
 		return;
 	}
 
+	if (!m_options.output.depFile.empty())
+		writeDepFile();
+
 	vector<string> contracts = m_compiler->contractNames();
 	for (string const& contract: contracts)
 	{
@@ -630,4 +662,77 @@ void CommandLineInterface::outputCompilationResults()
 	}
 }
 
+void CommandLineInterface::writeDepFile()
+{
+	solAssert(m_options.input.mode == InputMode::Compiler, "");
+
+	auto escape = [](string _path) {
+		boost::replace_all(_path, "$", "$$");
+		boost::replace_all(_path, " ", "\\ ");
+		boost::replace_all(_path, "#", "\\#");
+		return _path;
+	};
+
+	vector<string> targets;
+	if (!m_options.tvmParams.printFunctionIds && !m_options.tvmParams.printPrivateFunctionIds)
+	{
+		string pathToFiles = getPathToFiles(
+			m_compiler->inputFile(),
+			m_options.output.dir.string(),
+			m_options.tvmParams.fileNamePrefix.value_or("")
+		);
+		if (m_options.tvmParams.code)
+			targets.push_back(escape(pathToFiles + ".code"));
+		if (m_options.tvmParams.abi)
+			targets.push_back(escape(pathToFiles + ".abi.json"));
+	}
+	if (targets.empty())
+		return;
+
+	vector<string> prerequisites;
+	for (string const& sourceName: m_compiler->sourceNames())
+		if (m_fileReader.sourcePaths().count(sourceName))
+			prerequisites.push_back(escape(m_fileReader.sourcePaths().at(sourceName).string()));
+
+	string rule = joinHumanReadable(targets, " ") + ":";
+	for (string const& prerequisite: prerequisites)
+		rule += " \\\n " + prerequisite;
+	rule += "\n";
+	// Empty rules for the sources, so that deleting an imported file does not break the build.
+	for (string const& prerequisite: prerequisites)
+		rule += "\n" + prerequisite + ":\n";
+
+	ofstream outFile(m_options.output.depFile.string());
+	outFile << rule;
+	if (!outFile)
+		solThrow(CommandLineOutputError, "Could not write to file \"" + m_options.output.depFile.string() + "\".");
+}
+
+void CommandLineInterface::printContractsToRebuild()
+{
+	solAssert(m_options.input.changedFiles.has_value(), "");
+
+	set<boost::filesystem::path> changedFiles;
+	for (boost::filesystem::path const& changedFile: *m_options.input.changedFiles)
+		changedFiles.insert(FileReader::normalizeCLIPathForVFS(changedFile, FileReader::SymlinkResolution::Enabled));
+
+	bool affected = false;
+	for (string const& sourceName: m_compiler->importClosure(m_compiler->inputFile()))
+		if (
+			m_fileReader.sourcePaths().count(sourceName) &&
+			changedFiles.count(m_fileReader.sourcePaths().at(sourceName))
+		)
+			affected = true;
+
+	if (!affected)
+		return;
+
+	for (ContractDefinition const* contract: m_compiler->ast(m_compiler->inputFile()).contracts())
+		if (
+			!contract->isLibrary() &&
+			(!m_options.tvmParams.mainContract || *m_options.tvmParams.mainContract == contract->name())
+		)
+			sout() << contract->name() << endl;
+}
+
 }
@@ -88,6 +88,10 @@ private:
 	void serveLSP();
 
 	void outputCompilationResults();
+	/// Writes a Makefile rule with the generated files as targets and all sources as prerequisites.
+	void writeDepFile();
+	/// Prints the contracts of the input file if any of the changed files is among its sources.
+	void printContractsToRebuild();
 	void handleAst();
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	bool readInputFilesAndConfigureRemappings();
@@ -89,6 +89,14 @@ static string const g_strABI = "abi-json";
 static string const g_strFunctionIds = "function-ids";
 static string const g_strPrivateFunctionIds = "private-function-ids";
 static string const g_strTVMVersion = "tvm-version";
+static string const g_strDepFile = "dep-file";
+static string const g_strChangedFiles = "changed-files";
+static string const g_strBranchProfile = "branch-profile";
+static string const g_strOptimizationLevel = "optimization-level";
+static string const g_strPackStateVariables = "pack-state-variables";
+static string const g_strOptimizerFunctionFuel = "optimizer-function-fuel";
+static string const g_strOptimizerContractFuel = "optimizer-contract-fuel";
+static string const g_strOptimizerTimeLimit = "optimizer-time-limit";
 
 
 /// Possible arguments to for --revert-strings
@@ -230,6 +238,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
 		input.errorRecovery == _other.input.errorRecovery &&
+		input.changedFiles == _other.input.changedFiles &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
@@ -237,6 +246,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
+		output.depFile == _other.output.depFile &&
 		input.mode == _other.input.mode &&
 		linker.libraries == _other.linker.libraries &&
 		formatting.json == _other.formatting.json &&
@@ -251,6 +261,11 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.functionFuel == _other.optimizer.functionFuel &&
+		optimizer.contractFuel == _other.optimizer.contractFuel &&
+		optimizer.timeLimit == _other.optimizer.timeLimit &&
+		optimizer.level == _other.optimizer.level &&
+		optimizer.packStateVariables == _other.optimizer.packStateVariables &&
 		modelChecker.initialize == _other.modelChecker.initialize;
 }
 
@@ -272,6 +287,13 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 	if (optimizer.yulSteps.has_value())
 		settings.yulOptimiserSteps = optimizer.yulSteps.value();
 
+	settings.tvmFunctionFuel = optimizer.functionFuel;
+	settings.tvmContractFuel = optimizer.contractFuel;
+	settings.tvmTimeLimit = optimizer.timeLimit;
+	if (optimizer.level.has_value())
+		settings.tvmOptimizationLevel = optimizer.level.value();
+	settings.tvmPackStateVariables = optimizer.packStateVariables;
+
 	return settings;
 }
 
@@ -563,6 +585,12 @@ General Information)").c_str(),
 			po::value<string>()->value_name("path(s)"),
 			"Allow a given path for imports. A list of paths can be supplied by separating them with a comma."
 		)
+		(
+			g_strChangedFiles.c_str(),
+			po::value<string>()->value_name("path(s)"),
+			"Do not compile. Resolve the imports of the input file and print the names of its contracts "
+			"if any of the given files is among its sources. A list of paths can be supplied by separating them with a comma."
+		)
 	;
 	desc.add(inputOptions);
 
@@ -583,9 +611,54 @@ General Information)").c_str(),
 			po::value<string>()->value_name("version")->default_value(TVMVersion{}.name()),
 			"Select desired TVM version. Either ever, ton, gosh."
 		)
+		(
+			g_strDepFile.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write a Makefile dependency rule listing all source files the output files were built from."
+		)
+		(
+			g_strBranchProfile.c_str(),
+			po::value<string>()->value_name("path"),
+			"Lay out branches of the generated code using the execution counts of source lines from the given file. "
+			"Each line of the file has the form \"<file>:<line> <count>\", where <file> and <line> are the ones of "
+			"the .loc directives in the generated code. Rarely executed branches are placed behind cell references."
+		)
 	;
 	desc.add(outputOptions);
 
+	po::options_description optimizerOptions("Optimizer Options");
+	optimizerOptions.add_options()
+		(
+			(g_strOptimizationLevel + ",O").c_str(),
+			po::value<unsigned>()->value_name("level"),
+			"Select the optimization level: 0 - only the passes the code generation relies on (fast, for local testing), "
+			"1 - one round of the stack and peephole optimizers, 2 - full optimization (default), "
+			"3 - repeat the optimization rounds while they still change the code (slow)."
+		)
+		(
+			g_strPackStateVariables.c_str(),
+			"Reorder state variables so that they are stored in fewer cells. "
+			"The chosen order is written to the \"fields\" section of the ABI file."
+		)
+		(
+			g_strOptimizerFunctionFuel.c_str(),
+			po::value<size_t>()->value_name("n"),
+			"Stop optimizing a function after the given number of rewrites."
+		)
+		(
+			g_strOptimizerContractFuel.c_str(),
+			po::value<size_t>()->value_name("n"),
+			"Stop optimizing a contract after the given number of rewrites."
+		)
+		(
+			g_strOptimizerTimeLimit.c_str(),
+			po::value<size_t>()->value_name("ms"),
+			"Stop optimizing a contract after the given number of milliseconds. "
+			"The output then depends on the speed of the machine."
+		)
+	;
+	desc.add(optimizerOptions);
+
 	po::options_description outputFormatting("Output Formatting");
 	outputFormatting.add_options()
 		(
@@ -712,7 +785,15 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
-		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
+		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strChangedFiles, {InputMode::Compiler}},
+		{g_strDepFile, {InputMode::Compiler}},
+		{g_strBranchProfile, {InputMode::Compiler}},
+		{g_strOptimizationLevel, {InputMode::Compiler}},
+		{g_strPackStateVariables, {InputMode::Compiler}},
+		{g_strOptimizerFunctionFuel, {InputMode::Compiler}},
+		{g_strOptimizerContractFuel, {InputMode::Compiler}},
+		{g_strOptimizerTimeLimit, {InputMode::Compiler}}
 	};
 	vector<string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
@@ -954,6 +1035,38 @@ void CommandLineParser::processArgs()
 		m_options.tvmParams.tvmVersion = *versionOption;
 	}
 
+	checkMutuallyExclusive({g_strChangedFiles, g_strDepFile});
+	if (m_args.count(g_strChangedFiles))
+	{
+		vector<string> paths;
+		m_options.input.changedFiles.emplace();
+		for (string const& changedFile: boost::split(paths, m_args[g_strChangedFiles].as<string>(), boost::is_any_of(",")))
+			if (!changedFile.empty())
+				m_options.input.changedFiles->insert(changedFile);
+	}
+	if (m_args.count(g_strDepFile))
+		m_options.output.depFile = m_args[g_strDepFile].as<string>();
+	if (m_args.count(g_strBranchProfile))
+		m_options.tvmParams.branchProfile = m_args[g_strBranchProfile].as<string>();
+	if (m_args.count(g_strOptimizationLevel))
+	{
+		unsigned level = m_args[g_strOptimizationLevel].as<unsigned>();
+		if (level > OptimiserSettings::maxTvmOptimizationLevel)
+			solThrow(
+				CommandLineValidationError,
+				"Invalid option for --" + g_strOptimizationLevel + ": " + to_string(level) +
+				". The level must be from 0 to " + to_string(OptimiserSettings::maxTvmOptimizationLevel) + "."
+			);
+		m_options.optimizer.level = level;
+	}
+	m_options.optimizer.packStateVariables = (m_args.count(g_strPackStateVariables) > 0);
+	if (m_args.count(g_strOptimizerFunctionFuel))
+		m_options.optimizer.functionFuel = m_args[g_strOptimizerFunctionFuel].as<size_t>();
+	if (m_args.count(g_strOptimizerContractFuel))
+		m_options.optimizer.contractFuel = m_args[g_strOptimizerContractFuel].as<size_t>();
+	if (m_args.count(g_strOptimizerTimeLimit))
+		m_options.optimizer.timeLimit = m_args[g_strOptimizerTimeLimit].as<size_t>();
+
 	if (m_args.count(g_strContract))
 		m_options.tvmParams.mainContract = m_args[g_strContract].as<string>();
 	if (m_args.count(g_strOutputPrefix))
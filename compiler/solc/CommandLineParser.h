@@ -170,6 +170,8 @@ struct CommandLineOptions
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
 		bool errorRecovery = false;
+		/// If set, only the imports are resolved and the contracts affected by these files are printed.
+		std::optional<std::set<boost::filesystem::path>> changedFiles;
 	} input;
 
 	struct
@@ -181,6 +183,7 @@ struct CommandLineOptions
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
+		boost::filesystem::path depFile;
 	} output;
 
 	struct
@@ -214,6 +217,12 @@ struct CommandLineOptions
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		bool noOptimizeYul = false;
 		std::optional<std::string> yulSteps;
+		/// Limits of the TVM optimizers, 0 means no limit.
+		size_t functionFuel = 0;
+		size_t contractFuel = 0;
+		size_t timeLimit = 0;
+		std::optional<unsigned> level;
+		bool packStateVariables = false;
 	} optimizer;
 
 	struct
@@ -230,6 +239,8 @@ struct CommandLineOptions
 		bool printFunctionIds = false;
 		bool printPrivateFunctionIds = false;
 		langutil::TVMVersion tvmVersion;
+		/// Execution counts of source lines used to lay out branches.
+		std::optional<boost::filesystem::path> branchProfile;
 	} tvmParams;
 };
 
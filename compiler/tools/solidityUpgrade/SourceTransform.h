@@ -58,7 +58,7 @@ public:
 	std::string text(langutil::SourceLocation const& _location) const
 	{
 		solAssert(_location.hasText(), "");
-		return std::string{m_charStreamProvider.charStream(*_location.sourceName).text(_location)};
+		return std::string{m_charStreamProvider.charStream(*_location.sourceName()).text(_location)};
 	}
 protected:
 	langutil::CharStreamProvider const& m_charStreamProvider;
@@ -54,7 +54,7 @@ void UpgradeChange::log(CharStreamProvider const& _charStreamProvider, bool cons
 	formatter.printSourceLocation(SourceReferenceExtractor::extract(_charStreamProvider, &m_location));
 	os << endl;
 
-	LineColumn lineEnd = _charStreamProvider.charStream(*m_location.sourceName).translatePositionToLineColumn(m_location.end);
+	LineColumn lineEnd = _charStreamProvider.charStream(*m_location.sourceName()).translatePositionToLineColumn(m_location.end);
 	int const leftpad = static_cast<int>(log10(max(lineEnd.line, 1))) + 2;
 
 	stringstream output;